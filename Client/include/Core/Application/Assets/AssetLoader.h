@@ -0,0 +1,119 @@
+#pragma once
+#include "Core/Rendering/Atlas/AtlasManifest.h"
+
+#include "Core/Rendering/Fonts/FontsConfig.h"
+
+#include <condition_variable>
+
+#include <deque>
+
+#include <functional>
+
+#include <mutex>
+
+#include <optional>
+
+#include <thread>
+
+#include <unordered_map>
+
+#pragma region FORWARD_DECLARATIONS
+typedef struct SDL_Surface SDL_Surface;
+#pragma endregion
+
+/// <summary>
+/// Decodes the images & reads the fonts of the client on a pool of worker threads, so startup doesn't have to wait on every file in turn.
+/// Loading starts before the connection with the server is made, the decoded images get uploaded to the renderer on the main thread as they come in.
+/// Sprites that didn't come in yet are drawn as invisible placeholders.
+/// </summary>
+class AssetLoader
+{
+public:
+	/// <summary>
+	/// Most worker threads that decode at once, the main thread keeps a core to itself.
+	/// </summary>
+	constexpr static uint32_t MAX_WORKERS = 4;
+
+	/// <summary>
+	/// Starts decoding the atlases, or every image file of the sprites that aren't packed in them.
+	/// </summary>
+	void load_sprites();
+
+	/// <summary>
+	/// Starts reading every font into memory.
+	/// </summary>
+	void load_fonts();
+
+	/// <summary>
+	/// Hands the assets that finished loading to the renderer, called every frame on the main thread.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// Whether every asset that got requested has been handed over.
+	/// </summary>
+	const bool is_done() const;
+
+	/// <summary>
+	/// The font file in memory, nullptr while it's still being read or couldn't be read.
+	/// Fonts opened from it read from the memory for as long as they're open, so they have to hold on to it.
+	/// </summary>
+	std::shared_ptr<const std::vector<char>> get_font_data(const e_FontType _font) const;
+
+public:
+	explicit AssetLoader(const std::string& _assetsPath);
+	~AssetLoader();
+
+private:
+	AssetLoader(const AssetLoader&) = delete;
+
+	struct Job
+	{
+		/// <summary>
+		/// Runs on a worker thread.
+		/// </summary>
+		std::function<void()> load;
+
+		/// <summary>
+		/// Runs on the main thread once the job got loaded.
+		/// </summary>
+		std::function<void()> finish;
+	};
+
+	/// <summary>
+	/// Decodes the image file, hands the surface to the callback on the main thread. The surface is nullptr when the image couldn't be decoded.
+	/// </summary>
+	void request_image(const std::string& _path, std::function<void(SDL_Surface*)> _onLoaded);
+
+	/// <summary>
+	/// Loads the sprite from its own image file.
+	/// </summary>
+	void request_sprite(const Graphics::SpriteArgs& _sprite);
+
+	void queue(Job _job);
+
+	void work();
+
+private:
+	std::string                                        m_assetsPath;
+
+	std::vector<std::thread>                           m_workers;
+	bool                                               m_bIsRunning = true;
+
+	std::mutex                                         m_mutex;
+	std::condition_variable                            m_condition;
+	std::deque<Job>                                    m_jobs;
+
+	/// <summary>
+	/// Jobs that got loaded, waiting on the main thread to finish them.
+	/// </summary>
+	std::vector<Job>                                   m_loaded;
+
+	/// <summary>
+	/// Jobs that were requested but haven't been finished yet, only touched by the main thread.
+	/// </summary>
+	size_t                                             m_pending    = 0;
+	size_t                                             m_finished   = 0;
+
+	std::unordered_map<e_FontType, std::shared_ptr<const std::vector<char>>> m_fonts;
+};
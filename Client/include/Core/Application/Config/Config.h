@@ -11,9 +11,15 @@ namespace DM
             static float get_deltaTime();
 			static void  update_deltaTime();
 
+			/// <summary>
+			/// Seconds since the client process started, used to time startup.
+			/// </summary>
+			static float get_time_since_start();
+
         private:
 			static float s_deltaTime;
 			static std::chrono::time_point<std::chrono::high_resolution_clock> s_lastTime;
+			static const std::chrono::time_point<std::chrono::high_resolution_clock> s_startTime;
 		};
 	}
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #include "Core/Entity/Simulation/SimPosition.h"
 
+#include "Core/Entity/Simulation/MovementPredictor.h"
+
 #include <unordered_map>
 
 #pragma region FORWARD_DECLERATIONS
@@ -46,12 +48,19 @@ public:
 
 	EventListener<uint64_t> on_entity_removed;
 
+	EventListener<uint64_t> on_local_player_removed;
+
 	RefEntity get_local_player_data();
 
 	void create_world_entity(DM::Utils::UUID _uuid, uint8_t _npcId, Utilities::ivec2 _pos);
 
 	void remove_world_entity(DM::Utils::UUID _uuid);
 
+	/// <summary>
+	/// Removes every world entity including our local player, used when the server moves us to another world instance.
+	/// </summary>
+	void clear_world_entities();
+
 	void update();
 
 	const uint64_t get_local_player_id() const;
@@ -60,6 +69,12 @@ public:
 
 	const std::unordered_map<DM::Utils::UUID, RefEntity>& get_entities();
 
+	/// <summary>
+	/// Returns what predicts the movement of our local player.
+	/// </summary>
+	/// <returns></returns>
+	MovementPredictor& get_movement_predictor();
+
 public:
 	EntityHandler();
 	~EntityHandler();
@@ -75,5 +90,7 @@ private:
 
 	uint64_t                                        m_localPlayerId;
 
+	MovementPredictor                               m_movementPredictor;
+
 	friend Graphics::UI::EntityLayer;
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+
+#include "Shared/Utilities/vec2.hpp"
+
+#include "Shared/Network/Packets/Packets.hpp"
+
+/// <summary>
+/// Walks our local player along its path straight away instead of waiting for the server to move it.
+/// The path gets found with the same pathfinder the server uses, and the player steps as far as the server moves it every tick.
+/// Every walk input gets numbered, the server sends back the latest input it processed with every position of our player.
+/// Positions that belong to our latest input only get applied when they aren't on the predicted path.
+/// </summary>
+class MovementPredictor
+{
+public:
+	/// <summary>
+	/// How long we wait on the server to confirm we reached the destination before handing our player back to the server.
+	/// </summary>
+	constexpr static float CONFIRMATION_TIMEOUT = 3.0f;
+
+	/// <summary>
+	/// Sends the walk input to the server and starts walking our local player towards the destination.
+	/// </summary>
+	/// <param name="_destination"></param>
+	/// <param name="_bIsRunning"></param>
+	void walk_to(const Utilities::ivec2 _destination, const bool _bIsRunning);
+
+	/// <summary>
+	/// Compares the position the server moved our player to against the prediction, and corrects the prediction when it's off.
+	/// </summary>
+	/// <param name="_movement"></param>
+	/// <returns>Whether the position got handled by the prediction, otherwise it has to get applied as usual.</returns>
+	const bool reconcile(const Packets::s_EntityMovement& _movement);
+
+	/// <summary>
+	/// Stops predicting, any other action of the player or teleport makes the server move our player instead.
+	/// </summary>
+	void cancel();
+
+	const bool is_predicting() const;
+
+	/// <summary>
+	/// Steps our player along the predicted path, called every frame.
+	/// </summary>
+	void update();
+
+private:
+	/// <summary>
+	/// Moves our player as far along the path as the server would within a single tick.
+	/// </summary>
+	void step();
+
+	/// <summary>
+	/// Predicts the path from the tile towards the destination of the current input.
+	/// </summary>
+	/// <param name="_start"></param>
+	void predict_from(const Utilities::ivec2 _start);
+
+private:
+	std::vector<Utilities::ivec2> m_path;
+	size_t                        m_pathIndex    = 0;
+	Utilities::ivec2              m_start        = Utilities::ivec2(0, 0);
+	Utilities::ivec2              m_destination  = Utilities::ivec2(0, 0);
+
+	bool                          m_bIsRunning    = false;
+	bool                          m_bIsPredicting = false;
+
+	/// <summary>
+	/// Whether the server reported our player reached the destination.
+	/// </summary>
+	bool                          m_bIsConfirmed  = false;
+
+	/// <summary>
+	/// Sequence of the latest walk input we sent.
+	/// </summary>
+	uint32_t                      m_sequence      = 0;
+
+	float                         m_stepTime      = 0.0f;
+	float                         m_waitTime      = 0.0f;
+};
@@ -5,12 +5,20 @@
 
 /// <summary>
 /// Simulates the path that is taken by an actor based on server input.
+/// Positions stamped with the tick they happened on get buffered, the actor gets interpolated between them at the render tick of the clock sync.
+/// Positions without a tick, e.g the predicted steps of our local player, get walked towards straight away.
 /// </summary>
 class SimPosition
 {
 public:
 	const Utilities::vec2 get_position() const;
 
+	/// <summary>
+	/// Returns the tile the actor is walking towards, or standing on when it isn't walking.
+	/// </summary>
+	/// <returns></returns>
+	const Utilities::ivec2 get_target_tile() const;
+
 public:
 	~SimPosition() = default;
 
@@ -21,7 +29,28 @@ public:
 	
 	void update();
 
+	/// <summary>
+	/// How many positions get buffered at most, the render delay only ever needs the last couple.
+	/// </summary>
+	constexpr static size_t BUFFER_SIZE = 8;
+
 private:
+	/// <summary>
+	/// Buffers the position the actor had on the server tick.
+	/// </summary>
+	void push_position(const uint32_t _tick, const Utilities::ivec2 _pos);
+
+	/// <summary>
+	/// Interpolates between the buffered positions around the render tick.
+	/// </summary>
+	void update_buffered();
+
+	struct BufferedPosition
+	{
+		uint32_t        tick = 0;
+		Utilities::vec2 position;
+	};
+
 	void set_target(const Utilities::vec2 _details);
 
 	void set_current_position(const Utilities::vec2 _pos);
@@ -33,6 +62,11 @@ private:
 
 	std::vector<Utilities::ivec2> m_path;
 
+	/// <summary>
+	/// Oldest first, emptied once the actor gets moved without a tick.
+	/// </summary>
+	std::vector<BufferedPosition> m_buffer;
+
 	bool  m_bIsDirty = false;
 	float m_elapsedTime = 0.0f;
 
@@ -76,6 +76,12 @@ public:
 	/// </summary>
 	void respawn();
 
+	/// <summary>
+	/// Whether the entity died and hasn't respawned yet.
+	/// </summary>
+	/// <returns></returns>
+	const bool is_dead() const;
+
 	/// <summary>
 	/// Update the statemachine and set a new state.
 	/// </summary>
@@ -113,6 +119,14 @@ public:
 	void move_to(const Utilities::ivec2 _pos);
 
 
+	/// <summary>
+	/// Moves the entity to the coordinates it had on the server tick, it gets interpolated there behind the server clock.
+	/// </summary>
+	/// <param name="_tick"></param>
+	/// <param name="_pos"></param>
+	void interpolate_to(const uint32_t _tick, const Utilities::ivec2 _pos);
+
+
 	/// <summary>
 	/// Returns the definition of how the Entity should get rendered.
 	/// </summary>
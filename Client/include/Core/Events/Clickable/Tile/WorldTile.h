@@ -17,6 +17,22 @@ public:
 
 	virtual bool handle_event(const SDL_Event* _event) override;
 
+	/// <summary>
+	/// Whether the mouse is on a tile that can be walked to, the tile stops being hovered when it isn't.
+	/// </summary>
+	void set_walkable(const bool _bIsWalkable);
+
+private:
+	static void walk_to(const Utilities::vec2 _position);
+
+	/// <summary>
+	/// The world layer moves the tile along with the mouse, it overlaps whenever the mouse is on a walkable tile.
+	/// </summary>
+	virtual const bool overlaps_rect(const int& _x, const int& _y) const override;
+
+private:
+	bool m_bIsWalkable = true;
+
 public:
 	using Clickable::Clickable;
 	~WorldTile();
@@ -2,6 +2,7 @@
 #include <memory>
 
 #pragma region FORWARD_DECLARATIONS
+class AssetLoader;
 class Camera;
 class ENetPacketHandler;
 class EntityHandler;
@@ -23,6 +24,7 @@ struct Globals
 	std::weak_ptr<ENetPacketHandler>  packetHandler;
 	std::weak_ptr<EntityHandler>      entityHandler;
 	std::weak_ptr<TimerHandler>       timerHandler;
+	std::weak_ptr<AssetLoader>        assetLoader;
 };
 
 extern Globals g_globals;
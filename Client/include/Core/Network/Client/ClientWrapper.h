@@ -5,6 +5,8 @@
 typedef struct _ENetHost ENetHost;
 typedef struct _ENetPeer ENetPeer;
 
+class AssetLoader;
+
 class Client
 {
 public:
@@ -15,7 +17,10 @@ public:
 
 	static constexpr const char* TITLE = "DeviousMud";
 
-	void start_ticking();
+	/// <summary>
+	/// Runs the game loop, the asset loader started loading before the connection got made.
+	/// </summary>
+	void start_ticking(std::shared_ptr<AssetLoader> _assetLoader);
 
 	void quit();
 
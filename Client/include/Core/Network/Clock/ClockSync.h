@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+
+#include <chrono>
+
+#include <cstdint>
+
+/// <summary>
+/// Estimates which tick the server is on from the ticks its packets get stamped with.
+/// Every tick the arrival of its first packet gets sampled, the sample that arrived the soonest within the window has the least
+/// latency & jitter on top of the offset between both clocks, so that one is used as the offset.
+/// Entities get rendered a fixed delay behind the estimated server tick, so the positions they interpolate between already arrived.
+/// </summary>
+class ClockSync
+{
+public:
+	/// <summary>
+	/// The tick rate the server starts out with, used until the server sends its own.
+	/// </summary>
+	constexpr static double DEFAULT_TICK_DURATION = 0.6;
+
+	/// <summary>
+	/// How many ticks later than the estimate a tick can arrive before the samples get thrown out.
+	/// The server's tick count doesn't advance on the ticks it skips, which shifts the offset for good.
+	/// </summary>
+	constexpr static double RESYNC_THRESHOLD_TICKS = 1.0;
+
+	/// <summary>
+	/// How far behind the server the entities get rendered, a tick to have the next position at hand and some headroom for jitter.
+	/// </summary>
+	constexpr static double INTERPOLATION_DELAY_TICKS = 1.2;
+
+	/// <summary>
+	/// Over how many ticks the offset gets estimated, old samples roll out so the clocks drifting apart gets picked up.
+	/// </summary>
+	constexpr static size_t SAMPLE_COUNT = 32;
+
+	/// <summary>
+	/// Samples the arrival of a packet that got sent on the tick.
+	/// </summary>
+	/// <param name="_tick"></param>
+	void receive_tick(const uint32_t _tick);
+
+	/// <summary>
+	/// Sets the tick period the server sent on join or after changing it, a different tick period starts the estimate over.
+	/// </summary>
+	/// <param name="_tickPeriodMs"></param>
+	void set_tick_period(const uint32_t _tickPeriodMs);
+
+	/// <summary>
+	/// Returns the tick the server is estimated to be on right now, including how far it got into that tick.
+	/// </summary>
+	/// <returns></returns>
+	const double get_server_tick() const;
+
+	/// <summary>
+	/// Returns the tick entities should get rendered at.
+	/// </summary>
+	/// <returns></returns>
+	const double get_render_tick() const;
+
+	const bool is_synchronized() const;
+
+	/// <summary>
+	/// Returns the duration of a tick in seconds, as last sent by the server.
+	/// </summary>
+	/// <returns></returns>
+	const double get_tick_duration() const;
+
+	/// <summary>
+	/// Forgets every sample, the server we got moved to counts its ticks from scratch.
+	/// </summary>
+	void reset();
+
+private:
+	static double get_time();
+
+private:
+	std::array<double, SAMPLE_COUNT> m_samples = {};
+	size_t                           m_sampleCount = 0;
+	size_t                           m_nextSample  = 0;
+
+	uint32_t                         m_lastTick    = 0;
+
+	/// <summary>
+	/// Local time in seconds at which the server started its tick 0, as seen by the client.
+	/// </summary>
+	double                           m_offset      = 0.0;
+
+	double                           m_tickDuration = DEFAULT_TICK_DURATION;
+};
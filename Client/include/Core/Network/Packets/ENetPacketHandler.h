@@ -5,6 +5,10 @@
 
 #include "Shared/Utilities/EventListener.h"
 
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Core/Network/Clock/ClockSync.h"
+
 #include <enet/enet.h>
 
 class Application;
@@ -22,6 +26,12 @@ public:
 
 	void update();
 
+	/// <summary>
+	/// Returns the estimate of the server tick, entities get interpolated behind it.
+	/// </summary>
+	/// <returns></returns>
+	const ClockSync& get_clock_sync() const;
+
 public:
 	ENetPacketHandler(ENetHost* _host, ENetPeer* _peer);
 	~ENetPacketHandler();
@@ -29,10 +39,18 @@ public:
 private:
 	void process_packet();
 
+	/// <summary>
+	/// Creates or updates every entity within the chunk of the world snapshot in a single pass.
+	/// </summary>
+	/// <param name="_snapshot"></param>
+	void apply_world_snapshot(const Packets::s_WorldSnapshot& _snapshot);
+
 private:
 	ENetHost*				   m_host;
 	ENetPeer*				   m_peer;
 	ENetEvent				   m_event;
+	ReplicationHandler         m_replication;
+	ClockSync                  m_clockSync;
 };
 
 template<class T>
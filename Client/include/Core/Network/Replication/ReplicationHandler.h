@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+
+#include "Shared/Network/Packets/Packets.hpp"
+
+#include "Shared/Network/Replication/ReplicatedState.hpp"
+
+/// <summary>
+/// Rebuilds the replicated entity state out of the delta snapshots the server sends, and applies whatever changed to the world entities.
+/// </summary>
+class ReplicationHandler
+{
+public:
+	/// <summary>
+	/// Has to match the history the server keeps, the server never writes a delta against anything older.
+	/// </summary>
+	constexpr static uint32_t SNAPSHOT_HISTORY = 32;
+
+	/// <summary>
+	/// Decodes the snapshot and applies every change to the world entities.
+	/// Returns whether the snapshot got applied, only applied snapshots should get acknowledged.
+	/// </summary>
+	/// <param name="_snapshot"></param>
+	/// <returns></returns>
+	bool receive(const Packets::s_StateSnapshot& _snapshot);
+
+	/// <summary>
+	/// Forgets every snapshot, the world instance we got moved to starts counting its sequences from scratch.
+	/// </summary>
+	void reset();
+
+private:
+	/// <summary>
+	/// Creates, updates or removes the world entity, entities that got (re)created get all their fields applied.
+	/// </summary>
+	/// <param name="_change"></param>
+	/// <param name="_state"></param>
+	void apply_change(const DM::Replication::s_ReplicatedChange& _change, const DM::Replication::s_ReplicatedState* _state);
+
+	/// <summary>
+	/// Returns the snapshot with the given sequence, or nullptr when it's no longer within the history.
+	/// </summary>
+	/// <param name="_sequence"></param>
+	/// <returns></returns>
+	const DM::Replication::ReplicatedSnapshot* get_snapshot(const uint32_t _sequence) const;
+
+private:
+	std::array<DM::Replication::ReplicatedSnapshot, SNAPSHOT_HISTORY> m_history;
+	std::array<uint32_t, SNAPSHOT_HISTORY>                            m_historySequences = {};
+
+	/// <summary>
+	/// Reused between snapshots to avoid allocating.
+	/// </summary>
+	std::vector<DM::Replication::s_ReplicatedChange> m_changes;
+
+	const DM::Replication::ReplicatedSnapshot m_emptySnapshot;
+
+	uint32_t m_latestSequence = 0;
+
+	/// <summary>
+	/// The tick the snapshot that's being applied got captured on.
+	/// </summary>
+	uint32_t m_tick = 0;
+};
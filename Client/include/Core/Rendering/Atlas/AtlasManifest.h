@@ -0,0 +1,65 @@
+#pragma once
+#include "Shared/Utilities/vec2.hpp"
+
+#include "Shared/Game/SpriteTypes.hpp"
+
+#include <optional>
+
+#include <string>
+
+#include <vector>
+
+namespace Graphics
+{
+	/// <summary>
+	/// Where the AtlasPacker put every frame of every sprite, written next to the atlases as plain text:
+	///   atlases <count>
+	///   <image file>                                                 (one line per atlas)
+	///   sprites <count>
+	///   <sprite type> <atlas> <width> <height> <rows> <columns> <source stamp>
+	///   <x> <y> <w> <h>                                              (one line per frame, row by row)
+	/// </summary>
+	struct AtlasManifest
+	{
+		struct Sprite
+		{
+			SpriteType            type    = SpriteType::NONE;
+			uint32_t              atlas   = 0;
+
+			/// <summary>
+			/// Size of the image file the sprite got packed from, all frames included.
+			/// </summary>
+			Utilities::ivec2      size    = Utilities::ivec2(0, 0);
+			uint32_t              rows    = 0;
+			uint32_t              columns = 0;
+
+			/// <summary>
+			/// Last write time of the image file the sprite got packed from.
+			/// </summary>
+			int64_t               sourceStamp = 0;
+
+			std::vector<SDL_Rect> frames;
+		};
+
+		std::vector<std::string> atlases;
+		std::vector<Sprite>      sprites;
+
+		/// <summary>
+		/// Returns nothing when there's no manifest or it's malformed, the sprites have to get loaded from their own image files then.
+		/// </summary>
+		static std::optional<AtlasManifest> load(const std::string& _path);
+
+		const bool save(const std::string& _path) const;
+
+		/// <summary>
+		/// Whether every sprite got packed from its current image file, with the rows & columns the SpriteConfig currently has.
+		/// A stale manifest has to get ignored, the sprites get loaded from their own image files until the atlases get packed again.
+		/// </summary>
+		const bool is_up_to_date(const std::string& _assetsPath) const;
+
+		/// <summary>
+		/// Returns the last write time of the file, 0 when it doesn't exist.
+		/// </summary>
+		static const int64_t get_source_stamp(const std::string& _path);
+	};
+}
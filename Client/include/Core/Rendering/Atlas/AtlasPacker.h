@@ -0,0 +1,68 @@
+#pragma once
+#include "Shared/Utilities/vec2.hpp"
+
+#include <string>
+
+#include <vector>
+
+namespace Graphics
+{
+	/// <summary>
+	/// Build step that packs every frame of every sprite within the SpriteConfig into a few large atlases, run as: Client --pack-atlas [assets path].
+	/// The client project runs it after every build, it only packs again when the manifest went stale.
+	/// Next to the atlas images it writes an AtlasManifest with the spot of every frame, the client loads the atlases from that instead of every image file on its own.
+	/// </summary>
+	class AtlasPacker
+	{
+	public:
+		/// <summary>
+		/// Width & height of an atlas, textures this size are supported by practically every GPU.
+		/// </summary>
+		constexpr static int32_t     ATLAS_SIZE    = 2048;
+
+		/// <summary>
+		/// Empty pixels in between frames, keeps neighbouring frames from bleeding into each other when sprites get scaled.
+		/// </summary>
+		constexpr static int32_t     PADDING       = 2;
+
+		/// <summary>
+		/// Folder within the assets the atlases & manifest get written to.
+		/// </summary>
+		constexpr static const char* ATLAS_FOLDER  = "/atlas/";
+
+		constexpr static const char* MANIFEST_FILE = "atlas.manifest";
+
+		/// <summary>
+		/// Packs the sprites of the assets folder, returns false when an image couldn't be loaded or written.
+		/// </summary>
+		static const bool pack(const std::string& _assetsPath);
+
+	private:
+		struct Frame
+		{
+			size_t           sprite   = 0;
+			SDL_Rect         source   = { 0, 0, 0, 0 };
+
+			uint32_t         atlas    = 0;
+			Utilities::ivec2 position = Utilities::ivec2(0, 0);
+		};
+
+		/// <summary>
+		/// Places the frames on shelves, tallest frames first, and starts another atlas once a shelf doesn't fit anymore.
+		/// The frames of a sprite always end up on the same atlas, it gets drawn from a single texture.
+		/// Returns the amount of atlases, or 0 when a sprite doesn't even fit an empty atlas.
+		/// </summary>
+		static const uint32_t place_frames(std::vector<Frame*>& _frames);
+
+		struct Shelves
+		{
+			Utilities::ivec2 cursor      = Utilities::ivec2(0, 0);
+			int32_t          shelfHeight = 0;
+		};
+
+		/// <summary>
+		/// Places the frames of a single sprite onto the shelves, returns false when they run out of the atlas.
+		/// </summary>
+		static const bool place_sprite(const std::vector<Frame*>::iterator _begin, const std::vector<Frame*>::iterator _end, Shelves& _shelves);
+	};
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "Shared/Utilities/vec2.hpp"
+
+#include "Core/Rendering/Fonts/FontsConfig.h"
+
+#include <memory>
+
+#include <string>
+
+#include <unordered_map>
+
+#include <vector>
+
+#pragma region FORWARD_DECLARATIONS
+typedef struct SDL_Renderer SDL_Renderer;
+typedef struct SDL_Texture  SDL_Texture;
+typedef struct _TTF_Font    TTF_Font;
+#pragma endregion
+
+namespace Graphics
+{
+	/// <summary>
+	/// Opens every font once per size, and rasterizes its glyphs into shared atlas pages the first time they get used.
+	/// Text gets drawn as a quad per glyph, so changing text never has to allocate a texture.
+	/// The glyphs are rasterized in white, the color of the text comes from the vertices.
+	/// </summary>
+	class FontCache
+	{
+	public:
+		/// <summary>
+		/// Size of an atlas page in pixels, a new page gets added once the glyphs don't fit on the last one.
+		/// </summary>
+		constexpr static int32_t PAGE_SIZE = 512;
+
+		/// <summary>
+		/// Empty pixels around every glyph, so filtering never samples a neighbouring glyph.
+		/// </summary>
+		constexpr static int32_t PADDING   = 1;
+
+		struct Glyph
+		{
+			/// <summary>
+			/// Page the glyph is on, nullptr when the glyph has no pixels, e.g a space.
+			/// </summary>
+			SDL_Texture* texture = nullptr;
+			SDL_Rect     region  = { 0, 0, 0, 0 };
+
+			/// <summary>
+			/// How far the next glyph starts in pixels.
+			/// </summary>
+			int32_t      advance = 0;
+		};
+
+		struct Font
+		{
+			TTF_Font*                           font   = nullptr;
+			int32_t                             height = 0;
+			std::unordered_map<uint32_t, Glyph> glyphs;
+
+			/// <summary>
+			/// The font file the font got opened from, it reads from it for as long as it's open.
+			/// </summary>
+			std::shared_ptr<const std::vector<char>> data;
+		};
+
+		/// <summary>
+		/// Opens the font at the size the first time it gets asked for, nullptr when it can't be opened.
+		/// </summary>
+		Font* get_font(const e_FontType _font, const int32_t _size);
+
+		/// <summary>
+		/// Rasterizes the glyph onto a page the first time it gets asked for.
+		/// </summary>
+		const Glyph& get_glyph(Font& _font, const uint32_t _codepoint);
+
+		/// <summary>
+		/// Extra space between the two glyphs in pixels.
+		/// </summary>
+		const int32_t get_kerning(const Font& _font, const uint32_t _previous, const uint32_t _codepoint) const;
+
+	public:
+		FontCache(SDL_Renderer* _renderer, const std::string& _assetsPath);
+		~FontCache();
+
+	private:
+		FontCache(const FontCache&) = delete;
+
+		struct Page
+		{
+			SDL_Texture*     texture     = nullptr;
+			Utilities::ivec2 cursor      = Utilities::ivec2(0, 0);
+			int32_t          shelfHeight = 0;
+		};
+
+		/// <summary>
+		/// Finds room for the glyph on the last page, starts a new page when it doesn't fit.
+		/// </summary>
+		Page* reserve(const Utilities::ivec2& _size, SDL_Rect& _region);
+
+		const bool add_page();
+
+	private:
+		SDL_Renderer*                       m_renderer;
+		std::string                         m_assetsPath;
+
+		/// <summary>
+		/// Keyed by the font type & size.
+		/// </summary>
+		std::unordered_map<uint32_t, Font>  m_fonts;
+		std::vector<Page>                   m_pages;
+	};
+}
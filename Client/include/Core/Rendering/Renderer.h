@@ -7,6 +7,8 @@
 
 #include "Core/Rendering/Fonts/FontsConfig.h"
 
+#include "Core/Rendering/Atlas/AtlasManifest.h"
+
 #include <string>
 
 #include <unordered_map>
@@ -20,10 +22,13 @@ typedef struct SDL_Surface  SDL_Surface;
 typedef struct SDL_Texture  SDL_Texture;
 typedef struct SDL_Color    SDL_Color;
 class Camera;
+class ChunkCache;
 #pragma endregion
 
 namespace Graphics 
 {
+	class FontCache;
+
 	/// <summary>
 	/// Used for the process of plotting sprites ontop of the canvas.
 	/// </summary>
@@ -33,21 +38,35 @@ namespace Graphics
 		EventListener<Utilities::vec2> on_viewport_size_changed;
 
 		/// <summary>
-		/// Nested class to store details about the surface, such as the amount of frames this sprite contains.
+		/// Nested class to store details about the sprite, such as the amount of frames this sprite contains & where they are on the texture.
 		/// This allows for dynamically switching to different images that are saved within the same specified image file.
+		/// The texture is either the image file of the sprite alone, or an atlas it shares with other sprites.
 		/// </summary>
 		class SDL_SpriteDetails final
 		{
 		public:
-			SDL_SpriteDetails(SDL_Surface* _surface, SDL_Texture* _texture, const uint32_t& _rows, const uint32_t& _columns);
+			SDL_SpriteDetails(SDL_Texture* _texture, const Utilities::ivec2& _size, const uint32_t& _rows, const uint32_t& _columns, std::vector<SDL_Rect> _frames, const bool _bOwnsTexture, const bool _bIsPlaceholder = false);
 			virtual ~SDL_SpriteDetails();
 
 			const uint32_t& get_framecount() const;
 
-			SDL_Surface* get_surface() const;
+			/// <summary>
+			/// Size of the whole image file, all frames included.
+			/// </summary>
+			const Utilities::ivec2& get_size() const;
 
 			SDL_Texture* get_texture();
 
+			/// <summary>
+			/// Where the frame is on the texture.
+			/// </summary>
+			const SDL_Rect& get_frame(const uint32_t _frame) const;
+
+			inline const bool is_placeholder() const
+			{
+				return m_bIsPlaceholder;
+			};
+
 			inline const uint32_t& get_rows() const 
 			{
 				return m_Rows;
@@ -58,12 +77,20 @@ namespace Graphics
 				return m_Columns;
 			};
 
+			/// <summary>
+			/// Splits an image file into the frames of its rows & columns, row by row.
+			/// </summary>
+			static std::vector<SDL_Rect> split_frames(const Utilities::ivec2& _size, const uint32_t _rows, const uint32_t _columns);
+
 		private:
-			uint32_t         m_framecount;
-			SDL_Surface*     m_surface;
-			SDL_Texture*     m_texture;
-			uint32_t         m_Rows;
-			uint32_t         m_Columns;
+			uint32_t              m_framecount;
+			SDL_Texture*          m_texture;
+			Utilities::ivec2      m_size;
+			uint32_t              m_Rows;
+			uint32_t              m_Columns;
+			std::vector<SDL_Rect> m_frames;
+			bool                  m_bOwnsTexture;
+			bool                  m_bIsPlaceholder;
 		};
 
 	public:
@@ -77,6 +104,25 @@ namespace Graphics
 		/// </summary>
 		constexpr static int32_t GRID_CELL_PX_SIZE = 64;
 
+		/// <summary>
+		/// Every how many seconds the average frame time & draw calls get logged.
+		/// </summary>
+		constexpr static float FRAME_STATS_INTERVAL = 10.0f;
+
+		/// <summary>
+		/// How many sprites of the batches in between a sprite gets tested against before it starts a new batch instead.
+		/// </summary>
+		constexpr static size_t MAX_BATCH_OVERLAP_TESTS = 64;
+
+		/// <summary>
+		/// What it took to render the last frame.
+		/// </summary>
+		struct FrameStats
+		{
+			uint32_t sprites   = 0;
+			uint32_t drawCalls = 0;
+		};
+
 	public:
 
 		static Renderer* create_renderer(const char* _title, const Utilities::ivec2& _c_scale, const std::string& _texture_path);
@@ -85,7 +131,32 @@ namespace Graphics
 
 		std::shared_ptr<Camera>& get_camera();
 
-		void load_and_bind_surface(const std::string& _file, const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns);
+		/// <summary>
+		/// Fonts & the atlas pages of their glyphs, text gets drawn from these.
+		/// </summary>
+		FontCache& get_font_cache();
+
+		/// <summary>
+		/// Binds a sprite type to the decoded image file, takes ownership of the surface.
+		/// </summary>
+		void bind_surface(SDL_Surface* _surface, const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns);
+
+		/// <summary>
+		/// Uploads the decoded atlas and binds every sprite packed onto it, takes ownership of the surface.
+		/// </summary>
+		void bind_atlas(SDL_Surface* _surface, const std::vector<AtlasManifest::Sprite>& _sprites);
+
+		/// <summary>
+		/// Binds an invisible sprite to the type until its image file got loaded, so the sprite can already get used.
+		/// </summary>
+		void bind_placeholder(const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns);
+
+		const bool has_sprite(const SpriteType& _spritetype) const;
+
+		/// <summary>
+		/// Whether the sprite is still waiting on its image file.
+		/// </summary>
+		const bool is_placeholder(const SpriteType& _spritetype) const;
 
 		void start_frame();
 
@@ -103,13 +174,66 @@ namespace Graphics
 
 		void get_viewport_size(int32_t* _w, int32_t* _h);
 
+		/// <summary>
+		/// Inverse of the worldspace transform, turns a position on screen into a position in gridspace.
+		/// </summary>
+		const Utilities::vec2 screen_to_world(const Utilities::ivec2& _screenPos);
+
+		/// <summary>
+		/// The tile that's underneath the position on screen.
+		/// </summary>
+		const Utilities::ivec2 screen_to_tile(const Utilities::ivec2& _screenPos);
+
 		Sprite get_sprite(const SpriteType& _spritetype);
 
+		const FrameStats& get_frame_stats() const;
+
 		virtual ~Renderer();
 
 	private:
+		/// <summary>
+		/// Sprites sharing a texture that get drawn with a single draw call.
+		/// </summary>
+		struct Batch
+		{
+			SDL_Texture*            texture = nullptr;
+			Utilities::vec2         textureSize;
+
+			std::vector<SDL_Vertex> vertices;
+			std::vector<int>        indices;
+
+			/// <summary>
+			/// Where the sprites of the batch end up on screen, sprites can only join an earlier batch when they don't overlap these.
+			/// </summary>
+			std::vector<SDL_FRect>  quads;
+			SDL_FRect               bounds  = { 0.0f, 0.0f, 0.0f, 0.0f };
+		};
+
 		void free();
 
+		/// <summary>
+		/// Binds the details to the sprite type, replacing its placeholder.
+		/// </summary>
+		void bind_details(const Graphics::SpriteType& _spritetype, SDL_SpriteDetails* _details);
+
+		/// <summary>
+		/// Where the sprite ends up on screen.
+		/// </summary>
+		const SDL_FRect get_dest_rect(const SpriteRenderData& _data, const Utilities::vec2& _viewportHalfExtends, const Utilities::vec2& _camPos) const;
+
+		/// <summary>
+		/// Adds the sprite to the latest batch of its texture, as long as none of the sprites batched after it overlap the sprite.
+		/// Otherwise it starts a new batch, so sprites that overlap keep being drawn in the order they got plotted in.
+		/// </summary>
+		void batch_sprite(const SpriteRenderData& _data, const SDL_FRect& _destRect);
+
+		/// <summary>
+		/// Draws every batch of the z-bucket, and destroys the textures that were only meant to be used once.
+		/// </summary>
+		void flush_batches();
+
+		void update_frame_stats();
+
 	protected:
 		Renderer(SDL_Window* _window, SDL_Renderer* _renderer, const std::string& _texture_path);
 	
@@ -118,16 +242,55 @@ namespace Graphics
 		/// The Key represents the Z render order, going through what to render first.
 		std::map<int8_t, std::vector<Graphics::SpriteRenderData>> m_renderQueue;
 
+		/// <summary>
+		/// Batches of the z-bucket that's being drawn, kept around between frames so their buffers don't get reallocated.
+		/// </summary>
+		std::vector<Batch> m_batches;
+		size_t             m_batchCount = 0;
+
+		/// <summary>
+		/// Index of the latest batch of every texture in the z-bucket.
+		/// </summary>
+		std::unordered_map<SDL_Texture*, size_t> m_latestBatches;
+
+		std::vector<SDL_Texture*> m_texturesToDestroy;
+
+		/// <summary>
+		/// 1x1 white texture rects & outlines get drawn with.
+		/// </summary>
+		SDL_Texture* m_whiteTexture = nullptr;
+
+		/// <summary>
+		/// 1x1 transparent texture sprites are drawn with until their image file got loaded.
+		/// </summary>
+		SDL_Texture* m_placeholderTexture = nullptr;
+
+		std::unique_ptr<FontCache> m_fontCache;
+
+		FrameStats m_frameStats;
+
+		float      m_statsElapsed   = 0.0f;
+		uint32_t   m_statsFrames    = 0;
+		uint64_t   m_statsDrawCalls = 0;
+		uint64_t   m_statsSprites   = 0;
+
 		std::shared_ptr<Camera> m_camera;
 
 		std::string m_assetsPath;
 
 		std::unordered_map<SpriteType, SDL_SpriteDetails*> m_sprites;
 
+		/// <summary>
+		/// Textures of the atlases, shared by the sprites packed into them.
+		/// </summary>
+		std::vector<SDL_Texture*> m_atlases;
+
 		SDL_Window* m_window;
 
 		SDL_Renderer* m_renderer;
 
 		friend class TextComponent;
+
+		friend class ::ChunkCache;
 	};
 };
\ No newline at end of file
@@ -31,6 +31,12 @@ namespace Graphics
 		SDL_Color            color       = { 255, 255, 255, 255 };
 		uint8_t              renderFlags = 0;
 
+		/// <summary>
+		/// Part of the texture the frame is on, the whole texture when it's empty.
+		/// Takes priority over picking the frame out of the rows & columns.
+		/// </summary>
+		SDL_Rect             region      = { 0, 0, 0, 0 };
+
 		SpriteRenderData() = default;
 
 		SpriteRenderData(const SpriteRenderData& _other) = default;
@@ -43,6 +49,9 @@ namespace Graphics
 				size		= std::move(_other.size);
 				texture		= _other.texture;
 				frameCount  = _other.frameCount;
+				rows        = _other.rows;
+				columns     = _other.columns;
+				region      = _other.region;
 				color		= _other.color;
 				frame		= _other.frame;
 				renderFlags = _other.renderFlags;
@@ -2,6 +2,12 @@
 #include "Core/UI/Layer/Layer.h"
 #include "Core/Rendering/Sprite/Sprite.h"
 
+#include <unordered_map>
+
+#pragma region FORWARD_DECLERATIONS
+class WorldEntity;
+#pragma endregion
+
 #pragma region FORWARD_DECLERATIONS
 class EntityHandler;
 
@@ -33,6 +39,15 @@ namespace Graphics
 		private:
 			void player_local_assigned(uint64_t _playerId);
 
+			void player_local_removed(uint64_t _playerId);
+
+			/// <summary>
+			/// Sorts the entities into the tiles they can be clicked on, so only the entities underneath the mouse get hit-tested.
+			/// </summary>
+			void update_buckets();
+
+			static const uint64_t to_bucket_key(const Utilities::ivec2& _tile);
+
 		private:
 			bool m_bHasLocalPlayer = false;
 
@@ -43,6 +58,16 @@ namespace Graphics
 			std::shared_ptr<EntityHandler>      m_entityHandler;
 
 			std::shared_ptr<Graphics::Renderer> m_renderer;
+
+			/// <summary>
+			/// The entities that overlap a tile, keyed by the tile.
+			/// </summary>
+			std::unordered_map<uint64_t, std::vector<std::shared_ptr<WorldEntity>>> m_entityBuckets;
+
+			/// <summary>
+			/// Entities that got the last mouse event, they keep getting them so they notice the mouse left them.
+			/// </summary>
+			std::vector<std::weak_ptr<WorldEntity>> m_mouseEntities;
 		};
 	}
 }
\ No newline at end of file
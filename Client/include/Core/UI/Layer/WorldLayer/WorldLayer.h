@@ -1,6 +1,12 @@
 #pragma once
 #include "Core/UI/Layer/Layer.h"
 
+#include "Core/World/TileMap/TileMap.h"
+
+#include "Core/World/ChunkCache/ChunkCache.h"
+
+#include "Core/Rendering/Sprite/Sprite.h"
+
 class WorldTile;
 
 namespace Graphics
@@ -10,6 +16,11 @@ namespace Graphics
 		class WorldLayer : public Layer
 		{
 		public:
+			/// <summary>
+			/// Size of the world that gets filled with default tiles, until the world gets loaded from the server.
+			/// </summary>
+			constexpr static int32_t WORLD_SIZE = 100;
+
 			virtual void init() override;
 
 			virtual void update() override;
@@ -21,7 +32,30 @@ namespace Graphics
 			~WorldLayer() override = default;
 
 		private:
-			std::vector<std::shared_ptr<WorldTile>> m_tiles;
+			/// <summary>
+			/// Plots the tiles of the chunk that are within the range one by one.
+			/// </summary>
+			void plot_tiles(const TileMap::Chunk& _chunk, const Utilities::ivec2& _origin, const Utilities::ivec2& _min, const Utilities::ivec2& _max);
+
+			/// <summary>
+			/// The range of tiles that's within the viewport, both inclusive.
+			/// </summary>
+			void get_visible_tiles(Utilities::ivec2& _min, Utilities::ivec2& _max) const;
+
+		private:
+			TileMap                    m_tileMap;
+
+			/// <summary>
+			/// Sprite of every tile id.
+			/// </summary>
+			std::vector<Sprite>        m_palette;
+
+			ChunkCache                 m_chunkCache;
+
+			/// <summary>
+			/// Only the tile underneath the mouse exists as a clickable, it moves along with the mouse.
+			/// </summary>
+			std::shared_ptr<WorldTile> m_hoveredTile;
 		};
 	}
 }
@@ -3,6 +3,10 @@
 
 #include "Core/Rendering/Fonts/FontsConfig.h"
 
+#include "Core/Rendering/Fonts/FontCache.h"
+
+#include <string_view>
+
 
 struct TextArgs
 {
@@ -36,23 +40,31 @@ namespace Graphics
 	class TextComponent final : public UIComponent
 	{
 	public:
+		/// <summary>
+		/// A run of text in a single color, or an icon. The text points into the contents of the component.
+		/// </summary>
 		struct TextSegment
 		{
-			std::string text;
-			SDL_Color   color;
+			std::string_view text;
+			SDL_Color        color;
+			int32_t          icon  = -1;
 		};
 
-		struct RenderQuery
+		/// <summary>
+		/// A glyph on an atlas page of the font cache, tinted to the color of its segment.
+		/// </summary>
+		struct GlyphQuad
 		{
-			SDL_Texture*     tex              = nullptr;
-			bool             bIsIcon          = false;
-			Sprite           icon;
+			SDL_Texture*     texture          = nullptr;
+			SDL_Rect         region           = { 0, 0, 0, 0 };
+			SDL_Color        color            = { 255, 255, 255, 255 };
 			Utilities::vec2  renderPosOffset  = { 0.0f };
+		};
 
-			virtual ~RenderQuery()
-			{
-				SDL_DestroyTexture(tex);
-			}
+		struct IconQuad
+		{
+			Sprite           icon;
+			Utilities::vec2  renderPosOffset  = { 0.0f };
 		};
 
 		static std::shared_ptr<TextComponent> create_text(std::string _contents, Utilities::vec2 _pos, const TextArgs _args = TextArgs::Default());
@@ -69,29 +81,56 @@ namespace Graphics
 		virtual void on_new_parent() override;
 
 	private:
-		std::vector<TextSegment> split_text_to_segments(const std::string& _contents) const;
+		/// <summary>
+		/// Splits the text on its color codes & icons in a single pass, e.g "Hi <col=#FF0000>there <icon=2>".
+		/// Codes that aren't valid are kept as text. The buffer gets cleared first, and keeps its capacity.
+		/// </summary>
+		/// <param name="_contents"></param>
+		/// <param name="_color">Color of the text up until the first color code.</param>
+		/// <param name="_segments"></param>
+		static void split_text_to_segments(const std::string_view _contents, SDL_Color _color, std::vector<TextSegment>& _segments);
 
 		void clean();
 
 		void rebuild_text();
 
-		void create_texture(const std::string& _contents, const SDL_Color& _col);
+		/// <summary>
+		/// Lays the glyphs of the text out from the pen onwards, and moves the pen past them.
+		/// </summary>
+		void layout_glyphs(FontCache::Font& _font, const std::string_view _text, const SDL_Color& _color, float& _penX);
 
-		const void generate_text_textures();
+		/// <summary>
+		/// Where the pen is in the render space of the component.
+		/// </summary>
+		const Utilities::vec2 to_render_offset(const float _penX) const;
 
-		static bool parse_hex_to_color(const std::string& _string, SDL_Color& _color);
+		/// <summary>
+		/// Length of the color code the text starts with, 0 when it doesn't start with a valid one.
+		/// </summary>
+		static const size_t parse_color_code(const std::string_view _text, SDL_Color& _color);
 
-		static bool is_icon(const std::string& _contents, int32_t& _iconId);
+		/// <summary>
+		/// Length of the icon code the text starts with, 0 when it doesn't start with a valid one.
+		/// </summary>
+		static const size_t parse_icon_code(const std::string_view _text, int32_t& _iconId);
+
+		/// <summary>
+		/// Decodes "RRGGBB", the alpha of the color is left as is.
+		/// </summary>
+		static const bool parse_hex_to_color(const std::string_view _hex, SDL_Color& _color);
 
 	private:
 		using UIComponent::UIComponent;
 
-		std::vector<std::shared_ptr<RenderQuery>> m_textTextures;
+		/// <summary>
+		/// Kept around between rebuilds, so changing the text doesn't have to allocate once they're large enough.
+		/// </summary>
+		std::vector<GlyphQuad> m_glyphs;
+		std::vector<IconQuad>  m_icons;
+
 		TextArgs        m_textArgs;
 		std::string     m_contents;
 		Utilities::vec2 m_iconRenderSize;
-		std::string     m_fontPath;
-		TTF_Font*       m_font;
 
 	    void renderText(std::shared_ptr<Graphics::Renderer> _renderer);
 
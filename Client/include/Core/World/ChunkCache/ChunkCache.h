@@ -0,0 +1,84 @@
+#pragma once
+#include "Core/World/TileMap/TileMap.h"
+
+#include "Core/Rendering/Renderer.h"
+
+#include <vector>
+
+/// <summary>
+/// Keeps the terrain of the chunks that were on screen lately pre-rendered into textures, so a chunk gets drawn as a single quad instead of tile by tile.
+/// The slots are limited by a memory budget, the chunk that was drawn the longest ago gets evicted to make room for another.
+/// Chunks get (re)built a few per frame, chunks that don't have an up to date texture yet have to get drawn tile by tile meanwhile.
+/// </summary>
+class ChunkCache
+{
+public:
+	/// <summary>
+	/// Size of a chunk texture in pixels.
+	/// </summary>
+	constexpr static int32_t CHUNK_PX_SIZE        = TileMap::CHUNK_SIZE * Graphics::Renderer::GRID_CELL_PX_SIZE;
+
+	/// <summary>
+	/// How much memory the chunk textures are allowed to take up.
+	/// </summary>
+	constexpr static size_t  MEMORY_BUDGET        = 64 * 1024 * 1024;
+
+	constexpr static size_t  SLOT_COUNT           = MEMORY_BUDGET / (static_cast<size_t>(CHUNK_PX_SIZE) * CHUNK_PX_SIZE * 4);
+
+	/// <summary>
+	/// How many chunks get rendered into their texture every frame, spreads the work out when a lot of chunks come into view at once.
+	/// </summary>
+	constexpr static uint32_t MAX_BUILDS_PER_FRAME = 1;
+
+	/// <summary>
+	/// Hands out a new build budget & advances the clock the least recently used slots get told apart by.
+	/// </summary>
+	void start_frame();
+
+	/// <summary>
+	/// Returns the texture of the chunk, builds it when it isn't cached or its tiles changed and the build budget of the frame allows it.
+	/// Returns nullptr when the chunk has to get drawn tile by tile this frame.
+	/// </summary>
+	/// <param name="_chunkCoords"></param>
+	/// <param name="_chunk"></param>
+	/// <param name="_palette">Sprite of every tile id.</param>
+	SDL_Texture* get_texture(const Utilities::ivec2& _chunkCoords, const TileMap::Chunk& _chunk, const std::vector<Graphics::Sprite>& _palette);
+
+	/// <summary>
+	/// Forgets every chunk, e.g when the renderer lost the contents of its render targets.
+	/// </summary>
+	void invalidate();
+
+public:
+	ChunkCache() = default;
+	~ChunkCache();
+
+private:
+	ChunkCache(const ChunkCache&) = delete;
+
+	struct Slot
+	{
+		SDL_Texture*     texture   = nullptr;
+		Utilities::ivec2 chunkCoords;
+		uint32_t         version   = 0;
+		uint64_t         lastUsed  = 0;
+		bool             bIsBuilt  = false;
+	};
+
+	/// <summary>
+	/// A free slot, or the least recently used one when every slot is taken.
+	/// Returns nullptr when every slot got used this frame.
+	/// </summary>
+	Slot* acquire_slot();
+
+	/// <summary>
+	/// Renders every tile of the chunk into the texture of the slot.
+	/// </summary>
+	const bool build(Slot& _slot, const TileMap::Chunk& _chunk, const std::vector<Graphics::Sprite>& _palette);
+
+private:
+	std::vector<Slot> m_slots;
+
+	uint64_t          m_frame  = 0;
+	uint32_t          m_builds = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "Shared/Utilities/vec2.hpp"
+
+#include <array>
+
+#include <unordered_map>
+
+/// <summary>
+/// The tiles of the world, stored as ids in chunks of CHUNK_SIZE x CHUNK_SIZE tiles.
+/// Only chunks that hold tiles take up memory, so the size of the world doesn't matter for what it costs to render the part that's on screen.
+/// </summary>
+class TileMap
+{
+public:
+	/// <summary>
+	/// Id of the tile within the palette of the world layer, 0 means there's no tile.
+	/// </summary>
+	using TileId = uint16_t;
+
+	constexpr static TileId  EMPTY_TILE       = 0;
+
+	constexpr static int32_t CHUNK_SIZE       = 16;
+	constexpr static int32_t CHUNK_TILE_COUNT = CHUNK_SIZE * CHUNK_SIZE;
+
+	struct Chunk
+	{
+		std::array<TileId, CHUNK_TILE_COUNT> tiles = {};
+
+		/// <summary>
+		/// Goes up whenever a tile of the chunk changes, tells whether what got built from the chunk is out of date.
+		/// </summary>
+		uint32_t                             version = 0;
+
+		inline const TileId get_tile(const Utilities::ivec2& _localCoords) const
+		{
+			return tiles[_localCoords.x + _localCoords.y * CHUNK_SIZE];
+		}
+	};
+
+	/// <summary>
+	/// Places the tile, creates the chunk it's in when that one doesn't exist yet.
+	/// </summary>
+	void set_tile(const Utilities::ivec2& _gridCoords, const TileId _tile);
+
+	const TileId get_tile(const Utilities::ivec2& _gridCoords) const;
+
+	/// <summary>
+	/// Returns nullptr when there's no tile within the chunk.
+	/// </summary>
+	const Chunk* get_chunk(const Utilities::ivec2& _chunkCoords) const;
+
+	void clear();
+
+	/// <summary>
+	/// Transforms gridspace coordinates to the coordinates of the chunk they're in, also for negative coordinates.
+	/// </summary>
+	static const Utilities::ivec2 to_chunk_coords(const Utilities::ivec2& _gridCoords);
+
+	/// <summary>
+	/// Transforms gridspace coordinates to coordinates relative to the chunk they're in.
+	/// </summary>
+	static const Utilities::ivec2 to_local_coords(const Utilities::ivec2& _gridCoords);
+
+private:
+	static const uint64_t to_key(const Utilities::ivec2& _chunkCoords);
+
+private:
+	std::unordered_map<uint64_t, Chunk> m_chunks;
+};
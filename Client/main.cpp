@@ -2,16 +2,46 @@
 
 #include "Core/Network/Client/ClientWrapper.h"
 
+#include "Core/Application/Assets/AssetLoader.h"
+
+#include "Core/Rendering/Atlas/AtlasPacker.h"
+
 #include <enet/enet.h>
 
+#include <cstring>
+
 int main(int argc, char** argv)
 {
+	//*--------------------------------------------------------------------------
+	// Packs the sprites into atlases instead of playing:
+	//   Client --pack-atlas [assets path]   Defaults to the assets next to the client.
+	//*
+	if (argc > 1 && strcmp(argv[1], "--pack-atlas") == 0)
+	{
+		IMG_Init(IMG_INIT_PNG);
+
+		const bool bSucceeded = Graphics::AtlasPacker::pack(argc > 2 ? argv[2] : "assets");
+
+		IMG_Quit();
+		return bSucceeded ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	if (enet_initialize() != 0)
 	{
 		fprintf(stderr, "An error occured while initializing ENet.\n");
 		return EXIT_FAILURE;
 	}
 
+	//*--------------------------------------------------------------------------
+	// The assets load on worker threads while we wait on the server, they get
+	// handed to the renderer once it exists.
+	//*
+	IMG_Init(IMG_INIT_PNG);
+
+	auto assetLoader = std::make_shared<AssetLoader>("assets");
+	assetLoader->load_sprites();
+	assetLoader->load_fonts();
+
 	bool valid_connection = false;
 
 	Client c = Client::connect_localhost(valid_connection);
@@ -22,7 +52,11 @@ int main(int argc, char** argv)
 		return EXIT_FAILURE;
 	}
 
-	c.start_ticking();
+	c.start_ticking(assetLoader);
+
+	//The workers have to be done before SDL shuts down.
+	assetLoader.reset();
+
 	c.quit();
 
 	return 0;
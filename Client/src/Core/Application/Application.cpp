@@ -12,6 +12,8 @@
 
 #include "Core/Rendering/Renderer.h"
 
+#include "Core/Application/Assets/AssetLoader.h"
+
 #include "Core/Rendering/Camera/Camera.h"
 
 #include "Core/Global/C_Globals.h"
@@ -53,10 +55,17 @@ void Application::init()
 void Application::load_sprites()
 {
 	std::shared_ptr<Graphics::Renderer> renderer = g_globals.renderer.lock();
+
+	//Hands over whatever finished loading while we connected.
+	g_globals.assetLoader.lock()->update();
 	
+	//The sprites that are still loading get drawn as placeholders until the asset loader binds them.
 	for(auto& sprite : Graphics::SpriteConfig::spriteMap()) 
 	{
-		renderer->load_and_bind_surface(sprite.Path, sprite.Type, sprite.Rows, sprite.Columns);
+		if (renderer->has_sprite(sprite.Type))
+			continue;
+
+		renderer->bind_placeholder(sprite.Type, sprite.Rows, sprite.Columns);
 	}
 }
 
@@ -152,7 +161,7 @@ void Application::close_application()
 	Packets::s_PacketHeader packet;
 	packet.interpreter = e_PacketInterpreter::PACKET_REMOVE_ENTITY;
 
-	packetHandler->send_packet<Packets::s_PacketHeader>(&packet, 0, ENET_PACKET_FLAG_RELIABLE);
+	packetHandler->send_packet<Packets::s_PacketHeader>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
 
 	m_bIsrunning = false;
 }
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "precomp.h"
+
+#include "Core/Application/Assets/AssetLoader.h"
+
+#include "Core/Application/Config/Config.h"
+
+#include "Core/Rendering/Atlas/AtlasPacker.h"
+
+#include "Core/Rendering/Renderer.h"
+
+#include "Core/Global/C_Globals.h"
+
+#include <unordered_set>
+
+AssetLoader::AssetLoader(const std::string& _assetsPath) :
+	m_assetsPath(_assetsPath)
+{
+	const uint32_t cores = std::thread::hardware_concurrency();
+	const uint32_t workerCount = std::clamp(cores > 1 ? cores - 1 : 1, 1u, MAX_WORKERS);
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		m_workers.emplace_back(&AssetLoader::work, this);
+	}
+}
+
+AssetLoader::~AssetLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bIsRunning = false;
+	}
+
+	m_condition.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void AssetLoader::load_sprites()
+{
+	std::unordered_set<Graphics::SpriteType> packed;
+
+	//*-----------------------------------------------------------------------
+	// Every atlas is a single image to decode, the sprites that were added
+	// since the atlases got packed still get loaded from their own file. A
+	// stale manifest gets ignored as a whole.
+	//*
+	const std::string folder = m_assetsPath + Graphics::AtlasPacker::ATLAS_FOLDER;
+
+	std::optional<Graphics::AtlasManifest> manifest = Graphics::AtlasManifest::load(folder + Graphics::AtlasPacker::MANIFEST_FILE);
+
+	if (manifest.has_value() && manifest->is_up_to_date(m_assetsPath))
+	{
+		for (uint32_t atlas = 0; atlas < manifest->atlases.size(); atlas++)
+		{
+			std::vector<Graphics::AtlasManifest::Sprite> sprites;
+
+			for (const Graphics::AtlasManifest::Sprite& sprite : manifest->sprites)
+			{
+				if (sprite.atlas == atlas)
+				{
+					sprites.push_back(sprite);
+					packed.insert(sprite.type);
+				}
+			}
+
+			request_image(folder + manifest->atlases[atlas], [this, sprites](SDL_Surface* _surface)
+			{
+				if (_surface != nullptr)
+				{
+					g_globals.renderer.lock()->bind_atlas(_surface, sprites);
+					return;
+				}
+
+				//Falls back on the image files of the sprites on the atlas.
+				for (const Graphics::SpriteArgs& args : Graphics::SpriteConfig::spriteMap())
+				{
+					const auto it = std::find_if(sprites.begin(), sprites.end(), [&args](const Graphics::AtlasManifest::Sprite& _sprite) { return _sprite.type == args.Type; });
+
+					if (it != sprites.end())
+					{
+						request_sprite(args);
+					}
+				}
+			});
+		}
+	}
+
+	for (const Graphics::SpriteArgs& sprite : Graphics::SpriteConfig::spriteMap())
+	{
+		if (packed.find(sprite.Type) == packed.end())
+		{
+			request_sprite(sprite);
+		}
+	}
+}
+
+void AssetLoader::load_fonts()
+{
+	for (const auto& [font, file] : Fonts::FontMap())
+	{
+		const std::string path = m_assetsPath + "/fonts/" + file;
+		std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>();
+
+		const e_FontType type = font;
+
+		Job job;
+		job.load = [path, data]()
+		{
+			std::ifstream stream(path, std::ios::binary);
+			data->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		};
+
+		job.finish = [this, type, path, data]()
+		{
+			//TextComponents read the font from disk themselves meanwhile.
+			if (data->empty())
+			{
+				DEVIOUS_WARN("Failed to read font: " << path);
+				return;
+			}
+
+			m_fonts[type] = data;
+		};
+
+		queue(std::move(job));
+	}
+}
+
+void AssetLoader::update()
+{
+	if (is_done())
+		return;
+
+	std::vector<Job> loaded;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		loaded.swap(m_loaded);
+	}
+
+	for (Job& job : loaded)
+	{
+		job.finish();
+		m_finished++;
+	}
+
+	if (!loaded.empty() && is_done())
+	{
+		DEVIOUS_EVENT("Loaded " << m_finished << " assets, " << DM::CLIENT::Config::get_time_since_start() * 1000.0f << "ms after startup.");
+	}
+}
+
+const bool AssetLoader::is_done() const
+{
+	return m_finished == m_pending;
+}
+
+std::shared_ptr<const std::vector<char>> AssetLoader::get_font_data(const e_FontType _font) const
+{
+	const auto it = m_fonts.find(_font);
+	return it != m_fonts.end() ? it->second : nullptr;
+}
+
+void AssetLoader::request_image(const std::string& _path, std::function<void(SDL_Surface*)> _onLoaded)
+{
+	//Frees the surface when it never makes it to the main thread.
+	struct DecodedImage
+	{
+		SDL_Surface* surface = nullptr;
+
+		~DecodedImage()
+		{
+			SDL_FreeSurface(surface);
+		}
+	};
+
+	std::shared_ptr<DecodedImage> image = std::make_shared<DecodedImage>();
+
+	Job job;
+	job.load = [_path, image]()
+	{
+		image->surface = IMG_Load(_path.c_str());
+	};
+
+	job.finish = [_path, image, _onLoaded]()
+	{
+		if (image->surface == nullptr)
+		{
+			DEVIOUS_ERR("Error loading image " << _path << ": " << IMG_GetError());
+		}
+
+		_onLoaded(std::exchange(image->surface, nullptr));
+	};
+
+	queue(std::move(job));
+}
+
+void AssetLoader::request_sprite(const Graphics::SpriteArgs& _sprite)
+{
+	const Graphics::SpriteType type    = _sprite.Type;
+	const uint32_t             rows    = _sprite.Rows;
+	const uint32_t             columns = _sprite.Columns;
+
+	request_image(m_assetsPath + "/sprites/" + _sprite.Path, [type, rows, columns](SDL_Surface* _surface)
+	{
+		//The placeholder stays in its place.
+		if (_surface == nullptr)
+			return;
+
+		g_globals.renderer.lock()->bind_surface(_surface, type, rows, columns);
+	});
+}
+
+void AssetLoader::queue(Job _job)
+{
+	m_pending++;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(std::move(_job));
+	}
+
+	m_condition.notify_one();
+}
+
+void AssetLoader::work()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return !m_bIsRunning || !m_jobs.empty(); });
+
+			if (!m_bIsRunning)
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		job.load();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_loaded.push_back(std::move(job));
+	}
+}
@@ -9,6 +9,9 @@ float DM::CLIENT::Config::s_deltaTime;
 //Decleration of last time tracked.
 std::chrono::time_point<std::chrono::high_resolution_clock> DM::CLIENT::Config::s_lastTime;
 
+//Gets set during static initialization, before main runs.
+const std::chrono::time_point<std::chrono::high_resolution_clock> DM::CLIENT::Config::s_startTime = std::chrono::high_resolution_clock::now();
+
 //Return the last updated deltatime.
 float DM::CLIENT::Config::get_deltaTime()
 {
@@ -31,3 +34,9 @@ void DM::CLIENT::Config::update_deltaTime()
 
 	s_deltaTime = std::min(s, MAX_DELTATIME);
 }
+
+float DM::CLIENT::Config::get_time_since_start()
+{
+	const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - s_startTime);
+	return static_cast<float>(duration.count() / 1000000.0f);
+}
\ No newline at end of file
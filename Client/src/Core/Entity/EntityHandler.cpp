@@ -48,6 +48,21 @@ void EntityHandler::remove_world_entity(DM::Utils::UUID _uuid)
 	m_worldEntities.erase(m_worldEntities.find(_uuid));
 }
 
+void EntityHandler::clear_world_entities()
+{
+	m_worldEntities.clear();
+	m_movementPredictor.cancel();
+
+	//The instance we join assigns us a new local player.
+	if (m_localPlayerId != 0)
+	{
+		const uint64_t localPlayerId = m_localPlayerId;
+		m_localPlayerId = 0;
+
+		on_local_player_removed.invoke(localPlayerId);
+	}
+}
+
 
 std::optional<RefEntity> EntityHandler::get_entity(DM::Utils::UUID _id) const
 {
@@ -82,12 +97,19 @@ void EntityHandler::register_local_player(uint64_t _localPlayerId)
 
 void EntityHandler::update()
 {
+	m_movementPredictor.update();
+
 	for(auto& [uuid, entity] : get_entities())
 	{
 		entity->update();
 	}
 }
 
+MovementPredictor& EntityHandler::get_movement_predictor()
+{
+	return m_movementPredictor;
+}
+
 const uint64_t EntityHandler::get_local_player_id() const
 {
 	return m_localPlayerId;
@@ -0,0 +1,179 @@
+#include "precomp.h"
+
+#include "Core/Entity/Simulation/MovementPredictor.h"
+
+#include "Core/Entity/EntityHandler.h"
+
+#include "Core/Network/Packets/ENetPacketHandler.h"
+
+#include "Core/Application/Config/Config.h"
+
+#include "Core/Global/C_Globals.h"
+
+#include "Shared/Navigation/AStar.hpp"
+
+#include <algorithm>
+
+void MovementPredictor::walk_to(const Utilities::ivec2 _destination, const bool _bIsRunning)
+{
+	Packets::s_EntityMovement movePacket;
+	movePacket.action = e_Action::MEDIUM_ACTION;
+	movePacket.interpreter = e_PacketInterpreter::PACKET_MOVE_ENTITY;
+	movePacket.x = _destination.x;
+	movePacket.y = _destination.y;
+	movePacket.isRunning = _bIsRunning;
+	movePacket.sequence = ++m_sequence;
+
+	auto packetHandler = g_globals.packetHandler.lock();
+	packetHandler->send_packet<Packets::s_EntityMovement>(&movePacket, CHANNEL_MOVEMENT, ENET_PACKET_FLAG_RELIABLE);
+
+	std::shared_ptr<EntityHandler> entityHandler = g_globals.entityHandler.lock();
+	std::optional<RefEntity> localPlayer = entityHandler->get_entity(entityHandler->get_local_player_id());
+
+	//Without a local player there's nothing to predict, the server moves it once it got assigned.
+	if (!localPlayer.has_value())
+	{
+		cancel();
+		return;
+	}
+
+	//*-----------------------------------------------------------------------
+	// Start from the tile our player is walking towards, that's where it
+	// stands on the server as well unless the server lags behind on an input.
+	//*
+	m_destination = _destination;
+	m_bIsRunning  = _bIsRunning;
+
+	predict_from(localPlayer.value()->get_simulated_data().get_target_tile());
+}
+
+void MovementPredictor::predict_from(const Utilities::ivec2 _start)
+{
+	m_start         = _start;
+	m_pathIndex     = 0;
+	m_stepTime      = 0.0f;
+	m_waitTime      = 0.0f;
+	m_bIsConfirmed  = false;
+	m_bIsPredicting = true;
+
+	m_path.clear();
+
+	if (_start != m_destination)
+	{
+		m_path = DM::Path::AStar::find_path(_start, m_destination);
+	}
+
+	//The server takes its first step on its next tick, we take ours straight away.
+	step();
+}
+
+const bool MovementPredictor::reconcile(const Packets::s_EntityMovement& _movement)
+{
+	if (!m_bIsPredicting)
+		return false;
+
+	//The server hasn't processed our latest input yet, this position belongs to an input we already moved on from.
+	if (_movement.sequence < m_sequence)
+		return true;
+
+	const Utilities::ivec2 position(_movement.x, _movement.y);
+
+	if (position == m_destination)
+	{
+		m_bIsConfirmed = true;
+
+		if (m_pathIndex == m_path.size())
+		{
+			m_bIsPredicting = false;
+		}
+
+		return true;
+	}
+
+	//We're ahead of the server, any tile along the predicted path is one we already walked past or are about to.
+	if (position == m_start || std::find(m_path.begin(), m_path.end(), position) != m_path.end())
+		return true;
+
+	//*-----------------------------------------------------------------------
+	// The server took another route, e.g it started walking from another tile.
+	// Walk over to where the server has us and predict the rest from there.
+	//*
+	DEVIOUS_LOG("Movement prediction " << m_sequence << " got corrected to: " << position.x << ", " << position.y << ".");
+
+	std::shared_ptr<EntityHandler> entityHandler = g_globals.entityHandler.lock();
+
+	if (std::optional<RefEntity> localPlayer = entityHandler->get_entity(entityHandler->get_local_player_id()); localPlayer.has_value())
+	{
+		localPlayer.value()->move_to(position);
+	}
+
+	m_start         = position;
+	m_pathIndex     = 0;
+	m_stepTime      = 0.0f;
+	m_path          = DM::Path::AStar::find_path(position, m_destination);
+
+	return true;
+}
+
+void MovementPredictor::cancel()
+{
+	m_bIsPredicting = false;
+	m_path.clear();
+}
+
+const bool MovementPredictor::is_predicting() const
+{
+	return m_bIsPredicting;
+}
+
+void MovementPredictor::update()
+{
+	if (!m_bIsPredicting)
+		return;
+
+	const float deltaTime = DM::CLIENT::Config::get_deltaTime();
+
+	if (m_pathIndex < m_path.size())
+	{
+		m_stepTime += deltaTime;
+
+		//Our player takes a step every tick just like on the server.
+		const float tickDuration = static_cast<float>(g_globals.packetHandler.lock()->get_clock_sync().get_tick_duration());
+
+		if (m_stepTime >= tickDuration)
+		{
+			m_stepTime -= tickDuration;
+			step();
+		}
+
+		return;
+	}
+
+	//Reached the destination, the server might've confirmed it already.
+	m_waitTime += deltaTime;
+
+	if (m_bIsConfirmed || m_waitTime >= CONFIRMATION_TIMEOUT)
+	{
+		m_bIsPredicting = false;
+	}
+}
+
+void MovementPredictor::step()
+{
+	if (m_pathIndex >= m_path.size())
+		return;
+
+	std::shared_ptr<EntityHandler> entityHandler = g_globals.entityHandler.lock();
+	std::optional<RefEntity> localPlayer = entityHandler->get_entity(entityHandler->get_local_player_id());
+
+	if (!localPlayer.has_value())
+	{
+		cancel();
+		return;
+	}
+
+	//Running takes two tiles per tick on the server.
+	m_pathIndex = std::min(m_path.size(), m_pathIndex + (m_bIsRunning ? 2 : 1));
+
+	localPlayer.value()->move_to(m_path[m_pathIndex - 1]);
+}
@@ -4,6 +4,10 @@
 
 #include "Core/Application/Config/Config.h"
 
+#include "Core/Network/Packets/ENetPacketHandler.h"
+
+#include "Core/Global/C_Globals.h"
+
 #include "Shared/Navigation/AStar.hpp"
 
 void SimPosition::set_target(const Utilities::vec2 _target)
@@ -16,6 +20,7 @@ void SimPosition::set_target(const Utilities::vec2 _target)
 
 	m_bIsDirty = true;
 	m_elapsedTime = 0.0f;
+	m_buffer.clear();
 
 	//*-----------------
 	//  Update positions
@@ -42,10 +47,87 @@ void SimPosition::set_target(const Utilities::vec2 _target)
 void SimPosition::set_current_position(const Utilities::vec2 _pos)
 {
 	m_currentPos = _pos;
+	m_buffer.clear();
+}
+
+void SimPosition::push_position(const uint32_t _tick, const Utilities::ivec2 _pos)
+{
+	//*-------------------------------------------------------------------------
+	// The movement packet & the snapshot of a tick hold the same position, and
+	// anything older than the latest position arrived out of order.
+	//*
+	if (!m_buffer.empty() && _tick <= m_buffer.back().tick)
+	{
+		if (_tick == m_buffer.back().tick)
+		{
+			m_buffer.back().position = Utilities::to_vec2(_pos);
+		}
+
+		return;
+	}
+
+	//*-------------------------------------------------------------------------
+	// Start walking from where the actor stands a tick before, otherwise the
+	// first step after standing still would be done by the time it's rendered.
+	//*
+	if (m_buffer.empty() || m_buffer.back().tick + 1 < _tick)
+	{
+		const Utilities::vec2 from = m_buffer.empty() ? m_currentPos : m_buffer.back().position;
+		m_buffer.push_back({ _tick - 1, from });
+	}
+
+	m_buffer.push_back({ _tick, Utilities::to_vec2(_pos) });
+
+	if (m_buffer.size() > BUFFER_SIZE)
+	{
+		m_buffer.erase(m_buffer.begin(), m_buffer.end() - BUFFER_SIZE);
+	}
+
+	m_startPos = m_currentPos;
+	m_endPos   = Utilities::to_vec2(_pos);
+	m_bIsDirty = true;
+}
+
+void SimPosition::update_buffered()
+{
+	const double renderTick = g_globals.packetHandler.lock()->get_clock_sync().get_render_tick();
+
+	//Drop the positions we're past, keeping the one we're interpolating from.
+	while (m_buffer.size() > 1 && static_cast<double>(m_buffer[1].tick) <= renderTick)
+	{
+		m_buffer.erase(m_buffer.begin());
+	}
+
+	const BufferedPosition& from = m_buffer.front();
+
+	//Either waiting on the first position to come up, or the last position got reached.
+	if (m_buffer.size() == 1 || renderTick <= static_cast<double>(from.tick))
+	{
+		m_currentPos = from.position;
+
+		if (m_buffer.size() == 1 && renderTick >= static_cast<double>(from.tick))
+		{
+			m_buffer.clear();
+			m_bIsDirty = false;
+		}
+
+		return;
+	}
+
+	const BufferedPosition& to = m_buffer[1];
+
+	const float alpha = static_cast<float>((renderTick - from.tick) / static_cast<double>(to.tick - from.tick));
+	m_currentPos = Utilities::vec2::lerp(from.position, to.position, alpha);
 }
 
 void SimPosition::update()
 {
+	if (!m_buffer.empty())
+	{
+		update_buffered();
+		return;
+	}
+
 	m_elapsedTime += RATE * DM::CLIENT::Config::get_deltaTime();
 
 	const static float MAX_TIMELINE     = 1.0f;
@@ -96,6 +178,11 @@ const Utilities::vec2 SimPosition::get_position() const
 	return m_currentPos + offset;
 }
 
+const Utilities::ivec2 SimPosition::get_target_tile() const
+{
+	return Utilities::to_ivec2(m_endPos);
+}
+
 SimPosition::SimPosition()
 {
 	m_bIsDirty = false;
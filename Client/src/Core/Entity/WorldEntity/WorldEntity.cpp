@@ -16,8 +16,6 @@
 
 #include "Core/Util/TimerHandler.h"
 
-#include "Core/Rendering/Camera/Camera.h"
-
 #include "Core/UI/UIComponent/Canvas/Canvas.h"
 
 #include "Core/UI/UIComponent/Hitsplat/Hitsplat.h"
@@ -155,7 +153,8 @@ void WorldEntity::say(std::string _text)
 void WorldEntity::teleport_to(Utilities::vec2 _destination)
 {
     m_simPos.m_bIsDirty = false;
-    m_simPos.m_currentPos = _destination;
+    m_simPos.set_current_position(_destination);
+    m_simPos.m_endPos = _destination;
 }
 
 void WorldEntity::die()
@@ -262,6 +261,14 @@ void WorldEntity::move_to(const Utilities::ivec2 _pos)
     set_position(Utilities::to_vec2(_pos));
 }
 
+void WorldEntity::interpolate_to(const uint32_t _tick, const Utilities::ivec2 _pos)
+{
+    m_sprite.bIsFlipped = _pos.x < m_simPos.get_target_tile().x;
+
+    m_simPos.push_position(_tick, _pos);
+    set_position(Utilities::to_vec2(_pos));
+}
+
 const Utilities::vec2 WorldEntity::get_position() const
 {
     return m_simPos.get_position();
@@ -300,7 +307,10 @@ bool WorldEntity::handle_event(const SDL_Event* _event)
                         packet.entityId    = m_entityUUID;
 
                         auto packetHandler = g_globals.packetHandler.lock();
-                        packetHandler->send_packet<Packets::s_ActionPacket>(&packet, 0, ENET_PACKET_FLAG_RELIABLE);
+                        packetHandler->send_packet<Packets::s_ActionPacket>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+
+                        //The server walks us towards the entity from now on.
+                        g_globals.entityHandler.lock()->get_movement_predictor().cancel();
                     };
 
                     OptionArgs option;
@@ -321,7 +331,10 @@ bool WorldEntity::handle_event(const SDL_Event* _event)
                         packet.entityId = m_entityUUID;
 
                         auto packetHandler = g_globals.packetHandler.lock();
-                        packetHandler->send_packet<Packets::s_ActionPacket>(&packet, 0, ENET_PACKET_FLAG_RELIABLE);
+                        packetHandler->send_packet<Packets::s_ActionPacket>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+
+                        //The server walks us towards the entity from now on.
+                        g_globals.entityHandler.lock()->get_movement_predictor().cancel();
                     };
 
                     OptionArgs option;
@@ -374,6 +387,11 @@ void WorldEntity::respawn()
     }
 }
 
+const bool WorldEntity::is_dead() const
+{
+    return m_bIsDead;
+}
+
 void WorldEntity::set_state(const e_EntityState& _state)
 {
     if (m_states[_state] == m_currentState)
@@ -386,24 +404,11 @@ void WorldEntity::set_state(const e_EntityState& _state)
 
 const bool WorldEntity::overlaps_rect(const int& _x, const int& _y) const
 {
-    const Utilities::ivec2 camPos = Utilities::to_ivec2(g_globals.renderer.lock()->get_camera()->get_position());
-
-    Utilities::ivec2 viewportSize;
-    g_globals.renderer.lock()->get_viewport_size(&viewportSize.x, &viewportSize.y);
-    viewportSize.x /= 2;
-    viewportSize.y /= 2;
-
-    // Calculate sprite's screen coordinates
-    const Utilities::ivec2 halfExtends = Utilities::to_ivec2(get_size() / 2.0f);
-
-    const Utilities::ivec2 transformedPos = Utilities::to_ivec2(m_simPos.get_position() * Graphics::Renderer::GRID_CELL_PX_SIZE) - camPos
-                                          + (viewportSize + halfExtends);
+    const Utilities::vec2 mousePos = g_globals.renderer.lock()->screen_to_world(Utilities::ivec2(_x, _y));
 
-    // Calculate sprite's bounding box
-    const int32_t left   = transformedPos.x - halfExtends.x;
-    const int32_t right  = transformedPos.x + halfExtends.x;
-    const int32_t top    = transformedPos.y - halfExtends.y;
-    const int32_t bottom = transformedPos.y + halfExtends.y;
+    // Calculate sprite's bounding box in gridspace
+    const Utilities::vec2 min = m_simPos.get_position();
+    const Utilities::vec2 max = min + get_size() / static_cast<float>(Graphics::Renderer::GRID_CELL_PX_SIZE);
 
-    return (_x > left && _x < right && _y > top && _y < bottom);
+    return (mousePos.x > min.x && mousePos.x < max.x && mousePos.y > min.y && mousePos.y < max.y);
 }
\ No newline at end of file
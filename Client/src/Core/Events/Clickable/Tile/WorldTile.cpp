@@ -4,7 +4,7 @@
 
 #include "Core/Rendering/Renderer.h"
 
-#include "Core/Network/Packets/ENetPacketHandler.h"
+#include "Core/Entity/EntityHandler.h"
 
 #include "Core/Global/C_Globals.h"
 
@@ -31,22 +31,21 @@ std::shared_ptr<WorldTile> WorldTile::create_tile(const Utilities::vec2& _positi
 }
 
 void WorldTile::on_left_click()
+{
+	walk_to(get_position());
+}
+
+void WorldTile::walk_to(const Utilities::vec2 _position)
 {
 	const Utilities::ivec2 worldPos
 	{
-		static_cast<int32_t>(get_position().x),
-		static_cast<int32_t>(get_position().y)
+		static_cast<int32_t>(_position.x),
+		static_cast<int32_t>(_position.y)
 	};
 
-	Packets::s_EntityMovement movePacket;
-	movePacket.action = e_Action::MEDIUM_ACTION;
-	movePacket.interpreter = e_PacketInterpreter::PACKET_MOVE_ENTITY;
-	movePacket.x = worldPos.x;
-	movePacket.y = worldPos.y;
-	movePacket.isRunning = true;
-
-	auto packetHandler = g_globals.packetHandler.lock();
-	packetHandler->send_packet<Packets::s_EntityMovement>(&movePacket, 0, 0);
+	//Starts walking straight away, the server confirms or corrects the prediction.
+	auto entityHandler = g_globals.entityHandler.lock();
+	entityHandler->get_movement_predictor().walk_to(worldPos, true);
 }
 
 bool WorldTile::handle_event(const SDL_Event* _event)
@@ -62,7 +61,9 @@ bool WorldTile::handle_event(const SDL_Event* _event)
 					OptionArgs optionArgs;
 					optionArgs.actionStr = "Walk here";
 					optionArgs.actionCol = { 255, 255, 0, 255 };
-					optionArgs.function = std::bind(&WorldTile::on_left_click, this);
+
+					//The tile moves along with the mouse, the option walks to where it was when the options opened.
+					optionArgs.function = std::bind(&WorldTile::walk_to, get_position());
 
 					OptionsTab::add_option(optionArgs);
 				}
@@ -74,6 +75,16 @@ bool WorldTile::handle_event(const SDL_Event* _event)
 	return Clickable::handle_event(_event);
 }
 
+void WorldTile::set_walkable(const bool _bIsWalkable)
+{
+	m_bIsWalkable = _bIsWalkable;
+}
+
+const bool WorldTile::overlaps_rect(const int& _x, const int& _y) const
+{
+	return m_bIsWalkable;
+}
+
 void WorldTile::on_hover()
 {
 }
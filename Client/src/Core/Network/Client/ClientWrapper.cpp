@@ -4,6 +4,7 @@
 
 #include "Core/Global/C_Globals.h"
 #include "Core/Application/Application.h"
+#include "Core/Application/Assets/AssetLoader.h"
 #include "Core/Application/Config/Config.h"
 #include "Core/Rendering/Renderer.h"
 #include "Core/Rendering/Camera/Camera.h"
@@ -43,7 +44,7 @@ Client Client::connect_host(bool& _succeeded, const char* _ip, const uint16_t _p
 
 	m_host = enet_host_create(NULL,
 		1,
-		2,
+		CHANNEL_COUNT,
 		0,
 		0);
 
@@ -55,11 +56,14 @@ Client Client::connect_host(bool& _succeeded, const char* _ip, const uint16_t _p
 		exit(EXIT_FAILURE);
 	}
 
+	//The server compresses its packets, so we need the same compressor to read them.
+	enet_host_compress_with_range_coder(m_host);
+
 	enet_address_set_host(&address, _ip);
 	address.port = _port;
 	
 
-	c.m_peer = enet_host_connect(m_host, &address, 2, 0);
+	c.m_peer = enet_host_connect(m_host, &address, CHANNEL_COUNT, 0);
 
 	if (c.m_peer == NULL)
 	{
@@ -109,7 +113,7 @@ void Client::quit()
 	DEVIOUS_EVENT("Shutting down.");
 }
 
-void Client::start_ticking()
+void Client::start_ticking(std::shared_ptr<AssetLoader> _assetLoader)
 {
 	//Packethandler creation.
 	auto packetHandler = std::make_shared<ENetPacketHandler>(m_host, m_peer);
@@ -134,18 +138,23 @@ void Client::start_ticking()
 		g_globals.packetHandler = packetHandler;
 		g_globals.entityHandler = entityHandler;
 		g_globals.timerHandler  = timerHandler;
+		g_globals.assetLoader   = _assetLoader;
 	}
 
 	//Create application
 	auto application = std::make_shared<Application>();
 	application->init();
 
+	bool bIsFirstFrame = true;
+
 	while (application->is_running())
 	{
 		DM::CLIENT::Config::update_deltaTime();
 
 		renderer->start_frame();
 
+		_assetLoader->update();
+
 		packetHandler->update();
 
 		application->update();
@@ -155,5 +164,11 @@ void Client::start_ticking()
 		entityHandler->update();
 
 		renderer->end_frame();
+
+		if (bIsFirstFrame)
+		{
+			DEVIOUS_EVENT("First frame presented " << DM::CLIENT::Config::get_time_since_start() * 1000.0f << "ms after startup.");
+			bIsFirstFrame = false;
+		}
 	}
 }
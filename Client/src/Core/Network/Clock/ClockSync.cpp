@@ -0,0 +1,77 @@
+#include "precomp.h"
+
+#include "Core/Network/Clock/ClockSync.h"
+
+#include <algorithm>
+
+void ClockSync::receive_tick(const uint32_t _tick)
+{
+	//Only the first packet of a tick, the ones after it got sent later on within the same tick.
+	if (m_sampleCount > 0 && _tick <= m_lastTick)
+		return;
+
+	m_lastTick = _tick;
+
+	const double sample = get_time() - static_cast<double>(_tick) * m_tickDuration;
+
+	//A late packet only adds latency, a tick this late means the server skipped ticks. Lag spikes start over as well, the next sample on time takes over again.
+	if (m_sampleCount > 0 && sample - m_offset > RESYNC_THRESHOLD_TICKS * m_tickDuration)
+	{
+		reset();
+		m_lastTick = _tick;
+	}
+
+	m_samples[m_nextSample] = sample;
+	m_nextSample  = (m_nextSample + 1) % SAMPLE_COUNT;
+	m_sampleCount = std::min(m_sampleCount + 1, SAMPLE_COUNT);
+
+	m_offset = *std::min_element(m_samples.begin(), m_samples.begin() + m_sampleCount);
+}
+
+void ClockSync::set_tick_period(const uint32_t _tickPeriodMs)
+{
+	//*-----------------------------------------------------------------------
+	// The samples are measured against the tick period, once the server runs
+	// at another rate the offsets they hold no longer line up with new ones.
+	//*
+	const double tickDuration = static_cast<double>(_tickPeriodMs) / 1000.0;
+
+	if (_tickPeriodMs == 0 || tickDuration == m_tickDuration)
+		return;
+
+	reset();
+	m_tickDuration = tickDuration;
+}
+
+const double ClockSync::get_server_tick() const
+{
+	return (get_time() - m_offset) / m_tickDuration;
+}
+
+const double ClockSync::get_render_tick() const
+{
+	return get_server_tick() - INTERPOLATION_DELAY_TICKS;
+}
+
+const bool ClockSync::is_synchronized() const
+{
+	return m_sampleCount > 0;
+}
+
+const double ClockSync::get_tick_duration() const
+{
+	return m_tickDuration;
+}
+
+void ClockSync::reset()
+{
+	m_sampleCount = 0;
+	m_nextSample  = 0;
+	m_lastTick    = 0;
+	m_offset      = 0.0;
+}
+
+double ClockSync::get_time()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
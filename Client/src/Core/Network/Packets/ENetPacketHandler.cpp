@@ -14,6 +14,8 @@
 
 #include <enet/enet.h> 
 
+#include <chrono>
+
 /// We ignore the initialization warning since the ENetEvent doesn't need to get initialized.
 ///
 /// 
@@ -35,7 +37,8 @@ ENetPacketHandler::~ENetPacketHandler()
 void ENetPacketHandler::update()
 {
 	//---ENET EVENT HANDLING---//
-	if (enet_host_service(m_host, &m_event, 0) > 0)
+	//Drain everything that came in since the last frame, a world snapshot arrives in multiple chunks at once.
+	while (enet_host_service(m_host, &m_event, 0) > 0)
 	{
 		switch (m_event.type)
 		{
@@ -54,7 +57,7 @@ void ENetPacketHandler::update()
 		{
 			on_disconnect.invoke();
 		}	
-		break;
+		return;
 		}
 	}
 }
@@ -75,22 +78,33 @@ void ENetPacketHandler::process_packet()
 			Packets::s_EntityMovement entityData;
 			PacketHandler::retrieve_packet_data<Packets::s_EntityMovement>(entityData, &m_event);
 
-			if (auto entityOpt = entityHandler->get_entity(entityData.entityId); entityOpt != std::nullopt)
+			if (entityData.tick != 0)
 			{
-				RefEntity entity = entityOpt.value();
-				entity->move_to(Utilities::ivec2(entityData.x, entityData.y));
-				return;
+				m_clockSync.receive_tick(entityData.tick);
 			}
 
-			DEVIOUS_WARN("Tried to move non existing entity. " << entityData.entityId);
-		}
-		break;
+			//Our own player is predicted, only positions that disagree with the prediction get applied.
+			if (entityData.entityId == entityHandler->get_local_player_id() && entityHandler->get_movement_predictor().reconcile(entityData))
+				break;
 
-		case e_PacketInterpreter::PACKET_PING:
-		{
-			Packets::s_PacketHeader packet;
-			packet.interpreter = e_PacketInterpreter::PACKET_PING;
-			send_packet<Packets::s_PacketHeader>(&packet, 0, ENET_PACKET_FLAG_RELIABLE);
+			auto entityOpt = entityHandler->get_entity(entityData.entityId);
+
+			if (entityOpt == std::nullopt)
+			{
+				DEVIOUS_WARN("Tried to move non existing entity. " << entityData.entityId);
+				break;
+			}
+
+			RefEntity entity = entityOpt.value();
+
+			if (entityData.tick != 0)
+			{
+				entity->interpolate_to(entityData.tick, Utilities::ivec2(entityData.x, entityData.y));
+			}
+			else
+			{
+				entity->move_to(Utilities::ivec2(entityData.x, entityData.y));
+			}
 		}
 		break;
 
@@ -107,6 +121,43 @@ void ENetPacketHandler::process_packet()
 		}
 		break;
 
+		case e_PacketInterpreter::PACKET_WORLD_SNAPSHOT:
+		{
+			Packets::s_WorldSnapshot packet;
+			PacketHandler::retrieve_packet_data<Packets::s_WorldSnapshot>(packet, &m_event);
+			apply_world_snapshot(packet);
+		}
+		break;
+
+		case e_PacketInterpreter::PACKET_STATE_SNAPSHOT:
+		{
+			Packets::s_StateSnapshot packet;
+			PacketHandler::retrieve_packet_data<Packets::s_StateSnapshot>(packet, &m_event);
+
+			if (packet.tick != 0)
+			{
+				m_clockSync.receive_tick(packet.tick);
+			}
+
+			//Let the server know it can write its deltas against this snapshot from now on.
+			if (m_replication.receive(packet))
+			{
+				Packets::s_SnapshotAck ack;
+				ack.interpreter = e_PacketInterpreter::PACKET_SNAPSHOT_ACK;
+				ack.sequence    = packet.sequence;
+				send_packet<Packets::s_SnapshotAck>(&ack, CHANNEL_SNAPSHOT, 0);
+			}
+		}
+		break;
+
+		case e_PacketInterpreter::PACKET_TICK_PERIOD:
+		{
+			Packets::s_TickPeriod packet;
+			PacketHandler::retrieve_packet_data<Packets::s_TickPeriod>(packet, &m_event);
+			m_clockSync.set_tick_period(packet.period);
+		}
+		break;
+
 		case e_PacketInterpreter::PACKET_ASSIGN_LOCAL_PLAYER_ENTITY:
 		{
 			Packets::s_CreateEntity player;
@@ -123,6 +174,49 @@ void ENetPacketHandler::process_packet()
 		}
 		break;
 
+		//The server moved us to another world instance, which sends over its own world snapshot.
+		case e_PacketInterpreter::PACKET_CHANGE_INSTANCE:
+		{
+			entityHandler->clear_world_entities();
+			m_replication.reset();
+			m_clockSync.reset();
+		}
+		break;
+
+		//*------------------------------------------------------------------
+		// Our player walked into a zone hosted by another server, reconnect to
+		// it with the token so it picks up the player where it left off.
+		//*
+		case e_PacketInterpreter::PACKET_ZONE_REDIRECT:
+		{
+			Packets::s_ZoneRedirect packet;
+			PacketHandler::retrieve_packet_data<Packets::s_ZoneRedirect>(packet, &m_event);
+
+			entityHandler->clear_world_entities();
+			m_replication.reset();
+			m_clockSync.reset();
+
+			//Resets the peer straight away, so no disconnect event fires for the old server.
+			enet_peer_disconnect_now(m_peer, 0);
+
+			ENetAddress address;
+			enet_address_set_host(&address, packet.address.c_str());
+			address.port = packet.port;
+
+			//The client host only has a single peer, the new connection takes the slot the old one freed up.
+			m_peer = enet_host_connect(m_host, &address, CHANNEL_COUNT, packet.token);
+
+			if (m_peer == nullptr)
+			{
+				DEVIOUS_ERR("Couldn't reconnect to the zone at: [" << packet.address << ":" << packet.port << "].");
+				on_disconnect.invoke();
+				break;
+			}
+
+			DEVIOUS_EVENT("Redirected to the zone at: [" << packet.address << ":" << packet.port << "].");
+		}
+		break;
+
 		case e_PacketInterpreter::PACKET_TIMEOUT_WARNING:
 		{
 			DEVIOUS_WARN("You have been idle for a while, you will get disconnected soon if you stay idle.");
@@ -158,7 +252,7 @@ void ENetPacketHandler::process_packet()
 			{
 				RefEntity entt = optEntity.value();
 				entt->update_skill(packet.skillType, packet.level, packet.levelBoosted);
-				return;
+				break;
 			}
 		}
 		break;
@@ -172,7 +266,7 @@ void ENetPacketHandler::process_packet()
 			{
 				RefEntity entt = optEntity.value();
 				entt->die();
-				return;
+				break;
 			}
 		}
 		break;
@@ -186,7 +280,7 @@ void ENetPacketHandler::process_packet()
 			{
 				RefEntity entt = optEntity.value();
 				entt->respawn();
-				return;
+				break;
 			}
 		}
 		break;
@@ -200,7 +294,7 @@ void ENetPacketHandler::process_packet()
 			{
 				RefEntity entt = optEntity.value();
 				entt->set_visibility(packet.bShouldHide);
-				return;
+				break;
 			}
 		}
 		break;
@@ -210,6 +304,11 @@ void ENetPacketHandler::process_packet()
 			Packets::s_TeleportEntity packet;
 			PacketHandler::retrieve_packet_data<Packets::s_TeleportEntity>(packet, &m_event);
 
+			if (packet.entityId == entityHandler->get_local_player_id())
+			{
+				entityHandler->get_movement_predictor().cancel();
+			}
+
 			if (auto optEntity = g_globals.entityHandler.lock()->get_entity(packet.entityId); optEntity.has_value())
 			{
 				RefEntity entt = optEntity.value();
@@ -277,3 +376,59 @@ void ENetPacketHandler::process_packet()
 
 	enet_packet_destroy(m_event.packet);
 }
+
+void ENetPacketHandler::apply_world_snapshot(const Packets::s_WorldSnapshot& _snapshot)
+{
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	std::shared_ptr<EntityHandler> entityHandler = g_globals.entityHandler.lock();
+
+	//*----------------------------------------------------------------------------
+	// Create every entity we don't know about yet, entities that already exist get
+	// their state overwritten since the snapshot is more recent.
+	//*
+	for (const Packets::s_SnapshotEntity& snapshotEntity : _snapshot.entities)
+	{
+		RefEntity entity;
+
+		if (auto optEntity = entityHandler->get_entity(snapshotEntity.entityId); optEntity.has_value())
+		{
+			entity = optEntity.value();
+			entity->teleport_to
+			(
+				Utilities::vec2
+				(
+					static_cast<float>(snapshotEntity.posX),
+					static_cast<float>(snapshotEntity.posY)
+				)
+			);
+		}
+		else
+		{
+			entityHandler->create_world_entity(snapshotEntity.entityId, snapshotEntity.npcId, Utilities::ivec2(snapshotEntity.posX, snapshotEntity.posY));
+			entity = entityHandler->get_entity(snapshotEntity.entityId).value();
+		}
+
+		entity->set_visibility(snapshotEntity.bIsHidden);
+
+		if (!snapshotEntity.name.empty())
+		{
+			entity->set_name(snapshotEntity.name);
+		}
+
+		for (const Packets::s_SnapshotSkill& skill : snapshotEntity.skills)
+		{
+			entity->update_skill(skill.skillType, skill.level, skill.levelBoosted);
+		}
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+
+	DEVIOUS_EVENT("Applied world snapshot chunk " << (_snapshot.chunkIndex + 1) << "/" << _snapshot.chunkCount << " with " << _snapshot.entities.size()
+		          << " entities in " << std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() << "us.");
+}
+
+const ClockSync& ENetPacketHandler::get_clock_sync() const
+{
+	return m_clockSync;
+}
@@ -0,0 +1,179 @@
+#include "precomp.h"
+
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Core/Entity/EntityHandler.h"
+
+#include "Core/Global/C_Globals.h"
+
+#include "Core/UI/UIComponent/Chatbox/Chatbox.h"
+
+#include <algorithm>
+
+using namespace DM::Replication;
+
+bool ReplicationHandler::receive(const Packets::s_StateSnapshot& _snapshot)
+{
+	//The channel is sequenced, but a snapshot we already got past is of no use either way.
+	if (_snapshot.sequence <= m_latestSequence)
+		return false;
+
+	const ReplicatedSnapshot* baseline = &m_emptySnapshot;
+
+	if (_snapshot.baseline != 0)
+	{
+		baseline = get_snapshot(_snapshot.baseline);
+
+		if (baseline == nullptr)
+		{
+			DEVIOUS_WARN("Received snapshot " << _snapshot.sequence << " against unknown baseline " << _snapshot.baseline << ".");
+			return false;
+		}
+	}
+
+	ReplicatedSnapshot current;
+	BitReader reader(_snapshot.data);
+
+	if (!read_delta(*baseline, reader, current, m_changes))
+	{
+		DEVIOUS_WARN("Couldn't read snapshot " << _snapshot.sequence << ", the delta is corrupt.");
+		return false;
+	}
+
+	m_latestSequence = _snapshot.sequence;
+	m_tick           = _snapshot.tick;
+	m_historySequences[_snapshot.sequence % SNAPSHOT_HISTORY] = _snapshot.sequence;
+	m_history[_snapshot.sequence % SNAPSHOT_HISTORY]          = std::move(current);
+
+	const ReplicatedSnapshot& snapshot = m_history[_snapshot.sequence % SNAPSHOT_HISTORY];
+
+	for (const s_ReplicatedChange& change : m_changes)
+	{
+		const s_ReplicatedState* state = nullptr;
+
+		if (change.op != e_ReplicatedOp::REMOVE)
+		{
+			const auto it = std::lower_bound(snapshot.begin(), snapshot.end(), change.entityId, [](const s_ReplicatedEntity& _entity, const uint64_t _id)
+			{
+				return _entity.entityId < _id;
+			});
+
+			state = it->state.get();
+		}
+
+		apply_change(change, state);
+	}
+
+	return true;
+}
+
+void ReplicationHandler::apply_change(const s_ReplicatedChange& _change, const s_ReplicatedState* _state)
+{
+	std::shared_ptr<EntityHandler> entityHandler = g_globals.entityHandler.lock();
+
+	std::optional<RefEntity> optEntity = entityHandler->get_entity(_change.entityId);
+
+	if (_change.op == e_ReplicatedOp::REMOVE)
+	{
+		if (optEntity.has_value())
+		{
+			entityHandler->remove_world_entity(_change.entityId);
+		}
+
+		return;
+	}
+
+	//*----------------------------------------------------------------------------
+	// A creation only holds the fields that differ from the defaults, the entity
+	// might already exist through the regular packets with different values.
+	//*
+	uint8_t fields = _change.fields;
+
+	if (_change.op == e_ReplicatedOp::CREATE)
+	{
+		fields = FIELD_POSITION | FIELD_FLAGS | FIELD_NAME | FIELD_SKILLS;
+	}
+
+	if (!optEntity.has_value())
+	{
+		entityHandler->create_world_entity(_change.entityId, _state->npcId, Utilities::ivec2(_state->posX, _state->posY));
+		optEntity = entityHandler->get_entity(_change.entityId);
+	}
+
+	RefEntity entity = optEntity.value();
+
+	//The snapshots don't know which input our player is on, while its movement is predicted only the movement packets get compared.
+	if (_change.entityId == entityHandler->get_local_player_id() && entityHandler->get_movement_predictor().is_predicting())
+	{
+		fields &= ~FIELD_POSITION;
+	}
+
+	if (fields & FIELD_POSITION)
+	{
+		//Compared against the latest position we know of, the rendered one lags behind by the interpolation delay.
+		const Utilities::ivec2 position = entity->get_simulated_data().get_target_tile();
+		const int32_t distance = std::max(std::abs(position.x - _state->posX), std::abs(position.y - _state->posY));
+
+		//Anything further than a run step is a teleport.
+		if (distance > 2)
+		{
+			entity->teleport_to(Utilities::vec2(static_cast<float>(_state->posX), static_cast<float>(_state->posY)));
+		}
+		else if (m_tick != 0)
+		{
+			entity->interpolate_to(m_tick, Utilities::ivec2(_state->posX, _state->posY));
+		}
+		else
+		{
+			entity->move_to(Utilities::ivec2(_state->posX, _state->posY));
+		}
+	}
+
+	if (fields & FIELD_FLAGS)
+	{
+		entity->set_visibility(_state->bIsHidden);
+
+		if (_state->bIsDead != entity->is_dead())
+		{
+			_state->bIsDead ? entity->die() : entity->respawn();
+		}
+	}
+
+	if ((fields & FIELD_NAME) && !_state->name.empty() && _state->name != entity->get_name())
+	{
+		entity->set_name(_state->name);
+
+		if (_change.entityId == entityHandler->get_local_player_id())
+		{
+			Chatbox::s_on_name_changed.invoke(_state->name);
+		}
+	}
+
+	if (fields & FIELD_SKILLS)
+	{
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			entity->update_skill(i, _state->levels[i], _state->boostedLevels[i]);
+		}
+	}
+}
+
+void ReplicationHandler::reset()
+{
+	for (ReplicatedSnapshot& snapshot : m_history)
+	{
+		snapshot.clear();
+	}
+
+	m_historySequences.fill(0);
+	m_latestSequence = 0;
+	m_tick           = 0;
+}
+
+const ReplicatedSnapshot* ReplicationHandler::get_snapshot(const uint32_t _sequence) const
+{
+	if (_sequence == 0 || m_historySequences[_sequence % SNAPSHOT_HISTORY] != _sequence)
+		return nullptr;
+
+	return &m_history[_sequence % SNAPSHOT_HISTORY];
+}
@@ -0,0 +1,119 @@
+#include "precomp.h"
+
+#include "Core/Rendering/Atlas/AtlasManifest.h"
+
+#include "Shared/Game/SpriteTypes.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+std::optional<Graphics::AtlasManifest> Graphics::AtlasManifest::load(const std::string& _path)
+{
+	std::ifstream file(_path);
+
+	if (!file.is_open())
+		return std::nullopt;
+
+	AtlasManifest manifest;
+
+	std::string label;
+	size_t atlasCount = 0;
+	file >> label >> atlasCount;
+
+	manifest.atlases.resize(atlasCount);
+
+	for (std::string& atlas : manifest.atlases)
+	{
+		file >> atlas;
+	}
+
+	size_t spriteCount = 0;
+	file >> label >> spriteCount;
+
+	for (size_t i = 0; i < spriteCount && file.good(); i++)
+	{
+		Sprite sprite;
+		uint32_t type = 0;
+		file >> type >> sprite.atlas >> sprite.size.x >> sprite.size.y >> sprite.rows >> sprite.columns >> sprite.sourceStamp;
+
+		sprite.type = static_cast<SpriteType>(type);
+		sprite.frames.resize(static_cast<size_t>(std::max(sprite.rows, 1u)) * std::max(sprite.columns, 1u));
+
+		for (SDL_Rect& frame : sprite.frames)
+		{
+			file >> frame.x >> frame.y >> frame.w >> frame.h;
+		}
+
+		manifest.sprites.push_back(std::move(sprite));
+	}
+
+	if (file.fail())
+	{
+		DEVIOUS_WARN("The atlas manifest is malformed, rebuild the client or run it with --pack-atlas to pack the atlases again.");
+		return std::nullopt;
+	}
+
+	return manifest;
+}
+
+const bool Graphics::AtlasManifest::save(const std::string& _path) const
+{
+	std::ofstream file(_path, std::ios::trunc);
+
+	file << "atlases " << atlases.size() << "\n";
+
+	for (const std::string& atlas : atlases)
+	{
+		file << atlas << "\n";
+	}
+
+	file << "sprites " << sprites.size() << "\n";
+
+	for (const Sprite& sprite : sprites)
+	{
+		file << static_cast<uint32_t>(sprite.type) << " " << sprite.atlas << " " << sprite.size.x << " " << sprite.size.y << " " << sprite.rows << " " << sprite.columns << " " << sprite.sourceStamp << "\n";
+
+		for (const SDL_Rect& frame : sprite.frames)
+		{
+			file << frame.x << " " << frame.y << " " << frame.w << " " << frame.h << "\n";
+		}
+	}
+
+	return file.good();
+}
+
+const bool Graphics::AtlasManifest::is_up_to_date(const std::string& _assetsPath) const
+{
+	const SpriteConfig::SpriteMap config = SpriteConfig::spriteMap();
+
+	//Only needs a look at the file system, none of the image files get read.
+	for (const Sprite& sprite : sprites)
+	{
+		const auto it = std::find_if(config.begin(), config.end(), [&sprite](const SpriteArgs& _args) { return _args.Type == sprite.type; });
+
+		if (it == config.end() || it->Rows != sprite.rows || it->Columns != sprite.columns)
+		{
+			DEVIOUS_WARN("The atlases are stale, sprite " << static_cast<uint32_t>(sprite.type) << " got removed or split up differently since they got packed.");
+			return false;
+		}
+
+		if (get_source_stamp(_assetsPath + "/sprites/" + it->Path) != sprite.sourceStamp)
+		{
+			DEVIOUS_WARN("The atlases are stale, " << it->Path << " changed since they got packed.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const int64_t Graphics::AtlasManifest::get_source_stamp(const std::string& _path)
+{
+	std::error_code error;
+	const std::filesystem::file_time_type time = std::filesystem::last_write_time(_path, error);
+
+	if (error)
+		return 0;
+
+	return static_cast<int64_t>(time.time_since_epoch().count());
+}
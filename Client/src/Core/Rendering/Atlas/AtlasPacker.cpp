@@ -0,0 +1,235 @@
+#include "precomp.h"
+
+#include "Core/Rendering/Atlas/AtlasPacker.h"
+
+#include "Core/Rendering/Atlas/AtlasManifest.h"
+
+#include "Core/Rendering/Renderer.h"
+
+#include "Shared/Game/SpriteTypes.hpp"
+
+#include <filesystem>
+
+const bool Graphics::AtlasPacker::pack(const std::string& _assetsPath)
+{
+	const SpriteConfig::SpriteMap sprites = SpriteConfig::spriteMap();
+
+	//Runs after every build, only pack again when a sprite got added, split up differently or its image changed.
+	if (std::optional<AtlasManifest> manifest = AtlasManifest::load(_assetsPath + ATLAS_FOLDER + MANIFEST_FILE); manifest.has_value())
+	{
+		if (manifest->sprites.size() == sprites.size() && manifest->is_up_to_date(_assetsPath))
+		{
+			DEVIOUS_EVENT("The atlases are up to date.");
+			return true;
+		}
+	}
+
+	std::vector<SDL_Surface*> surfaces;
+	std::vector<Frame>        frames;
+
+	bool bSucceeded = true;
+
+	for (size_t i = 0; i < sprites.size() && bSucceeded; i++)
+	{
+		const std::string path = _assetsPath + "/sprites/" + sprites[i].Path;
+		SDL_Surface* loaded = IMG_Load(path.c_str());
+
+		if (loaded == nullptr)
+		{
+			DEVIOUS_ERR("Failed to load " << path << ": " << IMG_GetError());
+			bSucceeded = false;
+			break;
+		}
+
+		//Every image gets copied over as is, alpha included, so they all need the same pixel layout as the atlas.
+		SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(loaded);
+
+		SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+		surfaces.push_back(surface);
+
+		for (const SDL_Rect& rect : Renderer::SDL_SpriteDetails::split_frames(Utilities::ivec2(surface->w, surface->h), sprites[i].Rows, sprites[i].Columns))
+		{
+			Frame frame;
+			frame.sprite = i;
+			frame.source = rect;
+
+			frames.push_back(frame);
+		}
+	}
+
+	std::vector<Frame*> placement;
+
+	for (Frame& frame : frames)
+	{
+		placement.push_back(&frame);
+	}
+
+	const uint32_t atlasCount = bSucceeded ? place_frames(placement) : 0;
+	bSucceeded = atlasCount != 0;
+
+	//*-----------------------------------------------------------------------
+	// Copy the frames onto the atlases, every atlas only gets as tall as the
+	// shelves on it, and write them next to the manifest.
+	//*
+	const std::string folder = _assetsPath + ATLAS_FOLDER;
+	std::vector<std::string> atlasFiles;
+
+	if (bSucceeded)
+	{
+		std::filesystem::create_directories(folder);
+	}
+
+	for (uint32_t atlas = 0; atlas < atlasCount && bSucceeded; atlas++)
+	{
+		int32_t height = 0;
+
+		for (const Frame& frame : frames)
+		{
+			if (frame.atlas == atlas)
+			{
+				height = std::max(height, frame.position.y + frame.source.h);
+			}
+		}
+
+		SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_SIZE, height, 32, SDL_PIXELFORMAT_RGBA32);
+		SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, 0, 0, 0, 0));
+
+		for (const Frame& frame : frames)
+		{
+			if (frame.atlas != atlas)
+				continue;
+
+			SDL_Rect source = frame.source;
+			SDL_Rect dest   = { frame.position.x, frame.position.y, frame.source.w, frame.source.h };
+
+			SDL_BlitSurface(surfaces[frame.sprite], &source, surface, &dest);
+		}
+
+		const std::string file = "atlas_" + std::to_string(atlas) + ".png";
+
+		if (IMG_SavePNG(surface, (folder + file).c_str()) != 0)
+		{
+			DEVIOUS_ERR("Failed to write " << folder << file << ": " << IMG_GetError());
+			bSucceeded = false;
+		}
+
+		atlasFiles.push_back(file);
+		SDL_FreeSurface(surface);
+	}
+
+	if (bSucceeded)
+	{
+		AtlasManifest manifest;
+		manifest.atlases = atlasFiles;
+
+		for (size_t i = 0; i < sprites.size(); i++)
+		{
+			AtlasManifest::Sprite sprite;
+			sprite.type    = sprites[i].Type;
+			sprite.size    = Utilities::ivec2(surfaces[i]->w, surfaces[i]->h);
+			sprite.rows    = sprites[i].Rows;
+			sprite.columns = sprites[i].Columns;
+
+			sprite.sourceStamp = AtlasManifest::get_source_stamp(_assetsPath + "/sprites/" + sprites[i].Path);
+
+			//The frames are still in the order they got split in, row by row.
+			for (const Frame& frame : frames)
+			{
+				if (frame.sprite != i)
+					continue;
+
+				sprite.atlas = frame.atlas;
+				sprite.frames.push_back({ frame.position.x, frame.position.y, frame.source.w, frame.source.h });
+			}
+
+			manifest.sprites.push_back(std::move(sprite));
+		}
+
+		bSucceeded = manifest.save(folder + MANIFEST_FILE);
+
+		DEVIOUS_EVENT("Packed " << frames.size() << " frames of " << sprites.size() << " sprites into " << atlasFiles.size() << " atlas(es).");
+	}
+
+	for (SDL_Surface* surface : surfaces)
+	{
+		SDL_FreeSurface(surface);
+	}
+
+	return bSucceeded;
+}
+
+const uint32_t Graphics::AtlasPacker::place_frames(std::vector<Frame*>& _frames)
+{
+	//Tallest first keeps the shelves from wasting space above the shorter frames, the frames of a sprite stay together.
+	std::stable_sort(_frames.begin(), _frames.end(), [](const Frame* _lhs, const Frame* _rhs)
+	{
+		if (_lhs->source.h != _rhs->source.h)
+			return _lhs->source.h > _rhs->source.h;
+
+		return _lhs->sprite < _rhs->sprite;
+	});
+
+	uint32_t atlas = 0;
+	Shelves  shelves;
+
+	for (auto begin = _frames.begin(); begin != _frames.end();)
+	{
+		auto end = std::find_if(begin, _frames.end(), [begin](const Frame* _frame) { return _frame->sprite != (*begin)->sprite; });
+
+		//The sprite doesn't fit on what's left of the atlas, it gets a fresh one.
+		if (Shelves attempt = shelves; place_sprite(begin, end, attempt))
+		{
+			shelves = attempt;
+		}
+		else
+		{
+			atlas++;
+			shelves = {};
+
+			if (!place_sprite(begin, end, shelves))
+			{
+				DEVIOUS_ERR("A sprite with frames of " << (*begin)->source.w << "x" << (*begin)->source.h << " doesn't fit an atlas of " << ATLAS_SIZE << "x" << ATLAS_SIZE << ".");
+				return 0;
+			}
+		}
+
+		for (auto it = begin; it != end; ++it)
+		{
+			(*it)->atlas = atlas;
+		}
+
+		begin = end;
+	}
+
+	return atlas + 1;
+}
+
+const bool Graphics::AtlasPacker::place_sprite(const std::vector<Frame*>::iterator _begin, const std::vector<Frame*>::iterator _end, Shelves& _shelves)
+{
+	for (auto it = _begin; it != _end; ++it)
+	{
+		Frame* frame = *it;
+
+		if (frame->source.w > ATLAS_SIZE)
+			return false;
+
+		//Next shelf.
+		if (_shelves.cursor.x + frame->source.w > ATLAS_SIZE)
+		{
+			_shelves.cursor.x    = 0;
+			_shelves.cursor.y   += _shelves.shelfHeight + PADDING;
+			_shelves.shelfHeight = 0;
+		}
+
+		if (_shelves.cursor.y + frame->source.h > ATLAS_SIZE)
+			return false;
+
+		frame->position = _shelves.cursor;
+
+		_shelves.cursor.x   += frame->source.w + PADDING;
+		_shelves.shelfHeight = std::max(_shelves.shelfHeight, frame->source.h);
+	}
+
+	return true;
+}
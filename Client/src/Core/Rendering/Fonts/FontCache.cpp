@@ -0,0 +1,170 @@
+#include "precomp.h"
+
+#include "Core/Rendering/Fonts/FontCache.h"
+
+#include "Core/Application/Assets/AssetLoader.h"
+
+#include "Core/Global/C_Globals.h"
+
+Graphics::FontCache::FontCache(SDL_Renderer* _renderer, const std::string& _assetsPath) :
+	m_renderer(_renderer), m_assetsPath(_assetsPath)
+{
+}
+
+Graphics::FontCache::~FontCache()
+{
+	for (auto& [key, font] : m_fonts)
+	{
+		if (font.font != nullptr)
+		{
+			TTF_CloseFont(font.font);
+		}
+	}
+
+	for (Page& page : m_pages)
+	{
+		SDL_DestroyTexture(page.texture);
+	}
+}
+
+Graphics::FontCache::Font* Graphics::FontCache::get_font(const e_FontType _font, const int32_t _size)
+{
+	const uint32_t key = (static_cast<uint32_t>(_font) << 16) | static_cast<uint16_t>(_size);
+
+	if (auto it = m_fonts.find(key); it != m_fonts.end())
+	{
+		return it->second.font != nullptr ? &it->second : nullptr;
+	}
+
+	//*-----------------------------------------------------------------------
+	// Opened from the copy the asset loader read into memory, or from disk
+	// when it didn't get to it yet. A font that fails to open isn't retried.
+	//*
+	Font& font = m_fonts[key];
+
+	std::shared_ptr<AssetLoader> assetLoader = g_globals.assetLoader.lock();
+	font.data = assetLoader != nullptr ? assetLoader->get_font_data(_font) : nullptr;
+
+	if (font.data != nullptr)
+	{
+		font.font = TTF_OpenFontRW(SDL_RWFromConstMem(font.data->data(), static_cast<int32_t>(font.data->size())), 1, _size);
+	}
+	else
+	{
+		const std::string path = m_assetsPath + "/fonts/" + Fonts::FontMap().at(_font);
+		font.font = TTF_OpenFont(path.c_str(), _size);
+	}
+
+	if (font.font == nullptr)
+	{
+		DEVIOUS_ERR("Failed to open font at size " << _size << ": " << TTF_GetError());
+		return nullptr;
+	}
+
+	font.height = TTF_FontHeight(font.font);
+	return &font;
+}
+
+const Graphics::FontCache::Glyph& Graphics::FontCache::get_glyph(Font& _font, const uint32_t _codepoint)
+{
+	if (auto it = _font.glyphs.find(_codepoint); it != _font.glyphs.end())
+		return it->second;
+
+	Glyph& glyph = _font.glyphs[_codepoint];
+
+	int32_t advance = 0;
+	TTF_GlyphMetrics32(_font.font, _codepoint, nullptr, nullptr, nullptr, nullptr, &advance);
+	glyph.advance = advance;
+
+	//Solid keeps the crisp pixel font look the text had before.
+	SDL_Surface* rendered = TTF_RenderGlyph32_Solid(_font.font, _codepoint, SDL_Color{ 255, 255, 255, 255 });
+
+	//Whitespace has nothing to rasterize.
+	if (rendered == nullptr)
+		return glyph;
+
+	//The color key of the solid surface turns into transparent pixels.
+	SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(rendered);
+
+	if (surface == nullptr)
+		return glyph;
+
+	if (Page* page = reserve(Utilities::ivec2(surface->w, surface->h), glyph.region); page != nullptr)
+	{
+		SDL_UpdateTexture(page->texture, &glyph.region, surface->pixels, surface->pitch);
+		glyph.texture = page->texture;
+	}
+	else
+	{
+		DEVIOUS_WARN("Glyph " << _codepoint << " doesn't fit on a font atlas page.");
+	}
+
+	SDL_FreeSurface(surface);
+	return glyph;
+}
+
+const int32_t Graphics::FontCache::get_kerning(const Font& _font, const uint32_t _previous, const uint32_t _codepoint) const
+{
+	return TTF_GetFontKerningSizeGlyphs32(_font.font, _previous, _codepoint);
+}
+
+Graphics::FontCache::Page* Graphics::FontCache::reserve(const Utilities::ivec2& _size, SDL_Rect& _region)
+{
+	if (_size.x + PADDING > PAGE_SIZE || _size.y + PADDING > PAGE_SIZE)
+		return nullptr;
+
+	if (m_pages.empty() && !add_page())
+		return nullptr;
+
+	//*-----------------------------------------------------------------------
+	// Glyphs are placed on shelves, a glyph that doesn't fit on the shelf
+	// starts the next one, and a glyph that doesn't fit below the last shelf
+	// starts a new page.
+	//*
+	Page* page = &m_pages.back();
+
+	if (page->cursor.x + _size.x + PADDING > PAGE_SIZE)
+	{
+		page->cursor      = Utilities::ivec2(0, page->cursor.y + page->shelfHeight);
+		page->shelfHeight = 0;
+	}
+
+	if (page->cursor.y + _size.y + PADDING > PAGE_SIZE)
+	{
+		if (!add_page())
+			return nullptr;
+
+		page = &m_pages.back();
+	}
+
+	_region = { page->cursor.x + PADDING, page->cursor.y + PADDING, _size.x, _size.y };
+
+	page->cursor.x   += _size.x + PADDING;
+	page->shelfHeight = std::max(page->shelfHeight, _size.y + PADDING);
+
+	return page;
+}
+
+const bool Graphics::FontCache::add_page()
+{
+	SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+
+	if (texture == nullptr)
+	{
+		DEVIOUS_ERR("Failed to create a font atlas page: " << SDL_GetError());
+		return false;
+	}
+
+	//The contents of a new texture are undefined, the padding in between the glyphs has to be transparent.
+	const std::vector<uint32_t> transparent(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE, 0);
+	SDL_UpdateTexture(texture, nullptr, transparent.data(), PAGE_SIZE * sizeof(uint32_t));
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+	Page page;
+	page.texture = texture;
+	m_pages.push_back(page);
+
+	DEVIOUS_LOG("Added font atlas page " << m_pages.size() << ".");
+	return true;
+}
@@ -8,6 +8,10 @@
 
 #include "Core/Network/Client/ClientWrapper.h"
 
+#include "Core/Application/Config/Config.h"
+
+#include "Core/Rendering/Fonts/FontCache.h"
+
 #include "Shared/Utilities/UUID.hpp"
 
 #include <random>
@@ -39,6 +43,11 @@ std::shared_ptr<Camera>& Graphics::Renderer::get_camera()
 	return m_camera;
 }
 
+Graphics::FontCache& Graphics::Renderer::get_font_cache()
+{
+	return *m_fontCache;
+}
+
 Graphics::Renderer::Renderer(SDL_Window* _window, SDL_Renderer* _renderer, const std::string& _texture_path) :
 	m_window(_window), m_renderer(_renderer), m_assetsPath(_texture_path)
 {
@@ -49,6 +58,21 @@ Graphics::Renderer::Renderer(SDL_Window* _window, SDL_Renderer* _renderer, const
 	std::cout << "[SDL_Renderer] Succesfully created renderer." << std::endl;
 
 	m_camera = std::make_shared<Camera>();
+
+	//A single white pixel that gets stretched & tinted to draw solid rects.
+	const uint32_t white = 0xFFFFFFFF;
+
+	m_whiteTexture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+	SDL_UpdateTexture(m_whiteTexture, NULL, &white, sizeof(white));
+	SDL_SetTextureBlendMode(m_whiteTexture, SDL_BLENDMODE_BLEND);
+
+	const uint32_t transparent = 0x00000000;
+
+	m_placeholderTexture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+	SDL_UpdateTexture(m_placeholderTexture, NULL, &transparent, sizeof(transparent));
+	SDL_SetTextureBlendMode(m_placeholderTexture, SDL_BLENDMODE_BLEND);
+
+	m_fontCache = std::make_unique<FontCache>(m_renderer, m_assetsPath);
 }
 
 Graphics::Renderer::~Renderer()
@@ -64,175 +88,126 @@ void Graphics::Renderer::free()
 		delete m_details.second;
 	}   m_sprites.clear();
 
+	for (SDL_Texture* atlas : m_atlases)
+	{
+		SDL_DestroyTexture(atlas);
+	}   m_atlases.clear();
+
 	m_renderQueue.clear();
 
+	SDL_DestroyTexture(m_whiteTexture);
+	SDL_DestroyTexture(m_placeholderTexture);
+
+	m_fontCache.reset();
+
 	SDL_DestroyWindow(m_window);
 	SDL_DestroyRenderer(m_renderer);
 }
 
-/// <summary>
-/// Binds a sprite type to a surface.
-/// </summary>
-/// <param name="_file"></param>
-/// <param name="_spritetype"></param>
-/// <param name="_maxframecount"></param>
-void Graphics::Renderer::load_and_bind_surface(const std::string& _file, const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns)
+void Graphics::Renderer::bind_surface(SDL_Surface* _surface, const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns)
 {
-	std::string m_path = m_assetsPath;
-	m_path.append("/sprites/");
-	m_path.append(_file);
+	//Store the sprite details and lock it behind the sprite type, the pixels only have to live on in the texture.
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, _surface);
 
-	const char* asset_path = m_path.c_str();
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
 
-	DEVIOUS_ASSERT(m_sprites.find(_spritetype) == m_sprites.end());
-	SDL_Surface* surface = IMG_Load(asset_path);
+	const Utilities::ivec2 size(_surface->w, _surface->h);
+	SDL_FreeSurface(_surface);
 
-	//Check if the image got loaded correctly.
-	if (surface == nullptr)
-	{
-		fprintf(stderr, "Error loading image: %s\n", IMG_GetError());
-		DEVIOUS_ASSERT(surface == nullptr);
-	}
+	bind_details(_spritetype, new SDL_SpriteDetails(texture, size, _rows, _columns, SDL_SpriteDetails::split_frames(size, _rows, _columns), true));
+}
 
-	//Store the surface details and lock it behind the sprite type.
-	SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+void Graphics::Renderer::bind_atlas(SDL_Surface* _surface, const std::vector<AtlasManifest::Sprite>& _sprites)
+{
+	SDL_Texture* atlas = SDL_CreateTextureFromSurface(m_renderer, _surface);
+	SDL_FreeSurface(_surface);
 
-	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+	m_atlases.push_back(atlas);
 
-	m_sprites[_spritetype] = new SDL_SpriteDetails(surface, texture, _rows, _columns);
+	for (const AtlasManifest::Sprite& sprite : _sprites)
+	{
+		bind_details(sprite.type, new SDL_SpriteDetails(atlas, sprite.size, sprite.rows, sprite.columns, sprite.frames, false));
+	}
 }
 
-void Graphics::Renderer::start_frame()
+void Graphics::Renderer::bind_placeholder(const Graphics::SpriteType& _spritetype, const uint32_t& _rows, const uint32_t& _columns)
 {
-	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
-	SDL_RenderClear(m_renderer);
+	DEVIOUS_ASSERT(m_sprites.find(_spritetype) == m_sprites.end());
+
+	m_sprites[_spritetype] = new SDL_SpriteDetails(m_placeholderTexture, Utilities::ivec2(0, 0), _rows, _columns, { SDL_Rect{ 0, 0, 1, 1 } }, false, true);
 }
 
-void Graphics::Renderer::draw_rect(const Utilities::vec2 _pos, const Utilities::vec2 _size, SDL_Color _color, uint8_t _zOrder, bool _bScreenspace)
+void Graphics::Renderer::bind_details(const Graphics::SpriteType& _spritetype, SDL_SpriteDetails* _details)
 {
-	SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, 
-		static_cast<int>(_size.x),
-		static_cast<int>(_size.y)
-	);
+	const auto it = m_sprites.find(_spritetype);
 
-	//Create rect texture.
+	if (it == m_sprites.end())
 	{
-		const Utilities::ivec2 pos  = Utilities::to_ivec2(_pos);
-		const Utilities::ivec2 size = Utilities::to_ivec2(_size);
-
-		const SDL_Rect rect = 
-		{
-			0,
-			0,
-			size.x,
-			size.y
-		};
-
-		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-		SDL_SetRenderTarget(m_renderer, texture);
-		SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+		m_sprites[_spritetype] = _details;
+		return;
+	}
 
-		SDL_RenderClear(m_renderer);
+	//Only placeholders get replaced, the texture of a loaded sprite could still be queued for rendering.
+	DEVIOUS_ASSERT(it->second->is_placeholder());
 
-		SDL_SetRenderDrawColor(m_renderer, _color.r, _color.g, _color.b, _color.a);
+	delete it->second;
+	it->second = _details;
+}
 
-		SDL_RenderFillRect(m_renderer, &rect);
+const bool Graphics::Renderer::has_sprite(const SpriteType& _spritetype) const
+{
+	return m_sprites.find(_spritetype) != m_sprites.end();
+}
 
-		SDL_SetRenderTarget(m_renderer, NULL);
-	}
+const bool Graphics::Renderer::is_placeholder(const SpriteType& _spritetype) const
+{
+	const auto it = m_sprites.find(_spritetype);
+	return it != m_sprites.end() && it->second->is_placeholder();
+}
 
-	//Render flags
-	uint8_t flags = SpriteRenderData::e_SpriteRenderFlags::RENDER_DESTROY_TEXTURE_AFTER_USE;
-	if (!_bScreenspace)
-	{
-		flags |= SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE;
-	}
+void Graphics::Renderer::start_frame()
+{
+	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+	SDL_RenderClear(m_renderer);
+}
 
+void Graphics::Renderer::draw_rect(const Utilities::vec2 _pos, const Utilities::vec2 _size, SDL_Color _color, uint8_t _zOrder, bool _bScreenspace)
+{
+	//The white pixel gets stretched over the rect and tinted by the batch.
 	SpriteRenderData data;
 	data.position    = _pos;
 	data.size        = _size;
-	data.texture     = texture;
+	data.texture     = m_whiteTexture;
 	data.frame       = 0;
 	data.frameCount  = 0;
 	data.rows        = 0;
 	data.columns     = 0;
-	data.renderFlags = flags;
+	data.color       = _color;
+	data.renderFlags = _bScreenspace ? 0 : SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE;
 
 	m_renderQueue[_zOrder].push_back(std::move(data));
 }
 
 void Graphics::Renderer::draw_outline(const Utilities::vec2& _pos, const Utilities::vec2& _size, int _borderWidth, SDL_Color _color, uint8_t _zOrder, bool _bScreenspace)
 {
-	const Utilities::ivec2 size = Utilities::to_ivec2(_size);
-
-	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
-	SDL_RenderClear(m_renderer);
-
-	//Create a texture with the desired size and format
-	SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x + (2 * _borderWidth), size.y + (2 * _borderWidth));
-	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-	SDL_SetRenderTarget(m_renderer, texture);
-
-	//Set rect color
-	SDL_SetRenderDrawColor(m_renderer, _color.r, _color.g, _color.b, _color.a);
-
-	const SDL_Rect top =
-	{
-		0,
-		0,
-		size.x + 2 * _borderWidth,
-		_borderWidth
-	};
-	SDL_RenderFillRect(m_renderer, &top);
-
-	const SDL_Rect bottom =
-	{
-		0,
-		size.y + _borderWidth,
-		size.x + 2 * _borderWidth,
-		_borderWidth
-	};
-	SDL_RenderFillRect(m_renderer, &bottom);
-
-	const SDL_Rect left =
-	{
-		0,
-		_borderWidth,
-		_borderWidth,
-		size.y
-	};
-	SDL_RenderFillRect(m_renderer, &left);
-
-	const SDL_Rect right =
-	{
-		size.x + _borderWidth,
-		_borderWidth,
-		_borderWidth,
-		size.y
-	};
-	SDL_RenderFillRect(m_renderer, &right);
-
-	SDL_SetRenderTarget(m_renderer, NULL);
-
-	//Set flags
-	uint8_t flags = SpriteRenderData::e_SpriteRenderFlags::RENDER_DESTROY_TEXTURE_AFTER_USE;
-	if (!_bScreenspace)
-	{
-		flags |= SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE;
-	}
-
-	// Reset the rendering target to the default
-	SpriteRenderData data;
-	data.position    = _pos;
-	data.size        = _size;
-	data.texture	 = texture;
-	data.frameCount  = 0;
-	data.frame		 = 0;
-	data.rows		 = 0;
-	data.columns     = 0;
-	data.renderFlags = flags;
-
-	m_renderQueue[_zOrder].push_back(std::move(data));
+	//*-----------------------------------------------------------------------
+	// The border runs along the inside of the rect. Sizes are in pixels while
+	// worldspace positions are in cells, so the offsets get converted first.
+	//*
+	const float border    = static_cast<float>(_borderWidth);
+	const float pxToSpace = _bScreenspace ? 1.0f : 1.0f / static_cast<float>(GRID_CELL_PX_SIZE);
+
+	const Utilities::vec2 horizontal(_size.x, border);
+	const Utilities::vec2 vertical(border, std::max(_size.y - (2.0f * border), 0.0f));
+
+	//Top & bottom
+	draw_rect(_pos, horizontal, _color, _zOrder, _bScreenspace);
+	draw_rect(_pos + Utilities::vec2(0.0f, (_size.y - border) * pxToSpace), horizontal, _color, _zOrder, _bScreenspace);
+
+	//Left & right
+	draw_rect(_pos + Utilities::vec2(0.0f, border * pxToSpace), vertical, _color, _zOrder, _bScreenspace);
+	draw_rect(_pos + Utilities::vec2((_size.x - border) * pxToSpace, border * pxToSpace), vertical, _color, _zOrder, _bScreenspace);
 }
 
 void Graphics::Renderer::plot_texture(SpriteRenderData& _data, uint8_t _zOrder)
@@ -260,17 +235,20 @@ void Graphics::Renderer::plot_frame(const Sprite& _s, const Utilities::vec2& _po
 		flags |= SpriteRenderData::e_SpriteRenderFlags::RENDER_FLIP_SPRITE;
 	}
 
+	SDL_SpriteDetails* details = m_sprites[_s.get_sprite_type()];
+
 	SpriteRenderData renderData =
 	{
 		_pos,
 		_size,
-		m_sprites[_s.get_sprite_type()]->get_texture(),
+		details->get_texture(),
 		_s.frame,
 		_s.get_framecount(),
 		_s.m_rows,
 		_s.m_columns,
 		_s.color,
-		flags
+		flags,
+		details->get_frame(_s.frame)
 	};
 
 	m_renderQueue[_s.zRenderPriority].push_back(std::move(renderData));
@@ -290,17 +268,20 @@ void Graphics::Renderer::plot_raw_frame(const Sprite& _s, const Utilities::vec2&
 		flags = SpriteRenderData::e_SpriteRenderFlags::RENDER_FLIP_SPRITE;
 	}
 
+	SDL_SpriteDetails* details = m_sprites[_s.get_sprite_type()];
+
 	SpriteRenderData renderData =
 	{
 		_pos,
 		_size,
-		m_sprites[_s.get_sprite_type()]->get_texture(),
+		details->get_texture(),
 		_s.frame,
 		_s.get_framecount(),
 		_s.m_rows,
 		_s.m_columns,
 		_s.color,
-		flags
+		flags,
+		details->get_frame(_s.frame)
 	};
 
 	m_renderQueue[_s.zRenderPriority].push_back(std::move(renderData));
@@ -311,6 +292,31 @@ void Graphics::Renderer::get_viewport_size(int32_t* _w, int32_t* _h)
 	SDL_GetWindowSize(m_window, _w, _h);
 }
 
+const Utilities::vec2 Graphics::Renderer::screen_to_world(const Utilities::ivec2& _screenPos)
+{
+	int32_t windowSize_w, windowSize_h;
+	get_viewport_size(&windowSize_w, &windowSize_h);
+
+	const Utilities::vec2 camPos = m_camera->get_position();
+
+	return Utilities::vec2
+	(
+		(_screenPos.x + camPos.x - (windowSize_w / 2.0f)) / static_cast<float>(GRID_CELL_PX_SIZE),
+		(_screenPos.y + camPos.y - (windowSize_h / 2.0f)) / static_cast<float>(GRID_CELL_PX_SIZE)
+	);
+}
+
+const Utilities::ivec2 Graphics::Renderer::screen_to_tile(const Utilities::ivec2& _screenPos)
+{
+	const Utilities::vec2 worldPos = screen_to_world(_screenPos);
+
+	return Utilities::ivec2
+	(
+		static_cast<int32_t>(floorf(worldPos.x)),
+		static_cast<int32_t>(floorf(worldPos.y))
+	);
+}
+
 /// <summary>
 /// Renders the frame as final.
 /// </summary>
@@ -321,104 +327,240 @@ void Graphics::Renderer::end_frame()
 		return;
 	}
 
+	m_frameStats = {};
+
+	// The viewport & camera don't change while the frame is being built.
+	int32_t windowSize_w, windowSize_h;
+	{
+		get_viewport_size(&windowSize_w, &windowSize_h);
+	}
+
+	const Utilities::vec2 viewportHalfExtends(windowSize_w / 2.0f, windowSize_h / 2.0f);
+	const Utilities::vec2 camPos = m_camera->get_position();
+
 	for (auto& [zRenderOrder, queue] : m_renderQueue)
 	{
 		for (const SpriteRenderData& data : queue)
 		{
-			SDL_Rect destRect{};
+			batch_sprite(data, get_dest_rect(data, viewportHalfExtends, camPos));
+		}
+
+		flush_batches();
+
+		m_frameStats.sprites += static_cast<uint32_t>(queue.size());
+
+		queue.clear();
+	}
+
+	//Present the final frame.
+	SDL_RenderPresent(m_renderer);
+
+	update_frame_stats();
+}
+
+const SDL_FRect Graphics::Renderer::get_dest_rect(const SpriteRenderData& _data, const Utilities::vec2& _viewportHalfExtends, const Utilities::vec2& _camPos) const
+{
+	///	Check if we need to render in screen or worldspace.
+	/// Worldspace  == Relative to the camera, and exists within gridspace, defined by GRID_CELL_PX_SIZE.
+	/// Screenspace == just uses direct screen coordinates.
+	if (_data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE)
+	{
+		// Snapped to whole pixels, so neighbouring tiles don't leave seams in between them.
+		return
+		{
+			ceilf((_data.position.x * (float)GRID_CELL_PX_SIZE) - _camPos.x + _viewportHalfExtends.x),
+			ceilf((_data.position.y * (float)GRID_CELL_PX_SIZE) - _camPos.y + _viewportHalfExtends.y),
+			ceilf(_data.size.x),
+			ceilf(_data.size.y)
+		};
+	}
 
-			///	Check if we need to render in screen or worldspace.
-			/// Worldspace  == Relative to the camera, and exists within gridspace, defined by GRID_CELL_PX_SIZE.
-			/// Screenspace == just uses direct screen coordinates.
-			if (data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE)
-			{
-				// Get the viewport size.
-				int32_t windowSize_w, windowSize_h;
-				{
-					get_viewport_size(&windowSize_w, &windowSize_h);
-				}
+	const Utilities::ivec2 spritePos  = Utilities::to_ivec2(_data.position);
+	const Utilities::ivec2 spriteSize = Utilities::to_ivec2(_data.size);
 
-				const float vpWidthHalfExtends  = static_cast<float>(windowSize_w / 2.0f);
-				const float vpHeightHalfExtends = static_cast<float>(windowSize_h / 2.0f);
-				const Utilities::vec2 camPos    = m_camera->get_position();
+	return
+	{
+		static_cast<float>(spritePos.x),
+		static_cast<float>(spritePos.y),
+		static_cast<float>(spriteSize.x),
+		static_cast<float>(spriteSize.y)
+	};
+}
 
-				// Create a new rect with the given size and transformed position.
-				destRect =
-				{
-					static_cast<int32_t>(ceil((data.position.x * (float)GRID_CELL_PX_SIZE) - camPos.x + vpWidthHalfExtends)),
-					static_cast<int32_t>(ceil((data.position.y * (float)GRID_CELL_PX_SIZE) - camPos.y + vpHeightHalfExtends)),
-					static_cast<int32_t>(ceil(data.size.x)),
-					static_cast<int32_t>(ceil(data.size.y))
-				};
-			}
-			else
+void Graphics::Renderer::batch_sprite(const SpriteRenderData& _data, const SDL_FRect& _destRect)
+{
+	//*-----------------------------------------------------------------------
+	// The sprite can be drawn along with the latest batch of its texture, as
+	// long as it doesn't overlap anything that's drawn in between. Only the
+	// batches in between get tested, and only up to a limited amount of their
+	// sprites, with interleaved textures it'd otherwise test every sprite of
+	// the bucket for every sprite.
+	//*
+	Batch* batch = nullptr;
+
+	if (auto it = m_latestBatches.find(_data.texture); it != m_latestBatches.end())
+	{
+		const size_t latest = it->second;
+
+		bool   bIsOverlapping = false;
+		size_t tests          = 0;
+
+		for (size_t i = m_batchCount - 1; i > latest && !bIsOverlapping; i--)
+		{
+			const Batch& between = m_batches[i];
+
+			if (!SDL_HasIntersectionF(&between.bounds, &_destRect))
+				continue;
+
+			for (const SDL_FRect& quad : between.quads)
 			{
-				const Utilities::ivec2 spritePos  = Utilities::to_ivec2(data.position);
-				const Utilities::ivec2 spriteSize = Utilities::to_ivec2(data.size);
-				destRect =
+				if (++tests > MAX_BATCH_OVERLAP_TESTS || SDL_HasIntersectionF(&quad, &_destRect))
 				{
-					spritePos.x,
-					spritePos.y, 
-					spriteSize.x,
-					spriteSize.y 
-				};
+					bIsOverlapping = true;
+					break;
+				}
 			}
+		}
 
-			// Get texture width and height.
-			int32_t imageWidth, imageHeight;
-			SDL_QueryTexture(data.texture, NULL, NULL, &imageWidth, &imageHeight);
+		if (!bIsOverlapping)
+		{
+			batch = &m_batches[latest];
+		}
+	}
 
-			// Generate rect based on what part of the png we want our sprite to be 
-			Utilities::ivec2 spriteUV(0), spriteSize(imageWidth, imageHeight);
-			{
-				bool bIsSpriteSheet = (data.rows != 0 && data.columns != 0);
+	if (batch == nullptr)
+	{
+		m_latestBatches[_data.texture] = m_batchCount;
 
-				if (bIsSpriteSheet)
-				{
-					const uint32_t targetColumn = data.frame % data.columns;
-					const uint32_t targetRow    = data.frame / data.columns;
+		if (m_batchCount == m_batches.size())
+		{
+			m_batches.emplace_back();
+		}
 
-					spriteSize.x = imageWidth   / data.columns;
-					spriteSize.y = imageHeight  / data.rows;
-					spriteUV.x   = targetColumn * spriteSize.x;
-					spriteUV.y   = targetRow    * spriteSize.y;
-				}
-			}
+		batch = &m_batches[m_batchCount++];
+		batch->texture = _data.texture;
+		batch->bounds  = _destRect;
 
-			const SDL_Rect srcRect
-			{
-				spriteUV.x,
-				spriteUV.y,
-				spriteSize.x,
-				spriteSize.y,
-			};
-
-			///----------------------
-			/// Building of the frame
-			///
-			{
-				SDL_SetTextureColorMod(data.texture, data.color.r, data.color.g, data.color.b);
-				SDL_SetTextureAlphaMod(data.texture, data.color.a);
+		// Get texture width and height, once for every sprite of the batch.
+		int32_t imageWidth, imageHeight;
+		SDL_QueryTexture(_data.texture, NULL, NULL, &imageWidth, &imageHeight);
 
-				const SDL_RendererFlip flipFlags = (data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_FLIP_SPRITE) ? SDL_RendererFlip::SDL_FLIP_HORIZONTAL :
-																														            SDL_RendererFlip::SDL_FLIP_NONE;
-				SDL_RenderCopyEx(m_renderer, data.texture, &srcRect, &destRect, 0, NULL, flipFlags);
+		batch->textureSize = Utilities::vec2(static_cast<float>(imageWidth), static_cast<float>(imageHeight));
+	}
+	else
+	{
+		SDL_UnionFRect(&batch->bounds, &_destRect, &batch->bounds);
+	}
 
-				//Reset to default colors after copying it over to the surface.
-				SDL_SetTextureColorMod(data.texture, 255, 255, 255);
-			}
+	batch->quads.push_back(_destRect);
 
-			if (data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_DESTROY_TEXTURE_AFTER_USE)
-			{
-				SDL_DestroyTexture(data.texture);
-			}
+	// Generate rect based on what part of the png we want our sprite to be 
+	Utilities::vec2 spriteUV(0.0f, 0.0f), spriteSize = batch->textureSize;
+	{
+		bool bIsSpriteSheet = (_data.rows != 0 && _data.columns != 0);
+
+		if (_data.region.w != 0 && _data.region.h != 0)
+		{
+			spriteUV   = Utilities::vec2(static_cast<float>(_data.region.x), static_cast<float>(_data.region.y));
+			spriteSize = Utilities::vec2(static_cast<float>(_data.region.w), static_cast<float>(_data.region.h));
 		}
+		else if (bIsSpriteSheet)
+		{
+			const uint32_t targetColumn = _data.frame % _data.columns;
+			const uint32_t targetRow    = _data.frame / _data.columns;
 
-		queue.clear();
+			spriteSize.x = static_cast<float>(static_cast<uint32_t>(batch->textureSize.x) / _data.columns);
+			spriteSize.y = static_cast<float>(static_cast<uint32_t>(batch->textureSize.y) / _data.rows);
+			spriteUV.x   = targetColumn * spriteSize.x;
+			spriteUV.y   = targetRow    * spriteSize.y;
+		}
 	}
 
-	//Present the final frame.
-	SDL_RenderPresent(m_renderer);
+	float u0 = spriteUV.x / batch->textureSize.x;
+	float u1 = (spriteUV.x + spriteSize.x) / batch->textureSize.x;
+
+	const float v0 = spriteUV.y / batch->textureSize.y;
+	const float v1 = (spriteUV.y + spriteSize.y) / batch->textureSize.y;
+
+	if (_data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_FLIP_SPRITE)
+	{
+		std::swap(u0, u1);
+	}
+
+	///----------------------
+	/// Building of the quad, the color of the sprite tints every corner.
+	///
+	const int first = static_cast<int>(batch->vertices.size());
+
+	const float x0 = _destRect.x;
+	const float y0 = _destRect.y;
+	const float x1 = _destRect.x + _destRect.w;
+	const float y1 = _destRect.y + _destRect.h;
+
+	batch->vertices.push_back({ { x0, y0 }, _data.color, { u0, v0 } });
+	batch->vertices.push_back({ { x1, y0 }, _data.color, { u1, v0 } });
+	batch->vertices.push_back({ { x1, y1 }, _data.color, { u1, v1 } });
+	batch->vertices.push_back({ { x0, y1 }, _data.color, { u0, v1 } });
+
+	batch->indices.insert(batch->indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+
+	if (_data.renderFlags & SpriteRenderData::e_SpriteRenderFlags::RENDER_DESTROY_TEXTURE_AFTER_USE)
+	{
+		m_texturesToDestroy.push_back(_data.texture);
+	}
+}
+
+void Graphics::Renderer::flush_batches()
+{
+	for (size_t i = 0; i < m_batchCount; i++)
+	{
+		Batch& batch = m_batches[i];
+
+		SDL_RenderGeometry(m_renderer, batch.texture,
+			batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+			batch.indices.data(),  static_cast<int>(batch.indices.size())
+		);
+
+		//Keeps the capacity around for the next bucket.
+		batch.texture = nullptr;
+		batch.vertices.clear();
+		batch.indices.clear();
+		batch.quads.clear();
+	}
+
+	m_frameStats.drawCalls += static_cast<uint32_t>(m_batchCount);
+	m_batchCount = 0;
+	m_latestBatches.clear();
+
+	for (SDL_Texture* texture : m_texturesToDestroy)
+	{
+		SDL_DestroyTexture(texture);
+	}   m_texturesToDestroy.clear();
+}
+
+void Graphics::Renderer::update_frame_stats()
+{
+	m_statsElapsed   += DM::CLIENT::Config::get_deltaTime();
+	m_statsFrames    += 1;
+	m_statsDrawCalls += m_frameStats.drawCalls;
+	m_statsSprites   += m_frameStats.sprites;
+
+	if (m_statsElapsed < FRAME_STATS_INTERVAL)
+		return;
+
+	DEVIOUS_LOG("Frame time: " << (m_statsElapsed * 1000.0f) / m_statsFrames << "ms, "
+		<< m_statsDrawCalls / m_statsFrames << " draw calls for "
+		<< m_statsSprites / m_statsFrames << " sprites per frame.");
+
+	m_statsElapsed   = 0.0f;
+	m_statsFrames    = 0;
+	m_statsDrawCalls = 0;
+	m_statsSprites   = 0;
+}
+
+const Graphics::Renderer::FrameStats& Graphics::Renderer::get_frame_stats() const
+{
+	return m_frameStats;
 }
 
 Graphics::Sprite Graphics::Renderer::get_sprite(const SpriteType& _spriteType)
@@ -450,7 +592,7 @@ Graphics::Sprite Graphics::Renderer::get_sprite(const SpriteType& _spriteType)
 	sprite.frame         = 0;
 	sprite.m_frameCount  = details->get_framecount();
 	sprite.m_eSpriteType = _spriteType;
-	sprite.m_dimension   = Utilities::vec2((float)details->get_surface()->w, (float)details->get_surface()->h);
+	sprite.m_dimension   = Utilities::to_vec2(details->get_size());
 	sprite.bIsFlipped    = false;
 	sprite.m_rows        = details->get_rows();
 	sprite.m_columns     = details->get_columns();
@@ -458,16 +600,19 @@ Graphics::Sprite Graphics::Renderer::get_sprite(const SpriteType& _spriteType)
 	return sprite;
 }
 
-Graphics::Renderer::SDL_SpriteDetails::SDL_SpriteDetails(SDL_Surface* _surface, SDL_Texture* _texture, const uint32_t& _rows, const uint32_t& _columns)
-	: m_surface(_surface), m_texture(_texture), m_Rows(_rows), m_Columns(_columns)
+Graphics::Renderer::SDL_SpriteDetails::SDL_SpriteDetails(SDL_Texture* _texture, const Utilities::ivec2& _size, const uint32_t& _rows, const uint32_t& _columns, std::vector<SDL_Rect> _frames, const bool _bOwnsTexture, const bool _bIsPlaceholder)
+	: m_texture(_texture), m_size(_size), m_Rows(_rows), m_Columns(_columns), m_frames(std::move(_frames)), m_bOwnsTexture(_bOwnsTexture), m_bIsPlaceholder(_bIsPlaceholder)
 {
 	m_framecount = m_Rows * m_Columns;
 }
 
 Graphics::Renderer::SDL_SpriteDetails::~SDL_SpriteDetails()
 {
-	SDL_DestroyTexture(m_texture);
-	SDL_FreeSurface(m_surface);
+	//Atlases are shared, the renderer cleans those up.
+	if (m_bOwnsTexture)
+	{
+		SDL_DestroyTexture(m_texture);
+	}
 }
 
 const uint32_t& Graphics::Renderer::SDL_SpriteDetails::get_framecount() const
@@ -475,9 +620,9 @@ const uint32_t& Graphics::Renderer::SDL_SpriteDetails::get_framecount() const
 	return m_framecount;
 }
 
-SDL_Surface* Graphics::Renderer::SDL_SpriteDetails::get_surface() const
+const Utilities::ivec2& Graphics::Renderer::SDL_SpriteDetails::get_size() const
 {
-	return m_surface;
+	return m_size;
 }
 
 SDL_Texture* Graphics::Renderer::SDL_SpriteDetails::get_texture()
@@ -485,4 +630,29 @@ SDL_Texture* Graphics::Renderer::SDL_SpriteDetails::get_texture()
 	return m_texture;
 }
 
+const SDL_Rect& Graphics::Renderer::SDL_SpriteDetails::get_frame(const uint32_t _frame) const
+{
+	return m_frames[_frame % m_frames.size()];
+}
+
+std::vector<SDL_Rect> Graphics::Renderer::SDL_SpriteDetails::split_frames(const Utilities::ivec2& _size, const uint32_t _rows, const uint32_t _columns)
+{
+	if (_rows == 0 || _columns == 0)
+		return { SDL_Rect{ 0, 0, _size.x, _size.y } };
+
+	const int32_t frameWidth  = _size.x / static_cast<int32_t>(_columns);
+	const int32_t frameHeight = _size.y / static_cast<int32_t>(_rows);
+
+	std::vector<SDL_Rect> frames;
+	frames.reserve(static_cast<size_t>(_rows) * _columns);
 
+	for (uint32_t row = 0; row < _rows; row++)
+	{
+		for (uint32_t column = 0; column < _columns; column++)
+		{
+			frames.push_back({ static_cast<int32_t>(column) * frameWidth, static_cast<int32_t>(row) * frameHeight, frameWidth, frameHeight });
+		}
+	}
+
+	return frames;
+}
@@ -34,11 +34,18 @@ void Graphics::UI::EntityLayer::init()
 		(
 			std::bind(&EntityLayer::player_local_assigned, this, std::placeholders::_1)
 		);
+
+		m_entityHandler->on_local_player_removed.add_listener
+		(
+			std::bind(&EntityLayer::player_local_removed, this, std::placeholders::_1)
+		);
 	}
 }
 
 void Graphics::UI::EntityLayer::update()
 {
+	update_buckets();
+
 	for (const auto& [uuid, entity] : m_entityHandler->m_worldEntities)
 	{
 		if (entity->is_visible())
@@ -66,10 +73,35 @@ void Graphics::UI::EntityLayer::update()
 
 bool Graphics::UI::EntityLayer::handle_event(const SDL_Event* _event)
 {
-	for (const auto& worldEntity : m_entityHandler->m_worldEntities)
+	//Entities only respond to the mouse.
+	if (_event->type != SDL_MOUSEMOTION && _event->type != SDL_MOUSEBUTTONDOWN)
+		return false;
+
+	const Utilities::ivec2 mouse = _event->type == SDL_MOUSEMOTION
+		? Utilities::ivec2(_event->motion.x, _event->motion.y)
+		: Utilities::ivec2(_event->button.x, _event->button.y);
+
+	std::vector<RefEntity> entities;
+
+	if (auto it = m_entityBuckets.find(to_bucket_key(m_renderer->screen_to_tile(mouse))); it != m_entityBuckets.end())
+	{
+		entities = it->second;
+	}
+
+	for (const std::weak_ptr<WorldEntity>& mouseEntity : m_mouseEntities)
+	{
+		RefEntity entity = mouseEntity.lock();
+
+		if (entity != nullptr && std::find(entities.begin(), entities.end(), entity) == entities.end())
+		{
+			entities.push_back(entity);
+		}
+	}
+
+	m_mouseEntities.assign(entities.begin(), entities.end());
+
+	for (const RefEntity& entity : entities)
 	{
-		const RefEntity entity = worldEntity.second;
-		
 		if(entity->handle_event(_event)) 
 		{
 			return true;
@@ -79,7 +111,48 @@ bool Graphics::UI::EntityLayer::handle_event(const SDL_Event* _event)
 	return false;
 }
 
+void Graphics::UI::EntityLayer::update_buckets()
+{
+	//Tiles nobody stood on last frame are let go of, the others keep their memory around.
+	for (auto it = m_entityBuckets.begin(); it != m_entityBuckets.end();)
+	{
+		if (it->second.empty())
+		{
+			it = m_entityBuckets.erase(it);
+			continue;
+		}
+
+		it->second.clear();
+		++it;
+	}
+
+	for (const auto& [uuid, entity] : m_entityHandler->m_worldEntities)
+	{
+		//Same area the entity can be clicked on, it covers every tile it's partly on while it's walking.
+		const Utilities::vec2 min = entity->get_simulated_data().get_position();
+		const Utilities::vec2 max = min + entity->get_size() / static_cast<float>(Renderer::GRID_CELL_PX_SIZE);
+
+		for (int32_t y = static_cast<int32_t>(floorf(min.y)); y < static_cast<int32_t>(ceilf(max.y)); y++)
+		{
+			for (int32_t x = static_cast<int32_t>(floorf(min.x)); x < static_cast<int32_t>(ceilf(max.x)); x++)
+			{
+				m_entityBuckets[to_bucket_key(Utilities::ivec2(x, y))].push_back(entity);
+			}
+		}
+	}
+}
+
+const uint64_t Graphics::UI::EntityLayer::to_bucket_key(const Utilities::ivec2& _tile)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(_tile.x)) << 32) | static_cast<uint32_t>(_tile.y);
+}
+
 void Graphics::UI::EntityLayer::player_local_assigned(uint64_t _playerId)
 {
 	m_bHasLocalPlayer = true;
 }
+
+void Graphics::UI::EntityLayer::player_local_removed(uint64_t _playerId)
+{
+	m_bHasLocalPlayer = false;
+}
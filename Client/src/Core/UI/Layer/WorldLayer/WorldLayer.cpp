@@ -10,44 +10,135 @@
 
 void Graphics::UI::WorldLayer::init()
 {
-	//TODO: Data should later get loaded in chunks, size & stuff should get rendered relative to the camera.
+	//TODO: Data should later get loaded in chunks from the server.
 	const std::shared_ptr<Graphics::Renderer>& renderer = g_globals.renderer.lock();
 
-	const Utilities::vec2 WORLD_SIZE{ 100, 100 };
+	m_palette.clear();
+	m_palette.push_back(renderer->get_sprite(SpriteType::NONE));
+	m_palette.push_back(renderer->get_sprite(SpriteType::TILE_DEFAULT));
 
-	for (int32_t i = 0; i < WORLD_SIZE.x; i++)
+	constexpr TileMap::TileId DEFAULT_TILE = 1;
+
+	for (int32_t i = 0; i < WORLD_SIZE; i++)
 	{
-		for(int32_t j = 0; j < WORLD_SIZE.y; j++)
+		for(int32_t j = 0; j < WORLD_SIZE; j++)
 		{
-			m_tiles.push_back(WorldTile::create_tile
-			(
-				Utilities::vec2
-				(
-					static_cast<float>(i), 
-					static_cast<float>(j)
-				)
-			));
+			m_tileMap.set_tile(Utilities::ivec2(i, j), DEFAULT_TILE);
 		}
 	}
+
+	m_hoveredTile = WorldTile::create_tile(Utilities::vec2(0.0f, 0.0f));
 }
 
 void Graphics::UI::WorldLayer::update()
 {
-	for(const auto& tile : m_tiles) 
+	Utilities::ivec2 min, max;
+	get_visible_tiles(min, max);
+
+	const Utilities::ivec2 minChunk = TileMap::to_chunk_coords(min);
+	const Utilities::ivec2 maxChunk = TileMap::to_chunk_coords(max);
+
+	m_chunkCache.start_frame();
+
+	//*-----------------------------------------------------------------------
+	// Only the chunks within the viewport get visited. Chunks that are cached
+	// get drawn as a single quad, the others only plot their tiles that are
+	// on screen until the cache got around to building them.
+	//*
+	for (int32_t chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++)
+	{
+		for (int32_t chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			const Utilities::ivec2 chunkCoords(chunkX, chunkY);
+			const TileMap::Chunk* chunk = m_tileMap.get_chunk(chunkCoords);
+
+			if (chunk == nullptr)
+				continue;
+
+			const Utilities::ivec2 origin(chunkX * TileMap::CHUNK_SIZE, chunkY * TileMap::CHUNK_SIZE);
+
+			if (SDL_Texture* texture = m_chunkCache.get_texture(chunkCoords, *chunk, m_palette); texture != nullptr)
+			{
+				SpriteRenderData data;
+				data.position    = Utilities::vec2(static_cast<float>(origin.x), static_cast<float>(origin.y));
+				data.size        = Utilities::vec2(static_cast<float>(ChunkCache::CHUNK_PX_SIZE));
+				data.texture     = texture;
+				data.renderFlags = SpriteRenderData::e_SpriteRenderFlags::RENDER_WORLDSPACE;
+
+				//Terrain sits at the bottom, just like the tiles themselves.
+				m_renderer->plot_texture(data, 0);
+				continue;
+			}
+
+			plot_tiles(*chunk, origin, min, max);
+		}
+	}
+}
+
+void Graphics::UI::WorldLayer::plot_tiles(const TileMap::Chunk& _chunk, const Utilities::ivec2& _origin, const Utilities::ivec2& _min, const Utilities::ivec2& _max)
+{
+	const Utilities::vec2 tileSize(static_cast<float>(Renderer::GRID_CELL_PX_SIZE));
+
+	const int32_t startX = std::max(_min.x - _origin.x, 0);
+	const int32_t startY = std::max(_min.y - _origin.y, 0);
+	const int32_t endX   = std::min(_max.x - _origin.x, TileMap::CHUNK_SIZE - 1);
+	const int32_t endY   = std::min(_max.y - _origin.y, TileMap::CHUNK_SIZE - 1);
+
+	for (int32_t y = startY; y <= endY; y++)
 	{
-		m_renderer->plot_frame(tile->get_sprite(), tile->get_position(), tile->get_size());
+		for (int32_t x = startX; x <= endX; x++)
+		{
+			const TileMap::TileId tile = _chunk.get_tile(Utilities::ivec2(x, y));
+
+			if (tile == TileMap::EMPTY_TILE || tile >= m_palette.size())
+				continue;
+
+			const Utilities::vec2 position
+			(
+				static_cast<float>(_origin.x + x),
+				static_cast<float>(_origin.y + y)
+			);
+
+			m_renderer->plot_frame(m_palette[tile], position, tileSize);
+		}
 	}
 }
 
 bool Graphics::UI::WorldLayer::handle_event(const SDL_Event* _event)
 {
-	for(const auto& tile : m_tiles) 
+	//The cached chunks are render targets, their contents are gone along with the device.
+	if (_event->type == SDL_RENDER_TARGETS_RESET || _event->type == SDL_RENDER_DEVICE_RESET)
+	{
+		m_chunkCache.invalidate();
+		return false;
+	}
+
+	if (_event->type == SDL_MOUSEMOTION || _event->type == SDL_MOUSEBUTTONDOWN)
 	{
-		if(tile->handle_event(_event))
+		const Utilities::ivec2 mouse = _event->type == SDL_MOUSEMOTION
+			? Utilities::ivec2(_event->motion.x, _event->motion.y)
+			: Utilities::ivec2(_event->button.x, _event->button.y);
+
+		const Utilities::ivec2 tile = m_renderer->screen_to_tile(mouse);
+
+		//Nothing to walk to, the tile still gets the event so it stops being hovered.
+		const bool bIsWalkable = m_tileMap.get_tile(tile) != TileMap::EMPTY_TILE;
+		m_hoveredTile->set_walkable(bIsWalkable);
+
+		if (bIsWalkable)
 		{
-			return true;
+			m_hoveredTile->set_position(Utilities::vec2(static_cast<float>(tile.x), static_cast<float>(tile.y)));
 		}
 	}
 
-	return false;
+	return m_hoveredTile->handle_event(_event);
+}
+
+void Graphics::UI::WorldLayer::get_visible_tiles(Utilities::ivec2& _min, Utilities::ivec2& _max) const
+{
+	int32_t viewportWidth, viewportHeight;
+	m_renderer->get_viewport_size(&viewportWidth, &viewportHeight);
+
+	_min = m_renderer->screen_to_tile(Utilities::ivec2(0, 0));
+	_max = m_renderer->screen_to_tile(Utilities::ivec2(viewportWidth, viewportHeight));
 }
@@ -138,7 +138,7 @@ void Chatbox::send_message()
     g_globals.packetHandler.lock()->send_packet<Packets::s_Message>
     (
         &packet,
-        0, 
+        CHANNEL_CHAT,
         ENET_PACKET_FLAG_RELIABLE
     );
 }
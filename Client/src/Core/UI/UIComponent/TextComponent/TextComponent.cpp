@@ -6,10 +6,6 @@
 
 #include "Core/Global/C_Globals.h"
 
-#include <sstream>
-
-#include <iomanip>
-
 using namespace Graphics;
 
 std::shared_ptr<TextComponent> TextComponent::create_text(std::string _contents, Utilities::vec2 _pos, const TextArgs _args)
@@ -34,170 +30,137 @@ TextComponent::~TextComponent()
 	clean();
 }
 
-std::vector<Graphics::TextComponent::TextSegment> Graphics::TextComponent::split_text_to_segments(const std::string& _contents) const
+void Graphics::TextComponent::split_text_to_segments(const std::string_view _contents, SDL_Color _color, std::vector<TextSegment>& _segments)
 {
-	std::vector<TextSegment> textSegments;
-	std::istringstream sstream(_contents);
+	_segments.clear();
 
-	char ch;
-	std::string currentText;
-	SDL_Color currentColor = m_textArgs.color;
+	size_t textStart = 0;
+	size_t position  = _contents.find('<');
 
-	while (sstream >> std::noskipws >> ch)
+	//*----------------------------------------------------------------------
+	// Every code starts with a '<', the text in between two codes is never
+	// looked at more than once.
+	//*
+	while (position != std::string_view::npos)
 	{
-		currentText += ch;
+		const std::string_view remaining = _contents.substr(position);
+
+		SDL_Color color = _color;
+		int32_t   iconId = -1;
 
-		//*----------------------------------
-		// If a icon code is being typed out.
-		//*
-		const size_t iconStart = currentText.find("<icon=");
-		size_t iconEnd = -1;
+		size_t codeLength = parse_color_code(remaining, color);
 
-		if (iconStart != std::string::npos)
+		if (codeLength == 0)
 		{
-			if (currentText.size() >= iconStart + 7)
-			{
-				iconEnd = currentText.find(">");
-
-				if (iconEnd != std::string::npos)
-				{
-					//If the icon end character is after icon start
-					//It msut be valid.
-					if (iconEnd > iconStart)
-					{
-						std::string iconCode = currentText.substr(iconStart, iconEnd - iconStart + 1);
-
-						//Segment the first part before the code first.
-						if(iconStart > 0) 
-						{
-							textSegments.push_back({ currentText.substr(0, iconStart), currentColor });
-						}
-
-						textSegments.push_back({ iconCode, currentColor });
-						currentText.clear();
-						continue;
-					}
-				}
-			}
+			codeLength = parse_icon_code(remaining, iconId);
 		}
 
-		//*---------------------------------
-		//If a color code is being typed out.
-		//
-		const size_t colCodeLoc = currentText.find("<col=#");
-		if(colCodeLoc != std::string::npos) 
+		if (codeLength == 0)
 		{
-			if(currentText.size() >= colCodeLoc + 12) 
-			{
-				if(currentText[colCodeLoc + 12] == '>') 
-				{
-					std::string colCode = currentText.substr(colCodeLoc + 6 , 6);
-					
-					SDL_Color tempColor;
-
-					if(parse_hex_to_color(colCode, tempColor))
-					{
-						currentText.erase(colCodeLoc, 13);
-						
-						textSegments.push_back({ currentText, currentColor });
-
-						currentText.clear();
-
-						currentColor = tempColor;
-					}
-				}
-			}
+			position = _contents.find('<', position + 1);
+			continue;
+		}
+
+		if (position > textStart)
+		{
+			_segments.push_back({ _contents.substr(textStart, position - textStart), _color });
+		}
+
+		if (iconId != -1)
+		{
+			_segments.push_back({ remaining.substr(0, codeLength), _color, iconId });
 		}
+
+		_color    = color;
+		textStart = position + codeLength;
+		position  = _contents.find('<', textStart);
+	}
+
+	if (textStart < _contents.size())
+	{
+		_segments.push_back({ _contents.substr(textStart), _color });
 	}
+}
+
+const size_t Graphics::TextComponent::parse_color_code(const std::string_view _text, SDL_Color& _color)
+{
+	constexpr std::string_view prefix = "<col=#";
+	constexpr size_t length = prefix.size() + 7;
 
-	textSegments.push_back({ currentText, currentColor });
+	if (_text.size() < length || _text.compare(0, prefix.size(), prefix) != 0 || _text[length - 1] != '>')
+		return 0;
 
-	return textSegments;
+	return parse_hex_to_color(_text.substr(prefix.size(), 6), _color) ? length : 0;
 }
 
-bool Graphics::TextComponent::parse_hex_to_color(const std::string& _string, SDL_Color& _color)
+const size_t Graphics::TextComponent::parse_icon_code(const std::string_view _text, int32_t& _iconId)
 {
-	for (char c : _string)
-	{
-		//*--------------------------------------
-		// If it's a valid hexadecimal character.
-		//*
-		if (!std::isxdigit(c))
-		{
-			return false;
-		}
-	}
+	constexpr std::string_view prefix = "<icon=";
 
-	//*----------------------
-	// Convert hex to integer
-	//*
-	std::istringstream iss(_string);
-	uint32_t rgb;
-	iss >> std::hex >> rgb;
+	if (_text.compare(0, prefix.size(), prefix) != 0)
+		return 0;
+
+	//Icon ids are small, anything longer than a few digits is no icon.
+	constexpr size_t MAX_DIGITS = 4;
 
-	if (iss.fail())
+	uint32_t iconId = 0;
+	size_t   index  = prefix.size();
+
+	while (index < _text.size() && index - prefix.size() < MAX_DIGITS && _text[index] >= '0' && _text[index] <= '9')
 	{
-		return false;
+		iconId = iconId * 10 + static_cast<uint32_t>(_text[index] - '0');
+		index++;
 	}
 
-	_color.r = (rgb >> 16) & 0xFF;
-	_color.g = (rgb >> 8)  & 0xFF;
-	_color.b = rgb         & 0xFF;
+	if (index == prefix.size() || index >= _text.size() || _text[index] != '>' || iconId >= ICON_COUNT)
+		return 0;
 
-	return true;
+	_iconId = static_cast<int32_t>(iconId);
+	return index + 1;
 }
 
-bool Graphics::TextComponent::is_icon(const std::string& _contents, int32_t& _iconId)
+const bool Graphics::TextComponent::parse_hex_to_color(const std::string_view _hex, SDL_Color& _color)
 {
-	const size_t iconStart = _contents.find("<icon=");
-	size_t iconEnd = -1;
+	if (_hex.size() != 6)
+		return false;
 
-	if (iconStart != std::string::npos)
+	uint32_t rgb = 0;
+
+	for (const char c : _hex)
 	{
-		if (_contents.size() >= iconStart + 7)
-		{
-			iconEnd = _contents.find(">");
+		uint32_t digit = 0;
 
-			if (iconEnd != std::string::npos)
-			{
-				//If the icon end character is after icon start
-				//It must be valid.
-				if (iconEnd > iconStart)
-				{
-					std::string iconCode = _contents.substr(iconStart + 6, (iconEnd - (iconStart + 6)));
-
-					try
-					{
-						int32_t iconId = std::stoi(iconCode);
-
-						if(iconId > -1 && iconId < ICON_COUNT)
-						{
-							_iconId = iconId;
-							return true;
-						}
-
-					}
-					catch (std::invalid_argument& e)
-					{
-						DEVIOUS_ERR("Error occured: " << e.what());
-						return false;
-					}
-					catch (std::out_of_range& e)
-					{
-						DEVIOUS_ERR("Error occured: " << e.what());
-						return false;
-					}
-				}
-			}
+		if (c >= '0' && c <= '9')
+		{
+			digit = static_cast<uint32_t>(c - '0');
+		}
+		else if (c >= 'a' && c <= 'f')
+		{
+			digit = static_cast<uint32_t>(c - 'a' + 10);
 		}
+		else if (c >= 'A' && c <= 'F')
+		{
+			digit = static_cast<uint32_t>(c - 'A' + 10);
+		}
+		else
+		{
+			return false;
+		}
+
+		rgb = (rgb << 4) | digit;
 	}
 
-	return false;
+	_color.r = (rgb >> 16) & 0xFF;
+	_color.g = (rgb >> 8)  & 0xFF;
+	_color.b = rgb         & 0xFF;
+
+	return true;
 }
 
 void Graphics::TextComponent::clean()
 {
-	m_textTextures.clear();
+	m_glyphs.clear();
+	m_icons.clear();
 }
 
 void Graphics::TextComponent::set_text(std::string _contents)
@@ -227,230 +190,158 @@ void Graphics::TextComponent::on_new_parent()
 
 void Graphics::TextComponent::rebuild_text()
 {
+	clean();
+
 	//*-------------------------------------------
 	//Check first if there's any text to be built.
 	//
-	if (m_textArgs.size > 0 && !m_contents.empty())
-	{
-		if (m_textTextures.size() > 0)
-		{
-			clean();
-		}
+	if (m_textArgs.size <= 0 || m_contents.empty())
+		return;
 
-		std::shared_ptr<Graphics::Renderer> renderer = g_globals.renderer.lock();
+	std::shared_ptr<Graphics::Renderer> renderer = g_globals.renderer.lock();
 
-		//Reconstruct fontpath.
-		{
-			m_fontPath = renderer->m_assetsPath;
-			m_fontPath.append("/fonts/");
-			m_fontPath.append(Fonts::FontMap().at(m_textArgs.font));
-		}
+	FontCache::Font* font = renderer->get_font_cache().get_font(m_textArgs.font, m_textArgs.size);
 
-		//*------------------------------------------------------
-		// Load font, generate textures and close font afterwards
-		//
-		m_font = TTF_OpenFont(m_fontPath.c_str(), m_textArgs.size);
+	if (font == nullptr)
+		return;
 
-		if (m_font)
-		{
-			int32_t fontHeight = TTF_FontHeight(m_font);
-			m_iconRenderSize = Utilities::vec2(static_cast<float>(fontHeight));
+	m_iconRenderSize = Utilities::vec2(static_cast<float>(font->height));
 
-			DEVIOUS_ASSERT(m_font != NULL);
-			generate_text_textures();
+	//*------------------------------------------------------
+	// Lay the glyphs & icons of every segment out on a single
+	// line, the pen is kept in pixels.
+	//*
+	float penX = 0.0f;
 
-			TTF_CloseFont(m_font);
-		}
+	//Text only gets rebuilt on the main thread, every component shares the buffer.
+	static std::vector<TextSegment> segments;
+	split_text_to_segments(m_contents, m_textArgs.color, segments);
 
-		//*------------------------------------------------------
-		// Resize the text element incorporating all the textures.
-		// And determine position of each segment.
-		//*
+	for (const TextSegment& segment : segments)
+	{
+		if (segment.icon != -1)
 		{
-			Utilities::vec2 newSize = { 0.0f };
-			Utilities::ivec2 textureDimensions{ 0 };
-			for (int32_t i = 0; i < m_textTextures.size(); i++)
-			{
-				auto& query = m_textTextures[i];
-
-				if (!query->bIsIcon)
-				{
-					SDL_QueryTexture(query->tex, NULL, NULL, &textureDimensions.x, &textureDimensions.y);
-					newSize.x += static_cast<float>(textureDimensions.x);
-					newSize.y = std::max(newSize.y, static_cast<float>(textureDimensions.y));
-				}
-				else
-				{
-					newSize.x += m_iconRenderSize.x;
-					newSize.y = std::max(newSize.y, m_iconRenderSize.y);
-				}
-			}
+			IconQuad& quad = m_icons.emplace_back();
+			quad.icon = renderer->get_sprite(static_cast<Graphics::SpriteType>(segment.icon));
+			quad.icon.zRenderPriority = m_sprite.zRenderPriority;
+			quad.renderPosOffset = to_render_offset(penX);
 
-			set_size(newSize);
+			penX += m_iconRenderSize.x;
+			continue;
 		}
 
-		//*------------------------------------------------------
-		// Calculate what the render positions should be for the textures.
-		//*
-		{
-			Utilities::vec2 offset(0.0f);
+		layout_glyphs(*font, segment.text, segment.color, penX);
+	}
 
-			for (int32_t i = 0; i < m_textTextures.size(); i++)
-			{
-				auto& query = m_textTextures[i];
-				query->renderPosOffset = offset;
+	//Icons are as tall as the font.
+	set_size(Utilities::vec2(penX, static_cast<float>(font->height)));
+}
 
-				float textureOffsetX = 0.0f;
+void Graphics::TextComponent::layout_glyphs(FontCache::Font& _font, const std::string_view _text, const SDL_Color& _color, float& _penX)
+{
+	FontCache& fontCache = g_globals.renderer.lock()->get_font_cache();
 
-				if (!query->bIsIcon)
-				{
-					Utilities::ivec2 textureDimensions{ 0 };
-					SDL_QueryTexture(query->tex, NULL, NULL, &textureDimensions.x, &textureDimensions.y);
+	uint32_t previous = 0;
 
-					textureOffsetX = static_cast<float>(textureDimensions.x);
-				}
-				else
-				{
-					textureOffsetX += m_iconRenderSize.x;
-				}
+	//The text is Latin-1, just like it was rendered before.
+	for (const char ch : _text)
+	{
+		const uint32_t codepoint = static_cast<uint8_t>(ch);
 
-				if(m_eRenderMode == e_RenderMode::WORLDSPACE) 
-				{
-					textureOffsetX /= static_cast<float>(Graphics::Renderer::GRID_CELL_PX_SIZE);
-				}
+		if (previous != 0)
+		{
+			_penX += static_cast<float>(fontCache.get_kerning(_font, previous, codepoint));
+		}
 
-				offset.x += textureOffsetX;
-			}
+		const FontCache::Glyph& glyph = fontCache.get_glyph(_font, codepoint);
+
+		if (glyph.texture != nullptr)
+		{
+			GlyphQuad& quad = m_glyphs.emplace_back();
+			quad.texture         = glyph.texture;
+			quad.region          = glyph.region;
+			quad.color           = _color;
+			quad.renderPosOffset = to_render_offset(_penX);
 		}
+
+		_penX   += static_cast<float>(glyph.advance);
+		previous = codepoint;
 	}
 }
 
-const void Graphics::TextComponent::generate_text_textures()
+const Utilities::vec2 Graphics::TextComponent::to_render_offset(const float _penX) const
 {
-	std::vector<TextSegment> segments = split_text_to_segments(m_contents);
-
-	for (auto& segment : segments) 
+	if (m_eRenderMode == e_RenderMode::WORLDSPACE)
 	{
-		create_texture(segment.text, segment.color);
+		return Utilities::vec2(_penX / static_cast<float>(Graphics::Renderer::GRID_CELL_PX_SIZE), 0.0f);
 	}
+
+	return Utilities::vec2(_penX, 0.0f);
 }
 
-void Graphics::TextComponent::create_texture(const std::string& _contents, const SDL_Color& _col)
+void TextComponent::renderText(std::shared_ptr<Graphics::Renderer> _renderer)
 {
-	if (!_contents.empty() && m_textArgs.size > 0)
-	{
-		std::shared_ptr<Graphics::Renderer> renderer = g_globals.renderer.lock();
+	const Utilities::vec2 position = get_position();
 
-		std::shared_ptr<RenderQuery> queryPtr = std::make_shared<RenderQuery>();
+	float dropShadowOffsetPx = 1.0f;
 
-		int32_t iconId = -1;
-		if (is_icon(_contents, iconId))
-		{
-			Graphics::SpriteType iconType = static_cast<Graphics::SpriteType>(iconId);
-
-			queryPtr->bIsIcon = true;
-			queryPtr->icon = renderer->get_sprite(iconType);
-			queryPtr->tex = nullptr;
-
-			queryPtr->icon.zRenderPriority = m_sprite.zRenderPriority;
+	uint8_t flags = 0;
+	if (m_eRenderMode == e_RenderMode::WORLDSPACE)
+	{
+		flags |= e_RenderMode::WORLDSPACE;
+		dropShadowOffsetPx = 1.0f / (float)Renderer::GRID_CELL_PX_SIZE;
+	}
 
-			m_textTextures.push_back(queryPtr);
-		}
-		else
+	//*------------------------------------------------------
+	// Every glyph is on the pages of the font cache, so the
+	// text (& its shadow) ends up in a single batch.
+	//*
+	if (m_textArgs.bDropShadow)
+	{
+		for (const GlyphQuad& quad : m_glyphs)
 		{
-			SDL_Surface* textSurface = TTF_RenderText_Solid(m_font, _contents.c_str(), _col);
-			DEVIOUS_ASSERT(textSurface != NULL);
-
-			SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer->m_renderer, textSurface);
-
-			Utilities::ivec2 textureDimensions{ 0 };
-			SDL_QueryTexture(texture, NULL, NULL, &textureDimensions.x, &textureDimensions.y);
-
-			DEVIOUS_ASSERT(texture != NULL);
-
-			SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-			SDL_FreeSurface(textSurface);
-
-			queryPtr->bIsIcon = false;
-			queryPtr->tex     = texture;
-			queryPtr->icon    = g_globals.renderer.lock()->get_sprite(Graphics::SpriteType::NONE);
-
-			m_textTextures.push_back(std::shared_ptr<RenderQuery>(queryPtr));
+			SpriteRenderData data{};
+			data.color = { 1, 1, 1, quad.color.a };
+			data.position = position + quad.renderPosOffset + Utilities::vec2(dropShadowOffsetPx);
+			data.size = Utilities::vec2(static_cast<float>(quad.region.w), static_cast<float>(quad.region.h));
+			data.texture = quad.texture;
+			data.region = quad.region;
+			data.renderFlags = flags;
+
+			_renderer->plot_texture(data, m_sprite.zRenderPriority);
 		}
 	}
-}
-
 
-void TextComponent::renderText(std::shared_ptr<Graphics::Renderer> _renderer)
-{
-	if (m_textTextures.size() > 0)
+	for (const GlyphQuad& quad : m_glyphs)
 	{
-		const Utilities::vec2 position = get_position();
-		const Utilities::vec2 size = get_size();
-
-		float dropShadowOffsetPx = 1.0f;
-
-		uint8_t flags = 0;
-		if (m_eRenderMode == e_RenderMode::WORLDSPACE)
-		{
-			flags |= e_RenderMode::WORLDSPACE;
-			dropShadowOffsetPx = 1.0f / (float)Renderer::GRID_CELL_PX_SIZE;
-		}
+		SpriteRenderData data{};
+		data.color = quad.color;
+		data.position = position + quad.renderPosOffset;
+		data.size = Utilities::vec2(static_cast<float>(quad.region.w), static_cast<float>(quad.region.h));
+		data.texture = quad.texture;
+		data.region = quad.region;
+		data.renderFlags = flags;
+
+		_renderer->plot_texture(data, m_sprite.zRenderPriority);
+	}
 
-		Utilities::ivec2 textureDimensions{ 0 };
+	for (const IconQuad& quad : m_icons)
+	{
+		const Utilities::vec2 iconPosition = position + quad.renderPosOffset;
 
-		for (int32_t i = 0; i < m_textTextures.size(); i++)
+		switch(m_eRenderMode) 
 		{
-			auto& query = m_textTextures[i];
-
-			Utilities::vec2  segmentPosition = position + query->renderPosOffset;
-
-			if (!query->bIsIcon)
+			case SCREENSPACE:
 			{
-				SDL_QueryTexture(query->tex, NULL, NULL, &textureDimensions.x, &textureDimensions.y);
-
-				// Render the shadow text.
-				if (m_textArgs.bDropShadow)
-				{
-					SpriteRenderData data{};
-					data.color = { 1, 1, 1, 255 };
-					data.position = segmentPosition + Utilities::vec2(dropShadowOffsetPx);
-					data.size = Utilities::to_vec2(textureDimensions);
-					data.texture = query->tex;
-					data.renderFlags = flags;
-
-					_renderer->plot_texture(data, m_sprite.zRenderPriority);
-				}
-
-				// Render the main text.
-				{
-					SpriteRenderData data{};
-					data.color = { 255, 255, 255, 255 };
-					data.position = segmentPosition;
-					data.size = Utilities::to_vec2(textureDimensions);
-					data.texture = query->tex;
-					data.renderFlags = flags;
-
-					_renderer->plot_texture(data, m_sprite.zRenderPriority);
-				}
+				_renderer->plot_raw_frame(quad.icon, iconPosition, m_iconRenderSize);
 			}
-			else 
+			break;
+
+			case WORLDSPACE:
 			{
-				switch(m_eRenderMode) 
-				{
-					case SCREENSPACE:
-					{
-						_renderer->plot_raw_frame(query->icon,segmentPosition, m_iconRenderSize);
-					}
-					break;
-
-					case WORLDSPACE:
-					{
-						_renderer->plot_frame(query->icon, segmentPosition, m_iconRenderSize);
-					}
-					break;
-				}
+				_renderer->plot_frame(quad.icon, iconPosition, m_iconRenderSize);
 			}
+			break;
 		}
 	}
 }
@@ -0,0 +1,160 @@
+#include "precomp.h"
+
+#include "Core/World/ChunkCache/ChunkCache.h"
+
+#include "Core/Global/C_Globals.h"
+
+ChunkCache::~ChunkCache()
+{
+	for (Slot& slot : m_slots)
+	{
+		SDL_DestroyTexture(slot.texture);
+	}
+}
+
+void ChunkCache::start_frame()
+{
+	m_frame++;
+	m_builds = 0;
+}
+
+SDL_Texture* ChunkCache::get_texture(const Utilities::ivec2& _chunkCoords, const TileMap::Chunk& _chunk, const std::vector<Graphics::Sprite>& _palette)
+{
+	Slot* slot = nullptr;
+
+	for (Slot& candidate : m_slots)
+	{
+		if (candidate.texture != nullptr && candidate.chunkCoords == _chunkCoords)
+		{
+			slot = &candidate;
+			break;
+		}
+	}
+
+	const bool bIsUpToDate = slot != nullptr && slot->bIsBuilt && slot->version == _chunk.version;
+
+	if (!bIsUpToDate)
+	{
+		if (m_builds >= MAX_BUILDS_PER_FRAME)
+			return nullptr;
+
+		if (slot == nullptr)
+		{
+			slot = acquire_slot();
+
+			//Every slot got drawn this frame already, more chunks are on screen than the cache holds.
+			if (slot == nullptr)
+				return nullptr;
+		}
+
+		m_builds++;
+
+		slot->chunkCoords = _chunkCoords;
+		slot->version     = _chunk.version;
+		slot->bIsBuilt    = build(*slot, _chunk, _palette);
+
+		if (!slot->bIsBuilt)
+			return nullptr;
+	}
+
+	slot->lastUsed = m_frame;
+	return slot->texture;
+}
+
+void ChunkCache::invalidate()
+{
+	for (Slot& slot : m_slots)
+	{
+		slot.bIsBuilt = false;
+	}
+}
+
+ChunkCache::Slot* ChunkCache::acquire_slot()
+{
+	if (m_slots.size() < SLOT_COUNT)
+	{
+		return &m_slots.emplace_back();
+	}
+
+	Slot& leastRecent = *std::min_element(m_slots.begin(), m_slots.end(), [](const Slot& _lhs, const Slot& _rhs)
+	{
+		return _lhs.lastUsed < _rhs.lastUsed;
+	});
+
+	//*-----------------------------------------------------------------------
+	// The texture of a slot that got used this frame is already queued to get
+	// drawn, rebuilding it before the frame ends would draw the other chunk
+	// in its place.
+	//*
+	if (leastRecent.lastUsed == m_frame)
+		return nullptr;
+
+	return &leastRecent;
+}
+
+const bool ChunkCache::build(Slot& _slot, const TileMap::Chunk& _chunk, const std::vector<Graphics::Sprite>& _palette)
+{
+	const std::shared_ptr<Graphics::Renderer> renderer = g_globals.renderer.lock();
+	SDL_Renderer* sdlRenderer = renderer->m_renderer;
+
+	//A chunk that gets built while its tiles are still loading would stay blank until it changes, it's plotted tile by tile meanwhile.
+	for (size_t tile = TileMap::EMPTY_TILE + 1; tile < _palette.size(); tile++)
+	{
+		if (renderer->is_placeholder(_palette[tile].get_sprite_type()))
+			return false;
+	}
+
+	//Evicted slots hand their texture over to the next chunk, only new slots allocate one.
+	if (_slot.texture == nullptr)
+	{
+		_slot.texture = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, CHUNK_PX_SIZE, CHUNK_PX_SIZE);
+
+		if (_slot.texture == nullptr)
+		{
+			DEVIOUS_ERR("Failed to create a chunk texture: " << SDL_GetError());
+			return false;
+		}
+
+		SDL_SetTextureBlendMode(_slot.texture, SDL_BLENDMODE_BLEND);
+	}
+
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(sdlRenderer);
+
+	SDL_SetRenderTarget(sdlRenderer, _slot.texture);
+	SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 0);
+	SDL_RenderClear(sdlRenderer);
+
+	for (int32_t y = 0; y < TileMap::CHUNK_SIZE; y++)
+	{
+		for (int32_t x = 0; x < TileMap::CHUNK_SIZE; x++)
+		{
+			const TileMap::TileId tile = _chunk.get_tile(Utilities::ivec2(x, y));
+
+			if (tile == TileMap::EMPTY_TILE || tile >= _palette.size())
+				continue;
+
+			const Graphics::Sprite& sprite = _palette[tile];
+
+			const auto it = renderer->m_sprites.find(sprite.get_sprite_type());
+
+			if (it == renderer->m_sprites.end())
+				continue;
+
+			const SDL_Rect& srcRect = it->second->get_frame(sprite.frame);
+
+			const SDL_Rect destRect =
+			{
+				x * Graphics::Renderer::GRID_CELL_PX_SIZE,
+				y * Graphics::Renderer::GRID_CELL_PX_SIZE,
+				Graphics::Renderer::GRID_CELL_PX_SIZE,
+				Graphics::Renderer::GRID_CELL_PX_SIZE
+			};
+
+			SDL_RenderCopy(sdlRenderer, it->second->get_texture(), &srcRect, &destRect);
+		}
+	}
+
+	SDL_SetRenderTarget(sdlRenderer, previousTarget);
+
+	return true;
+}
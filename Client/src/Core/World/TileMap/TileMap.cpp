@@ -0,0 +1,65 @@
+#include "precomp.h"
+
+#include "Core/World/TileMap/TileMap.h"
+
+void TileMap::set_tile(const Utilities::ivec2& _gridCoords, const TileId _tile)
+{
+	const Utilities::ivec2 localCoords = to_local_coords(_gridCoords);
+
+	Chunk& chunk = m_chunks[to_key(to_chunk_coords(_gridCoords))];
+	TileId& tile = chunk.tiles[localCoords.x + localCoords.y * CHUNK_SIZE];
+
+	if (tile != _tile)
+	{
+		tile = _tile;
+		chunk.version++;
+	}
+}
+
+const TileMap::TileId TileMap::get_tile(const Utilities::ivec2& _gridCoords) const
+{
+	const Chunk* chunk = get_chunk(to_chunk_coords(_gridCoords));
+
+	if (chunk == nullptr)
+		return EMPTY_TILE;
+
+	return chunk->get_tile(to_local_coords(_gridCoords));
+}
+
+const TileMap::Chunk* TileMap::get_chunk(const Utilities::ivec2& _chunkCoords) const
+{
+	const auto it = m_chunks.find(to_key(_chunkCoords));
+	return it != m_chunks.end() ? &it->second : nullptr;
+}
+
+void TileMap::clear()
+{
+	m_chunks.clear();
+}
+
+const Utilities::ivec2 TileMap::to_chunk_coords(const Utilities::ivec2& _gridCoords)
+{
+	//Rounds down instead of towards 0, tile -1 is part of chunk -1.
+	const auto floor_div = [](const int32_t _value)
+	{
+		return _value >= 0 ? _value / CHUNK_SIZE : ((_value + 1) / CHUNK_SIZE) - 1;
+	};
+
+	return Utilities::ivec2(floor_div(_gridCoords.x), floor_div(_gridCoords.y));
+}
+
+const Utilities::ivec2 TileMap::to_local_coords(const Utilities::ivec2& _gridCoords)
+{
+	const Utilities::ivec2 chunkCoords = to_chunk_coords(_gridCoords);
+
+	return Utilities::ivec2
+	(
+		_gridCoords.x - chunkCoords.x * CHUNK_SIZE,
+		_gridCoords.y - chunkCoords.y * CHUNK_SIZE
+	);
+}
+
+const uint64_t TileMap::to_key(const Utilities::ivec2& _chunkCoords)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(_chunkCoords.x)) << 32) | static_cast<uint32_t>(_chunkCoords.y);
+}
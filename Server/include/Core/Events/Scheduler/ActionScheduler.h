@@ -0,0 +1,67 @@
+#pragma once
+#include "Core/Events/Timer/TimingWheel.h"
+
+namespace Server
+{
+	/// <summary>
+	/// Server wide scheduler for actions that need to happen at a later game tick, e.g respawns, death transitions & delayed effects.
+	/// Systems enqueue their action once and only get called back when it's due, so anything waiting costs nothing per tick.
+	/// </summary>
+	class ActionScheduler
+	{
+	public:
+		using Action = TimingWheel::Callback;
+
+		/// <summary>
+		/// Schedule an action to get executed after the specified amount of ticks.
+		/// </summary>
+		/// <param name="_delayTicks"></param>
+		/// <param name="_action"></param>
+		/// <returns></returns>
+		TimerHandle schedule_in(const uint64_t _delayTicks, Action _action);
+
+		/// <summary>
+		/// Schedule an action to get executed at a specific tick.
+		/// Ticks that already passed will get executed next tick.
+		/// </summary>
+		/// <param name="_tick"></param>
+		/// <param name="_action"></param>
+		/// <returns></returns>
+		TimerHandle schedule_at(const uint64_t _tick, Action _action);
+
+		/// <summary>
+		/// Cancels a scheduled action and invalidates the handle.
+		/// </summary>
+		/// <param name="_handle"></param>
+		void cancel(TimerHandle& _handle);
+
+		/// <summary>
+		/// Whether the action is still waiting to get executed.
+		/// </summary>
+		/// <param name="_handle"></param>
+		/// <returns></returns>
+		const bool is_scheduled(const TimerHandle _handle) const;
+
+		/// <summary>
+		/// Returns the current game tick.
+		/// </summary>
+		/// <returns></returns>
+		const uint64_t get_current_tick() const;
+
+		/// <summary>
+		/// Moves the game a tick forward and executes all actions that are due.
+		/// Call this once at the start of every game cycle.
+		/// </summary>
+		void tick();
+
+	public:
+		ActionScheduler() = default;
+		~ActionScheduler() = default;
+
+	private:
+		ActionScheduler(ActionScheduler&) = delete;
+
+	private:
+		TimingWheel m_wheel;
+	};
+}
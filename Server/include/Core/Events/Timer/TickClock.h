@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+
+#include <chrono>
+
+namespace Server
+{
+	/// <summary>
+	/// What the clock does once the server falls behind by more than a full tick.
+	/// </summary>
+	enum class e_OverrunPolicy : uint8_t
+	{
+		CATCH_UP = 0x00, //Runs the missed ticks back to back, up to a limit, so game time keeps up with real time.
+		SKIP     = 0x01  //Drops the missed ticks and continues at the next deadline, the dropped ticks get counted.
+	};
+
+	/// <summary>
+	/// Timing statistics of the tick loop, lag is how late a tick started compared to its deadline.
+	/// </summary>
+	struct TickMetrics
+	{
+		uint64_t                 tick         = 0; //Index of the last deadline that fired, skipped deadlines count as well.
+		uint64_t                 overruns     = 0; //Amount of ticks that started more than a full period late.
+		uint64_t                 skippedTicks = 0; //Amount of deadlines that got dropped.
+		std::chrono::nanoseconds lastLag      = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds maxLag       = std::chrono::nanoseconds(0);
+	};
+
+	/// <summary>
+	/// Fixed timestep clock that places every tick on an absolute deadline, tick n is due at start + n * period.
+	/// All arithmetic is done in integer nanoseconds, so being late on one tick never shifts the ones after it.
+	/// </summary>
+	class TickClock
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/// <summary>
+		/// Upper bound of ticks that get run back to back while catching up, anything beyond that gets skipped.
+		/// </summary>
+		constexpr static uint64_t MAX_CATCH_UP_TICKS = 5;
+
+		/// <summary>
+		/// Starts counting ticks from the specified point in time, the first tick is due a period later.
+		/// </summary>
+		/// <param name="_now"></param>
+		void start(const Clock::time_point _now);
+
+		/// <summary>
+		/// Returns true when the next tick is due, and advances the clock to it.
+		/// </summary>
+		/// <param name="_now"></param>
+		/// <returns></returns>
+		const bool try_advance(const Clock::time_point _now);
+
+		/// <summary>
+		/// Returns the deadline of the upcoming tick.
+		/// </summary>
+		/// <returns></returns>
+		const Clock::time_point get_next_deadline() const;
+
+		/// <summary>
+		/// Changes the duration of a tick, the upcoming deadlines get measured from the last tick that fired.
+		/// </summary>
+		/// <param name="_period"></param>
+		void set_period(const std::chrono::nanoseconds _period);
+		const std::chrono::nanoseconds get_period() const;
+
+		void set_overrun_policy(const e_OverrunPolicy _policy);
+		const e_OverrunPolicy get_overrun_policy() const;
+
+		const TickMetrics& get_metrics() const;
+
+	public:
+		TickClock(const std::chrono::nanoseconds _period, const e_OverrunPolicy _policy = e_OverrunPolicy::CATCH_UP);
+		~TickClock() = default;
+
+	private:
+		/// <summary>
+		/// Returns the deadline of the specified tick.
+		/// </summary>
+		/// <param name="_tick"></param>
+		/// <returns></returns>
+		const Clock::time_point get_deadline(const uint64_t _tick) const;
+
+	private:
+		std::chrono::nanoseconds m_period;
+		e_OverrunPolicy          m_policy;
+
+		/// <summary>
+		/// Deadlines get measured from the origin, which only moves when the period changes.
+		/// </summary>
+		Clock::time_point        m_origin;
+		uint64_t                 m_originTick = 0;
+
+		TickMetrics              m_metrics;
+	};
+}
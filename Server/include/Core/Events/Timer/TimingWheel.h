@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+
+#include <vector>
+
+#include <array>
+
+#include <functional>
+
+namespace Server
+{
+	/// <summary>
+	/// Handle to a scheduled timer, the upper 32 bits hold the generation of the slot so stale handles can't cancel a reused slot.
+	/// </summary>
+	using TimerHandle = uint64_t;
+
+	/// <summary>
+	/// Hierarchical timing wheel measured in game ticks.
+	/// Timers get placed in a slot based on how far away their deadline is, and only get touched again when their slot comes around.
+	/// This makes the cost of advancing a tick proportional to the amount of timers that expire instead of the amount of timers that exist.
+	/// </summary>
+	class TimingWheel
+	{
+	public:
+		using Callback = std::function<void()>;
+
+		/// <summary>
+		/// Handle that never refers to a valid timer.
+		/// </summary>
+		constexpr static TimerHandle INVALID_HANDLE = 0;
+
+		/// <summary>
+		/// Amount of bits used to index the slots of a single level.
+		/// </summary>
+		constexpr static uint32_t SLOT_BITS = 6;
+
+		/// <summary>
+		/// Amount of slots within a single level of the wheel.
+		/// </summary>
+		constexpr static uint32_t SLOT_COUNT = 1 << SLOT_BITS;
+
+		/// <summary>
+		/// Amount of levels, 4 levels of 64 slots cover 16.7 million ticks (~116 days at 600ms a tick).
+		/// Timers that go beyond this range get parked in the last level and re-inserted when they come around.
+		/// </summary>
+		constexpr static uint32_t LEVEL_COUNT = 4;
+
+		/// <summary>
+		/// Schedule a callback to get invoked after the specified amount of ticks.
+		/// A delay of 0 will be treated as 1, as the current tick has already been processed.
+		/// </summary>
+		/// <param name="_delayTicks"></param>
+		/// <param name="_callback"></param>
+		/// <returns></returns>
+		TimerHandle schedule(const uint64_t _delayTicks, Callback _callback);
+
+		/// <summary>
+		/// Cancels the timer, does nothing when the timer has already fired or got cancelled before.
+		/// </summary>
+		/// <param name="_handle"></param>
+		void cancel(TimerHandle& _handle);
+
+		/// <summary>
+		/// Whether the handle still refers to a timer that's waiting to fire.
+		/// </summary>
+		/// <param name="_handle"></param>
+		/// <returns></returns>
+		const bool is_pending(const TimerHandle _handle) const;
+
+		/// <summary>
+		/// Advance the wheel by a single tick and invoke every timer that has expired.
+		/// </summary>
+		void advance();
+
+		/// <summary>
+		/// Returns the amount of ticks this wheel has advanced.
+		/// </summary>
+		/// <returns></returns>
+		const uint64_t get_current_tick() const;
+
+		/// <summary>
+		/// Returns the amount of timers that are waiting to fire.
+		/// </summary>
+		/// <returns></returns>
+		const size_t get_pending_count() const;
+
+	public:
+		TimingWheel() = default;
+		~TimingWheel() = default;
+
+	private:
+		struct Timer
+		{
+			uint64_t expiry     = 0;
+			uint32_t generation = 1;
+			bool     bIsPending = false;
+			Callback callback;
+		};
+
+		using Slot = std::vector<TimerHandle>;
+
+		/// <summary>
+		/// Places the timer in the slot matching the distance between now and its deadline.
+		/// </summary>
+		void insert(const TimerHandle _handle);
+
+		/// <summary>
+		/// Re-inserts all timers of the slot at the given level into the lower levels.
+		/// </summary>
+		void cascade(const uint32_t _level, const uint32_t _slot);
+
+		/// <summary>
+		/// Returns the timer a handle points to, or nullptr when the handle is stale.
+		/// </summary>
+		Timer* resolve(const TimerHandle _handle);
+		const Timer* resolve(const TimerHandle _handle) const;
+
+		static TimerHandle make_handle(const uint32_t _index, const uint32_t _generation);
+
+	private:
+		std::array<std::array<Slot, SLOT_COUNT>, LEVEL_COUNT> m_levels;
+
+		std::vector<Timer>    m_timers;
+		std::vector<uint32_t> m_freeList;
+
+		/// <summary>
+		/// Reused between ticks so expiring a slot doesn't allocate.
+		/// </summary>
+		Slot     m_expiring;
+
+		uint64_t m_currentTick  = 0;
+		size_t   m_pendingCount = 0;
+	};
+}
@@ -5,6 +5,8 @@
 
 #include "Shared/Utilities/vec2.hpp"
 
+#include "Core/Events/Timer/TimingWheel.h"
+
 #include <map>
 
 #include <array>
@@ -12,17 +14,35 @@
 namespace Server
 {
 	class EntityHandler;
+	class RegionGrid;
+	class ZoneLink;
 }
 
+/// <summary>
+/// Reasons for an entity to not get updated every game cycle, an entity only ticks when none apply.
+/// </summary>
+enum class e_TickSuspension : uint8_t
+{
+	NONE    = 0x00,
+
+	DEAD    = 0x01, //Waiting on a scheduled respawn.
+
+	DORMANT = 0x02  //No player is near the region the entity is in.
+};
+
 class Entity
 {
 public:
 	Utilities::ivec2     respawnLocation = Utilities::ivec2(0, 0);
 	DM::SKILLS::SkillMap skills;
 	Utilities::ivec2     position    = { 0 };
-	uint32_t             tickCounter = 0;
 	DM::Utils::UUID      uuid        = 0;
 
+	/// <summary>
+	/// Latest walk input of the client that got processed, sent along with every position so the client can reconcile its prediction.
+	/// </summary>
+	uint32_t             inputSequence = 0;
+
 
 	/// <summary>
 	/// Hit the entity for a specified amount.
@@ -37,9 +57,22 @@ public:
 
 	/// <summary>
 	/// Non overridable fixed update that happens every cycle.
+	/// Dead entities don't get updated, their respawn is scheduled instead.
 	/// </summary>
 	void update();
 
+	/// <summary>
+	/// Whether the attack delay of the entity has passed.
+	/// </summary>
+	/// <returns></returns>
+	const bool can_attack() const;
+
+	/// <summary>
+	/// Prevents the entity from attacking for the specified amount of ticks.
+	/// </summary>
+	/// <param name="_ticks"></param>
+	void set_attack_delay(const int32_t _ticks);
+
 	/// <summary>
 	/// Updates the skill stats across clients.
 	/// </summary>
@@ -111,13 +144,40 @@ public:
 	/// <returns></returns>
 	const bool is_hidden() const;
 
+	/// <summary>
+	/// Whether this entity is a read only copy of an entity simulated by a neighbouring zone.
+	/// </summary>
+	/// <returns></returns>
+	const bool is_mirror() const;
+
 protected:
 	mutable bool        m_bHideEntity = false;
 	bool                m_bIsDead     = false;
-	int32_t             m_respawnTimerElapsed = 0;
+	bool                m_bIsMirror   = false;
+
+	//The tick from which the entity is allowed to attack again.
+	uint64_t            m_attackReadyTick = 0;
+
+	//Scheduled actions that get executed after the entity has died.
+	Server::TimerHandle m_hideAction    = 0;
+	Server::TimerHandle m_respawnAction = 0;
+
+	//Index within the ticking entities of the entity handler.
+	size_t              m_tickIndex = SIZE_MAX;
+
+	//Every reason the entity currently isn't ticking for.
+	uint8_t             m_tickSuspension = 0;
+
+	//The region the entity is tracked in & its index within that region.
+	Utilities::ivec2    m_region      = Utilities::ivec2(0, 0);
+	size_t              m_regionIndex = SIZE_MAX;
 
-	//How much time there's reserved before we start counting respawn timer.
+	//How much time there's reserved before we hide the entity after dying.
 	int32_t m_deathTransitionTime = 5;
+
+	friend class Server::EntityHandler;
+	friend class Server::RegionGrid;
+	friend class Server::ZoneLink;
 };
 
 class Player : public Entity
@@ -180,7 +240,8 @@ public:
 private:
 	e_PlayerRights m_playerRights = e_PlayerRights::Regular;
 	std::string    m_name         = "Player";
-	
+
+	friend class Server::ZoneLink;
 };
 
 class NPC : public Entity
@@ -231,6 +292,12 @@ public:
 	/// Make the NPC aggressive to the following target.
 	/// </summary>
 	virtual void set_target(std::shared_ptr<Entity> _entity, bool _bWasInstigated) override;
+
+	/// <summary>
+	/// Returns the entity this NPC is currently fighting, or null when it isn't.
+	/// </summary>
+	/// <returns></returns>
+	std::shared_ptr<Entity> get_target() const;
 	
 	/// <summary>
 	/// Sets target to null and resets combat behaviour.
@@ -244,6 +311,7 @@ private:
 	bool                    m_bIsMoving = false;
 
 	friend class Server::EntityHandler;
+	friend class Server::ZoneLink;
 };
 
 static const NPC get_entity_data(const uint8_t _id)
@@ -6,8 +6,12 @@
 
 #include "Core/Game/Entity/Definition/EntityDef.h"
 
+#include "Core/Game/World/RegionGrid.h"
+
 #include <unordered_map>
 
+#include <unordered_set>
+
 #include <optional>
 
 #pragma region FORWARD_DECLERATIONS
@@ -78,6 +82,28 @@ namespace Server
 		void create_world_npc(uint8_t npcId, Utilities::ivec2 _pos, int32_t _respawnTimer = -1);
 
 
+		/// <summary>
+		/// Adds a read only copy of an entity owned by a neighbouring zone, mirrors don't tick but do get replicated.
+		/// Mirrored players keep the npc's near them awake.
+		/// </summary>
+		/// <param name="_entity"></param>
+		void add_mirror(std::shared_ptr<Entity> _entity);
+
+
+		/// <summary>
+		/// Removes the mirror straight away without notifying clients, for when the owned entity takes its place under the same uuid.
+		/// </summary>
+		/// <param name="_uuid"></param>
+		void remove_mirror(DM::Utils::UUID _uuid);
+
+
+		/// <summary>
+		/// Takes over an npc that got handed off by a neighbouring zone.
+		/// </summary>
+		/// <param name="_npc"></param>
+		void adopt_npc(std::shared_ptr<NPC> _npc);
+
+
 		/// <summary>
 		/// Returns the current list of entities that are within the world.
 		/// </summary>
@@ -123,11 +149,100 @@ namespace Server
 		void destroy_entity(DM::Utils::UUID _uuid);
 
 
+		/// <summary>
+		/// Adds or lifts a reason for the entity to not get updated every game cycle, applied at the start of the next cycle.
+		/// Entities that are waiting on a scheduled action (e.g respawning) or that are out of reach of players don't need to tick.
+		/// </summary>
+		/// <param name="_uuid"></param>
+		/// <param name="_bShouldTick"></param>
+		/// <param name="_reason"></param>
+		void set_entity_ticking(DM::Utils::UUID _uuid, const bool _bShouldTick, const e_TickSuspension _reason);
+
+
+		/// <summary>
+		/// Moves the entity into the region of its current position, the entity goes dormant if it ends up in a dormant region.
+		/// Call this whenever the position of an entity changes.
+		/// </summary>
+		/// <param name="_entity"></param>
+		void update_entity_region(std::shared_ptr<Entity> _entity);
+
+
+		/// <summary>
+		/// Returns the grid that decides which npc's are dormant.
+		/// </summary>
+		/// <returns></returns>
+		RegionGrid& get_region_grid();
+
+
+		/// <summary>
+		/// Whether the state of the entities reaches the clients through delta snapshots.
+		/// The event packets of the replicated fields are left out then, clients would otherwise receive every change twice.
+		/// </summary>
+		/// <returns></returns>
+		const bool is_replicated() const;
+
+
+		/// <summary>
+		/// Sends the serialized position packet of the entity to every client. While positions get replicated only the player
+		/// itself receives it, its client needs the input sequence of the packet to reconcile its prediction.
+		/// </summary>
+		/// <param name="_uuid"></param>
+		/// <param name="_data"></param>
+		/// <param name="_channel"></param>
+		/// <param name="_flags"></param>
+		void send_position(const EntityUUID _uuid, const std::string& _data, const uint8_t _channel, const enet_uint32 _flags);
+
+
 		/// <summary>
 		/// Happens every game cycle.
 		/// </summary>
 		void tick();
 
+	private:
+		/// <summary>
+		/// Adds or lifts the suspension reason and updates whether the entity is ticking accordingly.
+		/// </summary>
+		void apply_ticking(std::shared_ptr<Entity> _entity, const bool _bShouldTick, const e_TickSuspension _reason);
+
+		/// <summary>
+		/// Adds or removes the entity from the ticking entities.
+		/// </summary>
+		void link_ticking(std::shared_ptr<Entity> _entity, const bool _bShouldTick);
+
+		/// <summary>
+		/// Wakes up npc's within regions that players approached, and puts the ones that players left to sleep.
+		/// </summary>
+		void update_dormancy();
+
+		/// <summary>
+		/// Updates all npc's within dormant regions, only happens every so many ticks when enabled.
+		/// </summary>
+		void tick_dormant_entities();
+
+		/// <summary>
+		/// Resends the position of every entity that moved within the last few keyframes.
+		/// </summary>
+		void send_movement_keyframes();
+
+		struct TickingChange
+		{
+			std::shared_ptr<Entity> entity;
+			bool                    bShouldTick;
+			e_TickSuspension        reason;
+		};
+
+	public:
+		/// <summary>
+		/// The amount of ticks between keyframes of the positions that got sent unreliable.
+		/// </summary>
+		const uint32_t KEYFRAME_TICK_INTERVAL = 5; // 3 seconds
+
+		/// <summary>
+		/// Keyframes are unreliable as well, a reliable one would stall every position queued behind it once it got lost.
+		/// The position of an entity that stopped moving gets repeated over this many keyframes instead.
+		/// </summary>
+		const uint32_t KEYFRAME_REPEATS = 3;
+
 	public:
 		EntityHandler() = default;
 		~EntityHandler();
@@ -143,11 +258,44 @@ namespace Server
 		/// </summary>
 		std::unordered_map<EntityUUID, std::shared_ptr<Entity>> m_entities;
 
+		/// <summary>
+		/// Entities that get updated every game cycle.
+		/// </summary>
+		std::vector<std::shared_ptr<Entity>> m_tickingEntities;
+
+		/// <summary>
+		/// Entities that should start or stop ticking next game cycle.
+		/// </summary>
+		std::vector<TickingChange> m_tickingChanges;
+
+		/// <summary>
+		/// Keeps track of which npc's are near players.
+		/// </summary>
+		RegionGrid m_regions;
+
+		/// <summary>
+		/// Reused between ticks to avoid allocating.
+		/// </summary>
+		std::vector<Utilities::ivec2>        m_regionObservers;
+		std::vector<Utilities::ivec2>        m_wokenRegions;
+		std::vector<Utilities::ivec2>        m_dormantRegions;
+		std::vector<std::shared_ptr<Entity>> m_dormantTicking;
+
 		/// <summary>
 		/// To indentify which handles are npc's
 		/// </summary>
 		std::vector<EntityUUID> m_npcHandles;
 
+		/// <summary>
+		/// Entities whose position got sent unreliable, along with the amount of keyframes they still get sent in.
+		/// </summary>
+		std::unordered_map<EntityUUID, uint32_t> m_keyframesLeft;
+
+		/// <summary>
+		/// Entities that are mirrored from neighbouring zones.
+		/// </summary>
+		std::unordered_set<EntityUUID> m_mirrors;
+
 		/// <summary>
 		/// Traces the playerId back to the ClientId.
 		/// </summary>
@@ -0,0 +1,144 @@
+#pragma once
+#include "Shared/Utilities/vec2.hpp"
+
+#include <unordered_map>
+
+#include <unordered_set>
+
+#include <vector>
+
+#include <memory>
+
+#pragma region FORWARD_DECLERATIONS
+
+class Entity;
+
+#pragma endregion
+
+namespace Server
+{
+	struct RegionSettings
+	{
+		/// <summary>
+		/// How many regions around a player are kept awake, in every direction.
+		/// </summary>
+		int32_t  activeRadius = 2;
+
+		/// <summary>
+		/// Every how many ticks entities within dormant regions still get updated.
+		/// 0 means dormant entities don't get updated at all.
+		/// </summary>
+		uint32_t dormantTickInterval = 0;
+	};
+
+	/// <summary>
+	/// Buckets world entities into square regions, regions with no player nearby are considered dormant.
+	/// Only the regions around players get evaluated, so the cost scales with the populated area instead of the size of the world.
+	/// </summary>
+	class RegionGrid
+	{
+	public:
+		using Bucket = std::vector<std::shared_ptr<Entity>>;
+
+		/// <summary>
+		/// Size of a region in tiles.
+		/// </summary>
+		constexpr static int32_t REGION_SIZE = 16;
+
+		/// <summary>
+		/// Returns the coordinates of the region the tile position lies in.
+		/// </summary>
+		/// <param name="_position"></param>
+		/// <returns></returns>
+		static const Utilities::ivec2 get_region(const Utilities::ivec2 _position);
+
+		/// <summary>
+		/// Start tracking the entity within the region of its current position.
+		/// </summary>
+		/// <param name="_entity"></param>
+		void insert(std::shared_ptr<Entity> _entity);
+
+		/// <summary>
+		/// Stop tracking the entity.
+		/// </summary>
+		/// <param name="_entity"></param>
+		void remove(std::shared_ptr<Entity> _entity);
+
+		/// <summary>
+		/// Moves the entity to the region of its current position.
+		/// Returns true if the entity ended up in a different region.
+		/// </summary>
+		/// <param name="_entity"></param>
+		/// <returns></returns>
+		const bool relocate(std::shared_ptr<Entity> _entity);
+
+		/// <summary>
+		/// Whether the entity is tracked by the grid.
+		/// </summary>
+		/// <param name="_entity"></param>
+		/// <returns></returns>
+		const bool contains(std::shared_ptr<Entity> _entity) const;
+
+		/// <summary>
+		/// Whether there's a player near the region.
+		/// </summary>
+		/// <param name="_region"></param>
+		/// <returns></returns>
+		const bool is_active(const Utilities::ivec2 _region) const;
+
+		/// <summary>
+		/// Recalculates which regions are active based on the positions of the observers (players).
+		/// Outputs the regions that woke up & the regions that became dormant since the last update.
+		/// </summary>
+		/// <param name="_observers"></param>
+		/// <param name="_woken"></param>
+		/// <param name="_dormant"></param>
+		void update_active_regions(const std::vector<Utilities::ivec2>& _observers,
+			                       std::vector<Utilities::ivec2>& _woken,
+			                       std::vector<Utilities::ivec2>& _dormant);
+
+		/// <summary>
+		/// Returns the entities within the region.
+		/// </summary>
+		/// <param name="_region"></param>
+		/// <returns></returns>
+		const Bucket& get_entities(const Utilities::ivec2 _region) const;
+
+		/// <summary>
+		/// Returns all regions that contain entities.
+		/// </summary>
+		/// <returns></returns>
+		const std::unordered_map<Utilities::ivec2, Bucket>& get_regions() const;
+
+		/// <summary>
+		/// Returns the regions that contain entities but have no player near them.
+		/// </summary>
+		/// <returns></returns>
+		const std::unordered_set<Utilities::ivec2>& get_dormant_regions() const;
+
+		/// <summary>
+		/// Returns the settings used to decide which regions are dormant.
+		/// </summary>
+		/// <returns></returns>
+		RegionSettings& get_settings();
+
+	public:
+		RegionGrid() = default;
+		~RegionGrid() = default;
+
+	private:
+		RegionSettings                               m_settings;
+		std::unordered_map<Utilities::ivec2, Bucket> m_regions;
+		std::unordered_set<Utilities::ivec2>         m_activeRegions;
+
+		/// <summary>
+		/// Kept up to date as entities come & go and regions wake up or go dormant, so the dormant entities can be found without visiting every region.
+		/// </summary>
+		std::unordered_set<Utilities::ivec2>         m_dormantRegions;
+
+		/// <summary>
+		/// Reused between updates to avoid allocating.
+		/// </summary>
+		std::unordered_set<Utilities::ivec2>         m_nextActiveRegions;
+	};
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <memory>
+
+#include <vector>
+
+#include <thread>
+
+#include <atomic>
+
+#include "Core/Events/Timer/TickClock.h"
+
+#include "Core/Network/Reactor/Reactor.h"
+
+#pragma region FORWARD_DECLERATIONS
+
+class NetworkHandler;
+
+namespace Server
+{
+	class ConnectionHandler;
+	class EntityHandler;
+	class World;
+	class ActionScheduler;
+	class ReplicationHandler;
+	class TelemetryHandler;
+	class ZoneLink;
+
+	struct IngressEvent;
+}
+
+#pragma endregion
+
+namespace Server
+{
+	/// <summary>
+	/// An independent copy of the game world, with its own clients, entities & tick clock.
+	/// Every instance ticks on a thread of its own, the game code reaches the systems of the instance it's running on through the thread local globals.
+	/// Instances share nothing but the network handler, clients move between them by getting transferred.
+	/// </summary>
+	class WorldInstance : public std::enable_shared_from_this<WorldInstance>
+	{
+	public:
+		/// <summary>
+		/// Starts ticking the instance on a thread of its own.
+		/// </summary>
+		void start();
+
+		/// <summary>
+		/// Ticks the instance on the calling thread until it gets stopped.
+		/// </summary>
+		void run();
+
+		/// <summary>
+		/// Stops ticking after the current tick, waits for the thread of the instance when it has one.
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// Returns the id the network handler routes the clients of this instance by, the default instance is 0.
+		/// </summary>
+		/// <returns></returns>
+		const uint32_t get_id() const;
+
+		/// <summary>
+		/// Returns the clock that drives the ticks of this instance, used to read its metrics or change its period & overrun policy.
+		/// </summary>
+		/// <returns></returns>
+		TickClock& get_tick_clock();
+
+		/// <summary>
+		/// Returns the duration of a tick in milliseconds, joining clients get sent it once so they can time the ticks packets get stamped with.
+		/// </summary>
+		/// <returns></returns>
+		const uint32_t get_tick_period_ms() const;
+
+		/// <summary>
+		/// Changes the duration of a tick, and lets every client of the instance know about it.
+		/// Has to get called on the thread of the instance.
+		/// </summary>
+		/// <param name="_period"></param>
+		void set_tick_period(const std::chrono::milliseconds _period);
+
+		/// <summary>
+		/// Lets the instance simulate a single zone of a partitioned world, has to happen before it starts ticking.
+		/// </summary>
+		/// <param name="_zoneLink"></param>
+		void set_zone_link(std::shared_ptr<ZoneLink> _zoneLink);
+
+	public:
+		WorldInstance(const uint32_t _id, std::shared_ptr<NetworkHandler> _networkHandler);
+		~WorldInstance();
+
+	private:
+		WorldInstance(WorldInstance&) = delete;
+
+		/// <summary>
+		/// Points the globals of the calling thread at the systems of this instance.
+		/// </summary>
+		void bind_globals();
+
+		/// <summary>
+		/// Hands the events the network handler routed to this instance to its systems.
+		/// </summary>
+		/// <param name="_events"></param>
+		void handle_events(std::vector<IngressEvent>& _events);
+
+		void tick();
+
+	private:
+		uint32_t                            m_id;
+
+		std::shared_ptr<NetworkHandler>     m_networkHandler;
+		std::shared_ptr<ConnectionHandler>  m_connectionHandler;
+		std::shared_ptr<EntityHandler>      m_entityHandler;
+		std::shared_ptr<World>              m_world;
+		std::shared_ptr<ActionScheduler>    m_scheduler;
+		std::shared_ptr<ReplicationHandler> m_replicationHandler;
+		std::shared_ptr<TelemetryHandler>   m_telemetryHandler;
+		std::shared_ptr<ZoneLink>           m_zoneLink;
+
+		TickClock                           m_tickClock = TickClock(std::chrono::milliseconds(600));
+		Reactor                             m_reactor;
+
+		std::thread                         m_thread;
+		std::atomic<bool>                   m_bIsRunning { false };
+	};
+}
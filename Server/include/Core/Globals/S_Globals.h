@@ -9,6 +9,11 @@ namespace Server
 	class ConnectionHandler;
 	class EntityHandler;
 	class World;
+	class ActionScheduler;
+	class ReplicationHandler;
+	class TelemetryHandler;
+	class WorldInstance;
+	class ZoneLink;
 }
 
 
@@ -16,6 +21,8 @@ namespace Server
 
 /// <summary>
 /// Client specific globals, these include systems that are explicitly needed by subsystems in order to function.
+/// Every world instance ticks on a thread of its own & fills in the globals of that thread with its own systems,
+/// the network handler is the only system shared between them.
 /// </summary>
 struct Globals
 {
@@ -23,6 +30,11 @@ struct Globals
 	std::shared_ptr<Server::EntityHandler>     entityHandler;
 	std::shared_ptr<NetworkHandler>            networkHandler;
 	std::shared_ptr<Server::World>             world;
+	std::shared_ptr<Server::ActionScheduler>   scheduler;
+	std::shared_ptr<Server::ReplicationHandler> replicationHandler;
+	std::shared_ptr<Server::TelemetryHandler>   telemetryHandler;
+	std::shared_ptr<Server::WorldInstance>      instance;
+	std::shared_ptr<Server::ZoneLink>           zoneLink; //Null unless the server runs as a zone of a partitioned world.
 };
 
-extern Globals g_globals;
+extern thread_local Globals g_globals;
@@ -2,6 +2,8 @@
 #include <memory>
 #include "Shared/Utilities/UUID.hpp"
 
+#include "Core/Events/Timer/TimingWheel.h"
+
 #pragma region FORWARD_DECLERATIONS
 
 class EventQuery;
@@ -23,12 +25,16 @@ struct ClientInfo
 	uint64_t                  playerId;                    //Unique UUID which refers to its player in the player handler.
 	EventQuery*               packetquery;                 //Player specific query for packets.
 
-	bool                      bAwaitingPing;               //Whether the server is waiting for the client to respond to a sent out ping to see if there's still a valid connection.
-	uint32_t                  ticksSinceLastResponse = 0;  //How many ticks have elapsed since the server has last received a ping from the client.
-	uint32_t	              idleticks              = 0;  //Time since the client has last done any interaction.
+	size_t                    handleIndex            = 0;  //Index of the client its handle within the connection handler, allows removing it without searching.
+	DM::Utils::UUID           combatTarget           = 0;  //Entity the player last engaged in combat, replicated with a higher priority.
+
+	Server::TimerHandle       warningTimer           = 0;  //Fires when the client has been idle long enough to receive a timeout warning.
+	Server::TimerHandle       timeoutTimer           = 0;  //Fires when the client has been idle for too long and has to get disconnected.
+	uint64_t                  lastActivityTick       = 0;  //Idle tick the client last showed any activity on.
+	uint64_t                  warnedActivityTick     = UINT64_MAX; //Last activity the client got warned about, so it only gets warned once per idle period.
 
 	/// <summary>
-	/// When called, will reset any bound timers related to its activity.
+	/// When called, will push back any bound timers related to its activity.
 	/// </summary>
 	void refresh();
 
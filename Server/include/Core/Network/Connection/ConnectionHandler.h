@@ -5,6 +5,8 @@
 
 #include <optional>
 
+#include "Core/Events/Timer/TimingWheel.h"
+
 #pragma region FORWARD_DECLERATIONS
 
 typedef struct _ENetPeer ENetPeer;
@@ -22,9 +24,12 @@ namespace Server
 	public:
 		/// <summary>
 		/// Registers the client to the server.
+		/// Clients that got redirected by a neighbouring zone connect with a handoff token, their player continues where it left off.
 		/// </summary>
 		/// <param name="_peer"></param>
-		void register_client(ENetPeer* _peer);
+		/// <param name="_clienthandle"></param>
+		/// <param name="_connectData"></param>
+		void register_client(ENetPeer* _peer, const enet_uint32 _clienthandle, const enet_uint32 _connectData = 0);
 
 		/// <summary>
 		/// Removes any data associated regarding a specific client.
@@ -32,6 +37,13 @@ namespace Server
 		/// <param name=""></param>
 		void flag_for_disconnect(const enet_uint32& _clienthandle);
 
+		/// <summary>
+		/// Moves the client to another world instance at the end of the tick, where it joins with a new player.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_instanceId"></param>
+		void flag_for_transfer(const enet_uint32 _clienthandle, const uint32_t _instanceId);
+
 		/// <summary>
 		/// Try returning a existing client peer based on the index.
 		/// </summary>
@@ -44,6 +56,20 @@ namespace Server
 		/// <returns></returns>
 		const std::vector<enet_uint32>& get_client_handles() const;
 
+		/// <summary>
+		/// Marks the client as active this tick, called whenever the client shows any activity.
+		/// The idle deadlines aren't touched, they check the last activity once they fire and re-arm themselves for the time that's left.
+		/// Clients that lost their connection get timed out by ENet, see the TelemetryHandler.
+		/// </summary>
+		/// <param name="_client"></param>
+		void register_activity(ClientInfo& _client);
+
+		/// <summary>
+		/// Logs out the player of the client & removes its data, without touching its connection.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		void remove_client(const enet_uint32 _clienthandle);
+
 		/// <summary>
 		/// The amount of ticks before the client gets pinged a warning.
 		/// </summary>
@@ -55,20 +81,42 @@ namespace Server
 		const uint32_t TICKS_TILL_TIMEOUT = 36000; // 6 hours
 
 		/// <summary>
-		/// The amount of tick cycles needed for the client to be inactive before the server will send out a ping to a client to see if it's still there.
+		/// Max amount of entities within a single chunk of the world snapshot that gets sent on join.
 		/// </summary>
-		const uint32_t PING_TICK_INTERVAL = 10; // 6 seconds.
+		const uint32_t SNAPSHOT_ENTITIES_PER_CHUNK = 256;
 
+	private:
 		/// <summary>
-		/// Amount of ticks of no response before the client gets disconnected serverside.
+		/// Advances the idle timers by a tick, only clients whose deadlines expire get touched.
 		/// </summary>
-		const uint32_t MAX_TICK_INTERVAL_NO_RESPONSE = 40; // 24 seconds
+		void update_idle_timers();
 
-	private:
 		/// <summary>
-		/// Increments all clients their idle timers.
+		/// Removes every client flagged for a transfer and hands it to the network handler, which routes it to its new instance.
 		/// </summary>
-		void update_idle_timers();
+		void transfer_flagged_clients();
+
+		/// <summary>
+		/// Sends the world snapshot to every client that joined since the last tick.
+		/// The snapshot gets built once per tick and the same packets get shared between all joining clients.
+		/// </summary>
+		void send_join_snapshots();
+
+		/// <summary>
+		/// Warns the client once it's been idle for long enough, otherwise re-arms itself for the time that's left.
+		/// </summary>
+		void arm_warning_timer(ClientInfo& _client, const uint64_t _delayTicks);
+
+		/// <summary>
+		/// Disconnects the client once it's been idle for too long, otherwise re-arms itself for the time that's left.
+		/// </summary>
+		void arm_timeout_timer(ClientInfo& _client, const uint64_t _delayTicks);
+
+		/// <summary>
+		/// Cancels every pending deadline of the client.
+		/// </summary>
+		/// <param name="_client"></param>
+		void cancel_idle_timers(ClientInfo& _client);
 
 		/// <summary>
 		/// Removes any data associated regarding a specific client.
@@ -86,9 +134,16 @@ namespace Server
 
 	private:
 		std::vector<enet_uint32>                       m_pendingDisconnects;
+		std::vector<std::pair<enet_uint32, uint32_t>>  m_pendingTransfers;
+		std::vector<enet_uint32>                       m_pendingJoins;
 		std::vector<enet_uint32>                       m_clientHandles;
 		std::unordered_map<enet_uint32, RefClientInfo> m_clientInfo;
 
-		friend class NetworkHandler;
+		/// <summary>
+		/// Holds the warning & timeout deadlines of every client.
+		/// </summary>
+		TimingWheel                                    m_idleTimers;
+
+		friend class WorldInstance;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+#include <unordered_map>
+
+#include <enet/enet.h>
+
+#include "Core/Network/Reactor/Reactor.h"
+
+namespace Server
+{
+	/// <summary>
+	/// Front-end process the clients connect to instead of the game server.
+	/// It keeps the ENet connections of the clients alive, pings them & times them out, and drops packets that are malformed,
+	/// aren't meant for the server or arrive faster than a client is allowed to send them.
+	/// Everything else travels to the game server over a single connection, see the GatewayShard, and broadcasts of the server get fanned out here.
+	/// </summary>
+	class Gateway
+	{
+	public:
+		constexpr static uint16_t DEFAULT_CLIENT_PORT = 1234;
+
+		constexpr static size_t   MAX_CLIENTS         = 4000;
+
+		/// <summary>
+		/// Longest the gateway sleeps, ENet only runs its resend & ping timers while being serviced.
+		/// </summary>
+		constexpr static std::chrono::milliseconds SERVICE_INTERVAL = std::chrono::milliseconds(15);
+
+		/// <summary>
+		/// Every how often the connection quality of the clients gets reported to the server.
+		/// </summary>
+		constexpr static std::chrono::milliseconds STATS_INTERVAL   = std::chrono::milliseconds(1000);
+
+		/// <summary>
+		/// How many packets a client is allowed to send every second, and how many it can send at once after being quiet.
+		/// </summary>
+		constexpr static uint32_t PACKETS_PER_SECOND  = 20;
+		constexpr static uint32_t PACKET_BURST        = 40;
+
+		/// <summary>
+		/// How many packets of a client can get dropped before it gets disconnected.
+		/// </summary>
+		constexpr static uint32_t MAX_DROPPED_PACKETS = 100;
+
+		/// <summary>
+		/// Largest packet a client can send, chat messages are the largest packets by far.
+		/// </summary>
+		constexpr static size_t   MAX_PACKET_SIZE     = 512;
+
+		/// <summary>
+		/// Longest the gateway waits on the server before it tries to connect again.
+		/// </summary>
+		constexpr static uint32_t CONNECT_TIMEOUT_MS  = 5000;
+
+		/// <summary>
+		/// Keeps serving the clients until the process gets closed, reconnects to the server whenever the connection gets lost.
+		/// </summary>
+		void run();
+
+	public:
+		Gateway(const char* _serverAddress, const uint16_t _serverPort, const uint16_t _clientPort = DEFAULT_CLIENT_PORT);
+		~Gateway();
+
+	private:
+		Gateway(Gateway&) = delete;
+
+		struct Client
+		{
+			ENetPeer*         peer           = nullptr;
+			uint32_t          clientId       = 0;
+
+			/// <summary>
+			/// Token bucket of the rate limit, refilled with the time that passed since the last packet.
+			/// </summary>
+			float             tokens         = static_cast<float>(PACKET_BURST);
+			Clock::time_point lastRefill     = Clock::now();
+
+			uint32_t          droppedPackets = 0;
+		};
+
+		static ENetHost* create_client_host(const uint16_t _port);
+
+		/// <summary>
+		/// Starts connecting to the server, or starts over once the attempt timed out. Never blocks, the connect comes in through service_upstream.
+		/// </summary>
+		void connect_upstream();
+
+		void service_upstream();
+
+		void service_clients();
+
+		void handle_upstream_packet(ENetEvent& _event);
+
+		/// <summary>
+		/// Forwards the packet of the client to the server, unless it's rate limited or doesn't pass validation.
+		/// </summary>
+		void handle_client_packet(ENetEvent& _event, Client& _client);
+
+		/// <summary>
+		/// Takes a token out of the bucket of the client, returns false when it's empty.
+		/// </summary>
+		static const bool take_token(Client& _client);
+
+		/// <summary>
+		/// Whether the packet is something a client is allowed to send the server, and decodes as such.
+		/// </summary>
+		static const bool validate(const ENetEvent& _event);
+
+		/// <summary>
+		/// Counts the packet as dropped, disconnects the client when it keeps sending packets that get dropped.
+		/// </summary>
+		void drop_packet(Client& _client);
+
+		/// <summary>
+		/// Reports the connection quality of every client to the server, its telemetry reads them as if the clients were connected to it.
+		/// </summary>
+		void send_stats();
+
+		/// <summary>
+		/// Disconnects every client, the server forgot about all of them once the connection with it got lost.
+		/// </summary>
+		void disconnect_clients();
+
+		template<class T>
+		void send_upstream(T* _packet, const uint8_t _channel, const enet_uint32 _flags);
+
+	private:
+		ENetAddress                             m_serverAddress;
+
+		ENetHost*                               m_clientHost;
+		ENetHost*                               m_upstreamHost;
+		ENetPeer*                               m_upstream = nullptr;
+		bool                                    m_bIsUpstreamConnected = false;
+
+		/// <summary>
+		/// When the attempt to connect to the server that's underway times out.
+		/// </summary>
+		Clock::time_point                       m_connectDeadline;
+
+		Reactor                                 m_reactor;
+
+		/// <summary>
+		/// The connected clients, keyed by the id they're known as on the server.
+		/// </summary>
+		std::unordered_map<uint32_t, Client>    m_clients;
+
+		/// <summary>
+		/// Id the next client gets, ids are never 0 as that's what a peer without a client carries.
+		/// </summary>
+		uint32_t                                m_nextClientId = 1;
+	};
+}
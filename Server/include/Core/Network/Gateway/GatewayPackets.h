@@ -0,0 +1,115 @@
+#pragma once
+#include "Shared/Network/Packets/Packets.hpp"
+
+/// <summary>
+/// Messages that get sent between a gateway & the game server, the packets of the clients travel inside of them untouched.
+/// </summary>
+enum class e_GatewayPacket : uint8_t
+{
+	GATEWAY_NONE       = 0x00,
+
+	GATEWAY_CONNECT    = 0x01, //A client connected to the gateway.
+
+	GATEWAY_DISCONNECT = 0x02, //A client left the gateway, or the server kicks it.
+
+	GATEWAY_DATA       = 0x03, //A packet from or for a single client.
+
+	GATEWAY_BROADCAST  = 0x04, //The same packet for many clients of the gateway, which fans it out.
+
+	GATEWAY_STATS      = 0x05  //Connection quality of every client of the gateway.
+};
+
+namespace Packets
+{
+	/// <summary>
+	/// Base of every gateway message, the packet header is only there so the packet handler can serialize it.
+	/// </summary>
+	struct s_GatewayPacket : public s_PacketHeader
+	{
+		e_GatewayPacket type     = e_GatewayPacket::GATEWAY_NONE;
+		uint32_t        clientId = 0; //The connect id of the client on the gateway.
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(type, clientId);
+		}
+	};
+
+	struct s_GatewayConnect : public s_GatewayPacket
+	{
+		uint32_t connectData = 0; //What the client connected with, e.g a zone handoff token.
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_GatewayPacket>(this));
+			ar(connectData);
+		}
+	};
+
+	/// <summary>
+	/// Gets sent over the same channel with the same flags as the packet it carries.
+	/// </summary>
+	struct s_GatewayData : public s_GatewayPacket
+	{
+		uint8_t     channel = 0;
+		uint32_t    flags   = 0;
+		std::string data;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_GatewayPacket>(this));
+			ar(channel, flags, data);
+		}
+	};
+
+	struct s_GatewayBroadcast : public s_GatewayPacket
+	{
+		uint8_t               channel = 0;
+		uint32_t              flags   = 0;
+		std::vector<uint32_t> clientIds;
+		std::string           data;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_GatewayPacket>(this));
+			ar(channel, flags, clientIds, data);
+		}
+	};
+
+	/// <summary>
+	/// The ENet statistics of a client as measured by the gateway, the telemetry of the server reads them as if it was connected itself.
+	/// </summary>
+	struct s_GatewayClientStats
+	{
+		uint32_t clientId              = 0;
+		uint32_t roundTripTime         = 0;
+		uint32_t roundTripTimeVariance = 0;
+		uint32_t packetLoss            = 0;
+		uint32_t incomingDataTotal     = 0;
+		uint32_t outgoingDataTotal     = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(clientId, roundTripTime, roundTripTimeVariance, packetLoss);
+			ar(incomingDataTotal, outgoingDataTotal);
+		}
+	};
+
+	struct s_GatewayStats : public s_GatewayPacket
+	{
+		std::vector<s_GatewayClientStats> clients;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_GatewayPacket>(this));
+			ar(clients);
+		}
+	};
+}
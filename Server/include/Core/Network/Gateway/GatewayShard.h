@@ -0,0 +1,137 @@
+#pragma once
+#include <unordered_map>
+
+#include <memory>
+
+#include <deque>
+
+#include "Core/Network/Ingress/IngressShard.h"
+
+#include "Core/Network/Gateway/GatewayPackets.h"
+
+namespace Server
+{
+	/// <summary>
+	/// Shard the gateways connect to instead of the clients themselves.
+	/// Every client of a gateway gets a virtual peer on the server, so the game keeps addressing clients by their peer.
+	/// The gateway measures the connection of its clients and reports it back, the virtual peers carry these statistics for the telemetry.
+	/// </summary>
+	class GatewayShard : public IngressShard
+	{
+	public:
+		/// <summary>
+		/// Port the gateways connect to by default.
+		/// </summary>
+		constexpr static uint16_t DEFAULT_PORT = 1250;
+
+		constexpr static size_t   MAX_GATEWAYS = 16;
+
+		/// <summary>
+		/// Most clients that can be connected over all gateways at once.
+		/// </summary>
+		constexpr static size_t   MAX_CLIENTS  = 16384;
+
+		/// <summary>
+		/// Creates the host the gateways connect to.
+		/// </summary>
+		/// <param name="_port"></param>
+		/// <returns>The host, or null when it couldn't get created.</returns>
+		static ENetHost* create_host(const uint16_t _port);
+
+		/// <summary>
+		/// Sends every gateway the data once, along with which of its clients it's meant for.
+		/// The recipients get split over the gateways on the I/O thread, as only it knows where every client is connected.
+		/// </summary>
+		virtual void multicast(const std::vector<Recipient>& _recipients, const enet_uint8 _channel, const std::string& _data, const enet_uint32 _flags) override;
+
+		/// <summary>
+		/// Whether the peer is the virtual peer of a client behind one of the gateways.
+		/// </summary>
+		virtual const bool owns(const ENetPeer* _peer) const override;
+
+	public:
+		GatewayShard(ENetHost* _host);
+		virtual ~GatewayShard() override;
+
+	protected:
+		virtual void receive(ENetEvent& _event, std::vector<IngressEvent>& _received) override;
+
+		virtual void dispatch(const OutgoingCommand& _command) override;
+
+		/// <summary>
+		/// The virtual peers, they carry the statistics the gateways report.
+		/// </summary>
+		virtual const ENetPeer* get_peers(size_t& _count) const override;
+
+	private:
+		GatewayShard(GatewayShard&) = delete;
+
+		/// <summary>
+		/// Where the client behind a virtual peer is connected, only touched by the I/O thread.
+		/// </summary>
+		struct VirtualClient
+		{
+			ENetPeer* gateway  = nullptr;
+			uint32_t  clientId = 0;
+		};
+
+		/// <summary>
+		/// A multicast of the game thread, it gets split over the gateways once its marker command gets dispatched.
+		/// </summary>
+		struct PendingMulticast
+		{
+			std::vector<Recipient> recipients;
+			enet_uint8             channel = 0;
+			std::string            data;
+			enet_uint32            flags   = 0;
+		};
+
+		/// <summary>
+		/// Sends every gateway a single broadcast for the recipients behind it that are still connected.
+		/// </summary>
+		void dispatch_multicast(const PendingMulticast& _multicast);
+
+		/// <summary>
+		/// Hands out a virtual peer to the client of the gateway, returns null once every virtual peer is taken.
+		/// </summary>
+		ENetPeer* connect_client(ENetPeer* _gateway, const uint32_t _clientId);
+
+		/// <summary>
+		/// Lets the game know the client left and frees up its virtual peer.
+		/// </summary>
+		void disconnect_client(ENetPeer* _client, std::vector<IngressEvent>& _received);
+
+		/// <summary>
+		/// Frees up the virtual peer, without notifying the game.
+		/// </summary>
+		void release_client(ENetPeer* _client);
+
+		ENetPeer* find_client(ENetPeer* _gateway, const uint32_t _clientId) const;
+
+		void handle_packet(ENetEvent& _event, std::vector<IngressEvent>& _received);
+
+		template<class T>
+		void send_gateway(ENetPeer* _gateway, T* _packet, const uint8_t _channel, const enet_uint32 _flags);
+
+	private:
+		std::unique_ptr<ENetPeer[]>                                               m_clients;
+		std::vector<VirtualClient>                                                m_virtualClients;
+		std::vector<size_t>                                                       m_freeClients;
+
+		/// <summary>
+		/// Handle the next virtual peer connects with, it stands in for the connect id ENet would've picked.
+		/// </summary>
+		enet_uint32                                                               m_nextHandle = 1;
+
+		/// <summary>
+		/// Multicasts in the order their marker commands got queued.
+		/// </summary>
+		std::mutex                                                                m_multicastMutex;
+		std::deque<PendingMulticast>                                              m_multicasts;
+
+		/// <summary>
+		/// The virtual peers of the clients of every gateway, keyed by their id on the gateway.
+		/// </summary>
+		std::unordered_map<ENetPeer*, std::unordered_map<uint32_t, ENetPeer*>>    m_gatewayClients;
+	};
+}
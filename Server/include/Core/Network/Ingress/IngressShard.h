@@ -0,0 +1,211 @@
+#pragma once
+#include <vector>
+
+#include <thread>
+
+#include <mutex>
+
+#include <atomic>
+
+#include <string>
+
+#include <enet/enet.h>
+
+#include "Core/Network/Reactor/Reactor.h"
+
+namespace Server
+{
+	/// <summary>
+	/// Event received by a shard, the client handle is read on the I/O thread because ENet resets the peer of a disconnect before handing it out.
+	/// </summary>
+	struct IngressEvent
+	{
+		ENetEvent   event        = {};
+		enet_uint32 clientHandle = 0;
+	};
+
+	/// <summary>
+	/// Statistics ENet keeps for a peer, copied by the I/O thread so the game thread never reads a peer while it's being serviced.
+	/// </summary>
+	struct PeerStats
+	{
+		enet_uint32 clientHandle          = 0; //Client the statistics belong to, 0 when the peer isn't connected.
+		enet_uint32 roundTripTime         = 0;
+		enet_uint32 roundTripTimeVariance = 0;
+		enet_uint32 packetLoss            = 0;
+		enet_uint32 incomingDataTotal     = 0;
+		enet_uint32 outgoingDataTotal     = 0;
+	};
+
+	/// <summary>
+	/// A single ENet host that gets serviced by its own I/O thread.
+	/// The host is only ever touched by that thread, the game thread collects the received events and queues the packets to send.
+	/// Shards that don't talk to clients directly, see the GatewayShard, override how events get received & commands get dispatched.
+	/// </summary>
+	class IngressShard
+	{
+	public:
+		/// <summary>
+		/// A client a multicast is meant for.
+		/// </summary>
+		struct Recipient
+		{
+			ENetPeer*   peer         = nullptr;
+			enet_uint32 clientHandle = 0;
+		};
+
+		/// <summary>
+		/// Longest the I/O thread sleeps, ENet only runs its resend & ping timers while being serviced.
+		/// </summary>
+		constexpr static std::chrono::milliseconds SERVICE_INTERVAL = std::chrono::milliseconds(15);
+
+		/// <summary>
+		/// Every how often the I/O thread copies the statistics of its peers, the telemetry samples them once a tick.
+		/// </summary>
+		constexpr static std::chrono::milliseconds STATS_INTERVAL   = std::chrono::milliseconds(250);
+
+		/// <summary>
+		/// Creates a host listening on the address. When reusing the port, multiple hosts can listen on the same address and the
+		/// kernel spreads the clients over them by hashing their address. Only supported on Linux.
+		/// </summary>
+		/// <returns>The host, or null when it couldn't get created.</returns>
+		static ENetHost* create_host(const ENetAddress& _address, const size_t _peerCount, const size_t _channelCount,
+			                         const enet_uint32 _incomingBandwidth, const enet_uint32 _outgoingBandwidth, const bool _bReusePort);
+
+		/// <summary>
+		/// Starts servicing the host on a thread of its own.
+		/// </summary>
+		void start();
+
+		/// <summary>
+		/// Stops the I/O thread and waits for it to finish.
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// Moves every event received since the last call into the vector.
+		/// </summary>
+		/// <param name="_events"></param>
+		void poll_events(std::vector<IngressEvent>& _events);
+
+		/// <summary>
+		/// Queues the packet to get sent by the I/O thread, the shard takes ownership of the packet.
+		/// Packets for peers that disconnected in the meantime get dropped.
+		/// </summary>
+		/// <param name="_peer"></param>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_channel"></param>
+		/// <param name="_packet"></param>
+		void send(ENetPeer* _peer, const enet_uint32 _clienthandle, const enet_uint8 _channel, ENetPacket* _packet);
+
+		/// <summary>
+		/// Queues the same data for every recipient, all of them have to be owned by this shard.
+		/// </summary>
+		/// <param name="_recipients"></param>
+		/// <param name="_channel"></param>
+		/// <param name="_data"></param>
+		/// <param name="_flags"></param>
+		virtual void multicast(const std::vector<Recipient>& _recipients, const enet_uint8 _channel, const std::string& _data, const enet_uint32 _flags);
+
+		/// <summary>
+		/// Queues the peer to get disconnected by the I/O thread.
+		/// </summary>
+		/// <param name="_peer"></param>
+		/// <param name="_clienthandle"></param>
+		void disconnect(ENetPeer* _peer, const enet_uint32 _clienthandle);
+
+		/// <summary>
+		/// Whether the peer is connected to the host of this shard.
+		/// </summary>
+		/// <param name="_peer"></param>
+		/// <returns></returns>
+		virtual const bool owns(const ENetPeer* _peer) const;
+
+		/// <summary>
+		/// Copies the latest statistics the I/O thread took of the peer.
+		/// </summary>
+		/// <param name="_peer"></param>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_stats"></param>
+		/// <returns>False when the peer belongs to another client by now, or hasn't been copied since it connected.</returns>
+		const bool get_stats(const ENetPeer* _peer, const enet_uint32 _clienthandle, PeerStats& _stats);
+
+	public:
+		IngressShard(ENetHost* _host);
+		virtual ~IngressShard();
+
+	private:
+		IngressShard(IngressShard&) = delete;
+
+	protected:
+		/// <summary>
+		/// Packet or disconnect request of the game thread, a command without packet disconnects the peer.
+		/// </summary>
+		struct OutgoingCommand
+		{
+			ENetPeer*   peer         = nullptr;
+			enet_uint32 clientHandle = 0;
+			enet_uint8  channel      = 0;
+			ENetPacket* packet       = nullptr;
+		};
+
+		/// <summary>
+		/// Turns an event of the host into the events the game collects, happens on the I/O thread.
+		/// </summary>
+		/// <param name="_event"></param>
+		/// <param name="_received"></param>
+		virtual void receive(ENetEvent& _event, std::vector<IngressEvent>& _received);
+
+		/// <summary>
+		/// Hands a single queued command of the game thread to ENet, happens on the I/O thread.
+		/// </summary>
+		/// <param name="_command"></param>
+		virtual void dispatch(const OutgoingCommand& _command);
+
+		void queue_outgoing(const OutgoingCommand& _command);
+
+		/// <summary>
+		/// The peers the statistics get copied from, the peers of the host unless overridden.
+		/// </summary>
+		/// <param name="_count"></param>
+		/// <returns></returns>
+		virtual const ENetPeer* get_peers(size_t& _count) const;
+
+	private:
+		/// <summary>
+		/// Body of the I/O thread.
+		/// </summary>
+		void run();
+
+		/// <summary>
+		/// Hands the queued commands of the game thread to ENet.
+		/// </summary>
+		void send_outgoing();
+
+		/// <summary>
+		/// Copies the statistics of every peer for the game thread.
+		/// </summary>
+		void copy_stats();
+
+	protected:
+		ENetHost*                    m_host;
+
+	private:
+		Reactor                      m_reactor;
+
+		std::thread                  m_thread;
+		std::atomic<bool>            m_bIsRunning { false };
+
+		std::mutex                   m_incomingMutex;
+		std::vector<IngressEvent>    m_incoming;
+
+		std::mutex                   m_outgoingMutex;
+		std::vector<OutgoingCommand> m_outgoing;
+		std::vector<OutgoingCommand> m_sending;
+
+		std::mutex                   m_statsMutex;
+		std::vector<PeerStats>       m_stats;
+		std::vector<PeerStats>       m_copyingStats;
+		Clock::time_point            m_lastStatsCopy;
+	};
+}
@@ -1,13 +1,36 @@
 #pragma once
 #include <vector>
 #include <cinttypes>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
 
-typedef struct _ENetHost ENetHost;
+#include "Shared/Network/Packets/PacketChannels.hpp"
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetPeer ENetPeer;
+typedef unsigned int enet_uint32;
+
+namespace Server
+{
+	class IngressShard;
+	class WorldInstance;
+	class ZoneLink;
+
+	struct IngressEvent;
+	struct PeerStats;
+}
+
+#pragma endregion
 
 /// <summary>
 /// This class takes care of managing the initialization & establishment of the server.
+/// Packets get received & sent by one or more ingress shards, each servicing its own ENet host on its own thread.
+/// Every world instance collects the events of its own clients at the start of its tick and queues whatever it sends back to the shard of the peer.
 /// </summary>
-class NetworkHandler 
+class NetworkHandler
 {
 public:
 	/// <summary>
@@ -18,10 +41,11 @@ public:
 	/// <param name="inc_bandwith"></param>
 	/// <param name="outg_bandwidth"></param>
 	/// <returns></returns>
-	static NetworkHandler create_local_host(int32_t _maxconnections = 10, int32_t _channels = 2, int32_t _inc_bandwith = 0, int32_t _outg_bandwidth = 0);
+	static NetworkHandler create_local_host(int32_t _maxconnections = 10, int32_t _channels = CHANNEL_COUNT, int32_t _inc_bandwith = 0, int32_t _outg_bandwidth = 0);
 
 	/// <summary>
 	/// Create a listening server with the specified parameters.
+	/// A shard count of 0 opens one shard for every two hardware threads, more than one shard is only supported on Linux.
 	/// </summary>
 	/// <param name="adress"></param>
 	/// <param name="port"></param>
@@ -29,29 +53,158 @@ public:
 	/// <param name="channels"></param>
 	/// <param name="inc_bandwith"></param>
 	/// <param name="outg_bandwidth"></param>
+	/// <param name="shardCount"></param>
 	/// <returns></returns>
 	static NetworkHandler create_host(const char* _adress,
-		                              int32_t _port, 
-		                              int32_t _maxconnections, 
-		                              int32_t _channels = 2, 
+		                              int32_t _port,
+		                              int32_t _maxconnections,
+		                              int32_t _channels = CHANNEL_COUNT,
 		                              int32_t _inc_bandwith = 0,
-		                              int32_t _outg_bandwidth = 0);
+		                              int32_t _outg_bandwidth = 0,
+		                              uint32_t _shardCount = 0);
+
+	/// <summary>
+	/// Create a server that only the gateways connect to, they terminate the connections of the clients and relay their packets.
+	/// </summary>
+	/// <param name="_port"></param>
+	/// <returns></returns>
+	static NetworkHandler create_gateway_host(const uint16_t _port);
 
 public:
-	ENetHost* get_server_host();
+	/// <summary>
+	/// Serializes the packet and queues it on the shard the peer is connected to.
+	/// The handle is the one of the client info, the peer itself is only touched by the I/O thread of its shard.
+	/// </summary>
+	template<class T>
+	void send_packet(const T* _data, ENetPeer* _peer, const enet_uint32 _clienthandle, uint8_t _channel, enet_uint32 _flags);
 
-	void start_ticking();
+	/// <summary>
+	/// Serializes the packet once and queues it for every client of the calling world instance.
+	/// </summary>
+	template<class T>
+	void send_packet_multicast(const T* _data, uint8_t _channel, enet_uint32 _flags);
 
+	/// <summary>
+	/// Queues already serialized data for the peer.
+	/// </summary>
+	/// <param name="_peer"></param>
+	/// <param name="_clienthandle"></param>
+	/// <param name="_data"></param>
+	/// <param name="_channel"></param>
+	/// <param name="_flags"></param>
+	void send_data(ENetPeer* _peer, const enet_uint32 _clienthandle, const std::string& _data, uint8_t _channel, enet_uint32 _flags);
+
+	/// <summary>
+	/// Queues already serialized data for every client of the calling world instance.
+	/// The recipients get handed to their shards at once, so a shard can send the data to every gateway only once.
+	/// </summary>
+	/// <param name="_data"></param>
+	/// <param name="_channel"></param>
+	/// <param name="_flags"></param>
+	void send_data_multicast(const std::string& _data, uint8_t _channel, enet_uint32 _flags);
+
+	/// <summary>
+	/// Disconnects the peer from the shard it's connected to, without notifying the game.
+	/// Its route gets dropped straight away, anything it still had on its way gets dropped along with it.
+	/// </summary>
+	/// <param name="_peer"></param>
+	/// <param name="_clienthandle"></param>
+	void disconnect(ENetPeer* _peer, const enet_uint32 _clienthandle);
+
+	/// <summary>
+	/// Copies the latest statistics of the peer the shard took, false when they aren't of the client anymore.
+	/// </summary>
+	/// <param name="_peer"></param>
+	/// <param name="_clienthandle"></param>
+	/// <param name="_stats"></param>
+	/// <returns></returns>
+	const bool get_peer_stats(const ENetPeer* _peer, const enet_uint32 _clienthandle, Server::PeerStats& _stats) const;
+
+	/// <summary>
+	/// Routes everything the shards received to the instances of the clients, and moves the events of the instance into the vector.
+	/// </summary>
+	/// <param name="_instanceId"></param>
+	/// <param name="_events"></param>
+	void collect_events(const uint32_t _instanceId, std::vector<Server::IngressEvent>& _events);
+
+	/// <summary>
+	/// Routes the client to another instance, which receives it as a newly connected client.
+	/// The instance the client leaves has to remove it beforehand, packets still on their way to it get dropped.
+	/// </summary>
+	/// <param name="_peer"></param>
+	/// <param name="_clienthandle"></param>
+	/// <param name="_instanceId"></param>
+	/// <returns>False when the instance doesn't exist or the client disconnected in the meantime.</returns>
+	const bool transfer_client(ENetPeer* _peer, const enet_uint32 _clienthandle, const uint32_t _instanceId);
+
+	/// <summary>
+	/// Creates a new world instance, which still has to get started.
+	/// </summary>
+	/// <returns></returns>
+	std::shared_ptr<Server::WorldInstance> create_instance();
+
+	const uint32_t get_instance_count();
+
+	/// <summary>
+	/// Starts the shards and ticks the default instance on the calling thread.
+	/// When the server runs as a zone of a partitioned world, the default instance simulates that zone through the link.
+	/// </summary>
+	/// <param name="_zoneLink"></param>
+	void start_ticking(std::shared_ptr<Server::ZoneLink> _zoneLink = nullptr);
 
 public:
 	~NetworkHandler();
 
 protected:
-	NetworkHandler(ENetHost* _server);
+	NetworkHandler(std::vector<std::unique_ptr<Server::IngressShard>> _shards);
 	void destroy();
 
 private:
-	ENetHost* m_server;
+	/// <summary>
+	/// Returns the shard that owns the peer.
+	/// </summary>
+	/// <param name="_peer"></param>
+	/// <returns></returns>
+	Server::IngressShard* get_shard(const ENetPeer* _peer) const;
+
+private:
+	constexpr static uint32_t DEFAULT_INSTANCE = 0;
+
+	std::vector<std::unique_ptr<Server::IngressShard>> m_shards;
+
+	/// <summary>
+	/// Non owning, the instances reach the network handler through it.
+	/// </summary>
+	std::shared_ptr<NetworkHandler>                    m_self;
+
+	/// <summary>
+	/// Guards the instances & the routing of events, instances tick on their own threads.
+	/// </summary>
+	std::mutex                                         m_routeMutex;
+	std::vector<std::shared_ptr<Server::WorldInstance>> m_instances;
+
+	/// <summary>
+	/// The instance every connected client handle belongs to, and the events routed to every instance that it didn't collect yet.
+	/// </summary>
+	std::unordered_map<enet_uint32, uint32_t>          m_routes;
+	std::vector<std::vector<Server::IngressEvent>>     m_routed;
+	std::vector<Server::IngressEvent>                  m_polled;
+};
+
+#pragma region IMPLEMENTATION_DETAILS
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+template<class T>
+inline void NetworkHandler::send_packet(const T* _data, ENetPeer* _peer, const enet_uint32 _clienthandle, uint8_t _channel, enet_uint32 _flags)
+{
+	send_data(_peer, _clienthandle, PacketHandler::serialize<T>(_data), _channel, _flags);
+}
+
+template<class T>
+inline void NetworkHandler::send_packet_multicast(const T* _data, uint8_t _channel, enet_uint32 _flags)
+{
+	send_data_multicast(PacketHandler::serialize<T>(_data), _channel, _flags);
+}
 
-	const float m_tickDuration = 0.6f;
-};
\ No newline at end of file
+#pragma endregion
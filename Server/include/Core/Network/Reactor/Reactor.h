@@ -0,0 +1,75 @@
+#pragma once
+#include <chrono>
+
+#include <cstdint>
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetHost ENetHost;
+
+#pragma endregion
+
+namespace Server
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>
+	/// Puts a thread to sleep until datagrams arrive on the socket of the host, another thread wakes it up or a deadline passes.
+	/// On Linux this waits on the socket, an eventfd and a timerfd through epoll, so deadlines get met within microseconds.
+	/// Other platforms fall back to enet_socket_wait, which only has millisecond precision and can't be woken up early.
+	/// </summary>
+	class Reactor
+	{
+	public:
+		/// <summary>
+		/// Blocks until the socket of the host is readable, the reactor got woken up or the deadline passed.
+		/// </summary>
+		/// <param name="_deadline"></param>
+		/// <returns>Whether there are datagrams waiting to get received.</returns>
+		const bool wait_until(const Clock::time_point _deadline);
+
+		/// <summary>
+		/// Makes the current or next wait return straight away, can be called from any thread.
+		/// </summary>
+		void wake();
+
+		/// <summary>
+		/// Also wakes up the reactor once the socket of another host becomes readable.
+		/// Without epoll the other host only gets noticed on the next deadline or datagram of the first host.
+		/// </summary>
+		/// <param name="_host"></param>
+		void watch(ENetHost* _host);
+
+	public:
+		/// <summary>
+		/// Without a host the reactor only waits for deadlines and wakeups.
+		/// </summary>
+		/// <param name="_host"></param>
+		Reactor(ENetHost* _host = nullptr);
+		~Reactor();
+
+	private:
+		Reactor(Reactor&) = delete;
+
+		/// <summary>
+		/// Identifies which of the registered descriptors woke up the reactor.
+		/// </summary>
+		constexpr static uint32_t SOURCE_SOCKET = 0;
+		constexpr static uint32_t SOURCE_TIMER  = 1;
+		constexpr static uint32_t SOURCE_WAKE   = 2;
+
+		/// <summary>
+		/// Most descriptors that can be ready at once, the timer, the wakeup & the sockets of the watched hosts.
+		/// </summary>
+		constexpr static int      MAX_EVENTS    = 8;
+
+	private:
+		ENetHost* m_host;
+
+#ifdef __linux__
+		int       m_epollFd = -1;
+		int       m_timerFd = -1;
+		int       m_wakeFd  = -1;
+#endif
+	};
+}
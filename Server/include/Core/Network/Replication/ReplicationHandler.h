@@ -0,0 +1,189 @@
+#pragma once
+#include <unordered_map>
+
+#include <array>
+
+#include "Shared/Network/Replication/ReplicatedState.hpp"
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetPeer ENetPeer;
+typedef unsigned int enet_uint32;
+
+#pragma endregion
+
+namespace Server
+{
+	struct ConnectionStats;
+
+	/// <summary>
+	/// Replicates the state of every entity through snapshots.
+	/// Every tick each client receives a delta against the last snapshot it acknowledged, so lost packets heal by themselves
+	/// and the amount of data sent depends on how much changed rather than on the amount of events that happened.
+	///
+	/// Each client has a byte budget per tick that adapts to the quality of its connection. Entities that differ from what
+	/// the client acknowledged build up priority every tick until they get sent, the most relevant ones first.
+	/// </summary>
+	class ReplicationHandler
+	{
+	public:
+		/// <summary>
+		/// Amount of snapshots a client keeps around to read deltas against.
+		/// Clients that haven't acknowledged anything within this window receive the full state again.
+		/// </summary>
+		constexpr static uint32_t SNAPSHOT_HISTORY = 32;
+
+		/// <summary>
+		/// Bounds of the amount of bytes a client receives per tick.
+		/// </summary>
+		constexpr static uint32_t MIN_BYTE_BUDGET     = 256;
+		constexpr static uint32_t MAX_BYTE_BUDGET     = 16384;
+		constexpr static uint32_t INITIAL_BYTE_BUDGET = 4096;
+
+		/// <summary>
+		/// How much the budget grows every tick the connection of the client looks healthy.
+		/// </summary>
+		constexpr static uint32_t BYTE_BUDGET_STEP = 256;
+
+		/// <summary>
+		/// The budget shrinks once the client loses more packets than this, or when its round trip time climbs
+		/// more than the margin above twice the lowest round trip time measured for it, see the TelemetryHandler.
+		/// </summary>
+		constexpr static float    MAX_PACKET_LOSS      = 0.02f;
+		constexpr static uint32_t ROUND_TRIP_MARGIN_MS = 50;
+
+		/// <summary>
+		/// Priority entities gain every tick they're waiting to get sent.
+		/// Entities further away from the player gain less, down to a single point.
+		/// </summary>
+		constexpr static float OWN_PLAYER_PRIORITY = 1000.0f;
+		constexpr static float COMBAT_PRIORITY     = 100.0f;
+		constexpr static float DISTANCE_PRIORITY   = 32.0f;
+
+		/// <summary>
+		/// Captures the state of all entities and sends every client its delta.
+		/// </summary>
+		void tick();
+
+		/// <summary>
+		/// Marks the snapshot as received by the client, future deltas get written against it.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_sequence"></param>
+		void acknowledge(const enet_uint32 _clienthandle, const uint32_t _sequence);
+
+		/// <summary>
+		/// Forgets everything the client acknowledged.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		void remove_client(const enet_uint32 _clienthandle);
+
+		/// <summary>
+		/// Whether snapshots get sent out. While they do, the event packets of the replicated fields are left out.
+		/// On by default, admins can fall back to the event packets with ::replication off.
+		/// </summary>
+		/// <param name="_bIsEnabled"></param>
+		void set_enabled(const bool _bIsEnabled);
+		const bool is_enabled() const;
+
+		/// <summary>
+		/// Returns the sequence of the latest captured snapshot.
+		/// </summary>
+		/// <returns></returns>
+		const uint32_t get_sequence() const;
+
+		/// <summary>
+		/// Returns the amount of bytes the client is currently allowed to receive per tick.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		/// <returns></returns>
+		const uint32_t get_byte_budget(const enet_uint32 _clienthandle) const;
+
+	public:
+		ReplicationHandler() = default;
+		~ReplicationHandler() = default;
+
+	private:
+		ReplicationHandler(ReplicationHandler&) = delete;
+
+		/// <summary>
+		/// What got sent to a client in a specific snapshot, applied to its acknowledged view once it arrives.
+		/// </summary>
+		struct SentSnapshot
+		{
+			uint32_t                                       sequence = 0;
+			uint32_t                                       baseline = 0;
+			std::vector<DM::Replication::s_ReplicatedDiff> diffs;
+		};
+
+		struct ClientReplication
+		{
+			/// <summary>
+			/// The snapshot exactly as the client rebuilt it for the last sequence it acknowledged.
+			/// </summary>
+			uint32_t                                   ackedSequence = 0;
+			DM::Replication::ReplicatedSnapshot        ackedView;
+
+			std::array<SentSnapshot, SNAPSHOT_HISTORY> sent;
+
+			/// <summary>
+			/// Accumulated priority of every entity that's waiting to get sent, entities stop waiting once they're no longer part of the delta.
+			/// </summary>
+			std::unordered_map<uint64_t, float>        priorities;
+
+			uint32_t                                   byteBudget = INITIAL_BYTE_BUDGET;
+		};
+
+		/// <summary>
+		/// Builds the snapshot of the current tick, entities that didn't change reuse their state of the previous snapshot.
+		/// </summary>
+		void capture();
+
+		/// <summary>
+		/// Grows the budget of the client while its connection is healthy, and shrinks it once it starts losing packets or lagging.
+		/// </summary>
+		/// <param name="_client"></param>
+		/// <param name="_stats"></param>
+		void update_byte_budget(ClientReplication& _client, const ConnectionStats& _stats);
+
+		/// <summary>
+		/// Adds the priority of this tick to every waiting entity, and orders them from most to least important.
+		/// </summary>
+		/// <param name="_client"></param>
+		/// <param name="_clienthandle"></param>
+		void prioritise(ClientReplication& _client, const enet_uint32 _clienthandle);
+
+		/// <summary>
+		/// Sends the client as many of the most important entities as fit in its budget.
+		/// </summary>
+		/// <param name="_client"></param>
+		/// <param name="_peer"></param>
+		/// <param name="_clienthandle"></param>
+		void send_snapshot(ClientReplication& _client, ENetPeer* _peer, const enet_uint32 _clienthandle);
+
+	private:
+		DM::Replication::ReplicatedSnapshot m_current;
+		DM::Replication::ReplicatedSnapshot m_previous;
+
+		std::unordered_map<enet_uint32, ClientReplication> m_clients;
+
+		struct Candidate
+		{
+			size_t diffIndex = 0;
+			float  priority  = 0.0f;
+		};
+
+		/// <summary>
+		/// Reused between clients so writing deltas doesn't allocate.
+		/// </summary>
+		std::vector<DM::Replication::s_ReplicatedDiff> m_diffs;
+		std::vector<DM::Replication::s_ReplicatedDiff> m_selected;
+		std::vector<Candidate>                         m_candidates;
+		DM::Replication::BitWriter                     m_writer;
+		DM::Replication::BitWriter                     m_scratch;
+		DM::Replication::ReplicatedSnapshot            m_view;
+
+		uint32_t m_sequence   = 0;
+		bool     m_bIsEnabled = true;
+	};
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <unordered_map>
+
+#include <array>
+
+#include <optional>
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetPeer ENetPeer;
+typedef unsigned int enet_uint32;
+
+#pragma endregion
+
+namespace Server
+{
+	/// <summary>
+	/// Connection quality of a client, averaged over the last TelemetryHandler::SAMPLE_WINDOW ticks.
+	/// </summary>
+	struct ConnectionStats
+	{
+		float    roundTripTime          = 0.0f; //Mean round trip time in milliseconds.
+		float    jitter                 = 0.0f; //Mean round trip time variance in milliseconds.
+		float    packetLoss             = 0.0f; //Ratio of reliable packets that got lost, between 0 and 1.
+		float    bytesSentPerSecond     = 0.0f;
+		float    bytesReceivedPerSecond = 0.0f;
+
+		uint32_t lowestRoundTripTime    = UINT32_MAX; //Lowest round trip time ever measured, the baseline to compare the current one against.
+	};
+
+	/// <summary>
+	/// Reads the statistics ENet keeps for every peer once a tick and turns them into rolling connection stats.
+	/// ENet already pings idle peers and measures their round trip time & packet loss, so the server doesn't send pings of its own,
+	/// peers that stop responding get disconnected through the ENet timeout instead.
+	///
+	/// The peers are owned by the I/O threads of the ingress shards, the statistics get read from the copy the shards take every so often.
+	/// </summary>
+	class TelemetryHandler
+	{
+	public:
+		/// <summary>
+		/// Amount of ticks the stats get averaged over.
+		/// </summary>
+		constexpr static uint32_t SAMPLE_WINDOW = 16; // ~10 seconds.
+
+		/// <summary>
+		/// A peer gets disconnected once a reliable packet stays unacknowledged for the maximum, or for the minimum
+		/// when it also got retried more than the limit. Replaces the server ping that used to time out after 24 seconds.
+		/// Applied by the ingress shard as soon as the peer connects.
+		/// </summary>
+		constexpr static uint32_t TIMEOUT_LIMIT      = 32;
+		constexpr static uint32_t TIMEOUT_MINIMUM_MS = 5000;
+		constexpr static uint32_t TIMEOUT_MAXIMUM_MS = 20000;
+
+		/// <summary>
+		/// Starts tracking the stats of the peer.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_peer"></param>
+		void register_client(const enet_uint32 _clienthandle, ENetPeer* _peer);
+
+		/// <summary>
+		/// Stops tracking the client.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		void remove_client(const enet_uint32 _clienthandle);
+
+		/// <summary>
+		/// Samples the ENet statistics of every registered peer.
+		/// </summary>
+		void tick();
+
+		/// <summary>
+		/// Returns the stats of the client, if it's being tracked.
+		/// </summary>
+		/// <param name="_clienthandle"></param>
+		/// <returns></returns>
+		std::optional<ConnectionStats> get_stats(const enet_uint32 _clienthandle) const;
+
+	public:
+		TelemetryHandler() = default;
+		~TelemetryHandler() = default;
+
+	private:
+		TelemetryHandler(TelemetryHandler&) = delete;
+
+		struct Sample
+		{
+			enet_uint32 time          = 0;
+			enet_uint32 roundTripTime = 0;
+			enet_uint32 jitter        = 0;
+			enet_uint32 packetLoss    = 0;
+			enet_uint32 bytesSent     = 0;
+			enet_uint32 bytesReceived = 0;
+		};
+
+		struct ClientTelemetry
+		{
+			ENetPeer*                            peer = nullptr;
+
+			std::array<Sample, SAMPLE_WINDOW>    samples;
+			uint32_t                             sampleCount = 0;
+
+			/// <summary>
+			/// Data totals of the peer during the previous sample, ENet resets them every second or so.
+			/// </summary>
+			enet_uint32                          lastOutgoingDataTotal = 0;
+			enet_uint32                          lastIncomingDataTotal = 0;
+			bool                                 bHasDataTotals        = false;
+
+			ConnectionStats                      stats;
+		};
+
+		/// <summary>
+		/// Takes a new sample of the peer and recalculates its averages.
+		/// </summary>
+		/// <param name="_client"></param>
+		/// <param name="_clienthandle"></param>
+		/// <param name="_time"></param>
+		void sample(ClientTelemetry& _client, const enet_uint32 _clienthandle, const enet_uint32 _time);
+
+	private:
+		std::unordered_map<enet_uint32, ClientTelemetry> m_clients;
+	};
+}
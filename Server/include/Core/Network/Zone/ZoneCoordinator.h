@@ -0,0 +1,50 @@
+#pragma once
+#include <unordered_map>
+
+#include "Core/Network/Zone/ZoneLayout.h"
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetHost ENetHost;
+typedef struct _ENetPeer ENetPeer;
+
+#pragma endregion
+
+namespace Server
+{
+	/// <summary>
+	/// Lightweight process that hands the zone layout to every zone process, and lets them know which of their neighbours are online.
+	/// It never touches any game state, the zones hand entities off & mirror them between each other directly.
+	/// </summary>
+	class ZoneCoordinator
+	{
+	public:
+		constexpr static uint16_t DEFAULT_PORT = 1300;
+
+		/// <summary>
+		/// Keeps serving the zones until the process gets closed.
+		/// </summary>
+		void run();
+
+	public:
+		ZoneCoordinator(const ZoneLayout& _layout, const uint16_t _port = DEFAULT_PORT);
+		~ZoneCoordinator();
+
+	private:
+		ZoneCoordinator(ZoneCoordinator&) = delete;
+
+		/// <summary>
+		/// Sends the layout to every registered zone, called whenever a zone comes online or goes offline.
+		/// </summary>
+		void broadcast_layout();
+
+	private:
+		ENetHost*                               m_host;
+		ZoneLayout                              m_layout;
+
+		/// <summary>
+		/// The zone every registered peer simulates.
+		/// </summary>
+		std::unordered_map<ENetPeer*, uint32_t> m_zones;
+	};
+}
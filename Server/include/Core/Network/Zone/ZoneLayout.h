@@ -0,0 +1,116 @@
+#pragma once
+#include <vector>
+
+#include <string>
+
+#include <optional>
+
+#include "Shared/Network/Packets/Packets.hpp"
+
+#include "Shared/Utilities/vec2.hpp"
+
+namespace Server
+{
+	/// <summary>
+	/// A rectangle of the world that gets simulated by a single zone process, the maximum is exclusive.
+	/// </summary>
+	struct ZoneDefinition
+	{
+		uint32_t    zoneId     = 0;
+
+		int32_t     minX       = 0;
+		int32_t     minY       = 0;
+		int32_t     maxX       = 0;
+		int32_t     maxY       = 0;
+
+		std::string address    = "127.0.0.1";
+		uint16_t    clientPort = 0; //Port the clients of the zone connect to.
+		uint16_t    linkPort   = 0; //Port the neighbouring zones connect to.
+
+		bool        bIsOnline  = false;
+
+		/// <summary>
+		/// Whether the tile lies within the zone.
+		/// </summary>
+		/// <param name="_position"></param>
+		/// <returns></returns>
+		const bool contains(const Utilities::ivec2 _position) const;
+
+		/// <summary>
+		/// Whether the tile lies within the zone or within the margin around it.
+		/// </summary>
+		/// <param name="_position"></param>
+		/// <param name="_margin"></param>
+		/// <returns></returns>
+		const bool is_near(const Utilities::ivec2 _position, const int32_t _margin) const;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(zoneId, minX, minY, maxX, maxY);
+			ar(address, clientPort, linkPort, bIsOnline);
+		}
+	};
+
+	/// <summary>
+	/// How the world is split into zones, handed out by the zone coordinator to every zone process.
+	/// </summary>
+	class ZoneLayout
+	{
+	public:
+		/// <summary>
+		/// Reads a layout from a text file with a zone on every line:
+		/// id minX minY maxX maxY address clientPort linkPort
+		/// </summary>
+		/// <param name="_path"></param>
+		/// <returns></returns>
+		static std::optional<ZoneLayout> load(const std::string& _path);
+
+		/// <summary>
+		/// Splits the world into a grid of equally sized zones, all hosted on this machine.
+		/// Zone 0 starts at the origin where players spawn and uses the default client port.
+		/// </summary>
+		/// <param name="_columns"></param>
+		/// <param name="_rows"></param>
+		/// <param name="_zoneSize"></param>
+		/// <returns></returns>
+		static ZoneLayout create_loopback(const int32_t _columns, const int32_t _rows, const int32_t _zoneSize);
+
+		/// <summary>
+		/// Returns the zone the tile lies in, or null when it lies outside of every zone.
+		/// </summary>
+		/// <param name="_position"></param>
+		/// <returns></returns>
+		const ZoneDefinition* find_zone(const Utilities::ivec2 _position) const;
+
+		const ZoneDefinition* get_zone(const uint32_t _zoneId) const;
+
+		ZoneDefinition* get_zone(const uint32_t _zoneId);
+
+		/// <summary>
+		/// Whether the zones lie within the margin of each other.
+		/// </summary>
+		/// <param name="_a"></param>
+		/// <param name="_b"></param>
+		/// <param name="_margin"></param>
+		/// <returns></returns>
+		static const bool are_neighbours(const ZoneDefinition& _a, const ZoneDefinition& _b, const int32_t _margin);
+
+		std::vector<ZoneDefinition>& get_zones();
+
+		const std::vector<ZoneDefinition>& get_zones() const;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(m_zones);
+		}
+
+	public:
+		constexpr static uint16_t LOOPBACK_CLIENT_PORT = 1234;
+		constexpr static uint16_t LOOPBACK_LINK_PORT   = 1400;
+
+	private:
+		std::vector<ZoneDefinition> m_zones;
+	};
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include <unordered_map>
+
+#include <unordered_set>
+
+#include <memory>
+
+#include <optional>
+
+#include "Core/Network/Zone/ZonePackets.h"
+
+#pragma region FORWARD_DECLERATIONS
+
+typedef struct _ENetHost ENetHost;
+typedef struct _ENetPeer ENetPeer;
+typedef struct _ENetEvent ENetEvent;
+typedef unsigned int enet_uint32;
+
+struct ClientInfo;
+
+class Entity;
+class Player;
+
+#pragma endregion
+
+namespace Server
+{
+	/// <summary>
+	/// Connects a zone process to the coordinator & its neighbouring zones.
+	/// Entities that cross the border of the zone get handed off with their full state to the zone they walked into,
+	/// entities near the border get mirrored read only into the neighbours so they can see & fight them.
+	/// Only gets ticked by the default world instance, other instances aren't partitioned.
+	/// </summary>
+	class ZoneLink
+	{
+	public:
+		/// <summary>
+		/// How far past its border a zone receives the entities of its neighbours, has to be larger than any attack range.
+		/// </summary>
+		constexpr static int32_t  MIRROR_MARGIN = 8;
+
+		/// <summary>
+		/// How long a handed off player has to reconnect to this zone before its state gets dropped.
+		/// </summary>
+		constexpr static uint64_t HANDOFF_EXPIRY_TICKS = 50; // 30 seconds
+
+		/// <summary>
+		/// Every how many ticks the zone retries linking up with neighbours it isn't connected to.
+		/// </summary>
+		constexpr static uint64_t RECONNECT_TICK_INTERVAL = 10;
+
+		/// <summary>
+		/// Longest a zone waits on the coordinator for the layout when starting up.
+		/// </summary>
+		constexpr static uint32_t JOIN_TIMEOUT_MS = 5000;
+
+		/// <summary>
+		/// Registers the zone to the coordinator and waits for the layout.
+		/// Returns null when the coordinator couldn't be reached or the zone isn't part of its layout.
+		/// </summary>
+		/// <param name="_zoneId"></param>
+		/// <param name="_coordinatorAddress"></param>
+		/// <param name="_coordinatorPort"></param>
+		/// <returns></returns>
+		static std::shared_ptr<ZoneLink> join(const uint32_t _zoneId, const char* _coordinatorAddress, const uint16_t _coordinatorPort);
+
+		/// <summary>
+		/// Returns the definition of the zone this process simulates.
+		/// </summary>
+		/// <returns></returns>
+		const ZoneDefinition& get_zone() const;
+
+		/// <summary>
+		/// Receives the messages of the other zones, hands off the entities that left the zone & mirrors the ones near its border.
+		/// Happens every game cycle, after the entities got updated.
+		/// </summary>
+		void tick();
+
+		/// <summary>
+		/// Sends a hit on a mirrored entity to the zone that owns it, the result comes back with its next mirror.
+		/// </summary>
+		/// <param name="_attackerId"></param>
+		/// <param name="_targetId"></param>
+		/// <param name="_damage"></param>
+		void forward_hit(const uint64_t _attackerId, const uint64_t _targetId, const int32_t _damage);
+
+		/// <summary>
+		/// Returns the state of the player that got redirected to this zone with the token, and removes any mirror of it.
+		/// </summary>
+		/// <param name="_token"></param>
+		/// <returns></returns>
+		std::optional<Packets::s_ZoneEntity> claim_handoff(const enet_uint32 _token);
+
+		/// <summary>
+		/// Applies the handed off state onto the freshly registered player, including the path it was walking & what it was fighting.
+		/// </summary>
+		/// <param name="_client"></param>
+		/// <param name="_player"></param>
+		/// <param name="_state"></param>
+		void restore_player(ClientInfo& _client, std::shared_ptr<Player> _player, const Packets::s_ZoneEntity& _state);
+
+	public:
+		~ZoneLink();
+
+	private:
+		ZoneLink(const uint32_t _zoneId, ENetHost* _coordinatorHost, ENetPeer* _coordinator, ENetHost* _host, const ZoneLayout& _layout);
+		ZoneLink(ZoneLink&) = delete;
+
+		struct PendingHandoff
+		{
+			Packets::s_ZoneEntity entity;
+			uint64_t              expiryTick = 0;
+		};
+
+		/// <summary>
+		/// Drains the events of the coordinator & the neighbouring zones.
+		/// </summary>
+		void service();
+
+		void handle_packet(ENetEvent& _event);
+
+		/// <summary>
+		/// Connects to every online neighbour that isn't linked yet, only the zone with the highest id dials so a pair links up once.
+		/// </summary>
+		void link_neighbours();
+
+		/// <summary>
+		/// Hands off every owned entity that stands within another linked zone.
+		/// </summary>
+		void hand_off_entities();
+
+		void hand_off_player(const std::shared_ptr<Player>& _player, const enet_uint32 _clienthandle, const ZoneDefinition& _zone);
+
+		void hand_off_npc(const std::shared_ptr<Entity>& _npc, const ZoneDefinition& _zone);
+
+		/// <summary>
+		/// Sends every neighbour the owned entities within its margin, an empty mirror lets it drop its mirrors.
+		/// </summary>
+		void send_mirrors();
+
+		/// <summary>
+		/// Creates, updates or removes the mirrors of the zone, only the latest mirror received within a tick gets applied.
+		/// </summary>
+		void apply_mirror(const Packets::s_ZoneMirror& _mirror);
+
+		void receive_handoff(const Packets::s_ZoneHandoff& _handoff);
+
+		void receive_hit(const Packets::s_ZoneRemoteHit& _hit);
+
+		/// <summary>
+		/// Removes every mirror of the zone, called once the link with it got lost.
+		/// </summary>
+		void drop_mirrors(const uint32_t _zoneId);
+
+		/// <summary>
+		/// Returns the peer of the neighbour, when it's connected.
+		/// </summary>
+		ENetPeer* get_link(const uint32_t _zoneId) const;
+
+		static Packets::s_ZoneEntity capture(const std::shared_ptr<Entity>& _entity);
+
+		/// <summary>
+		/// Copies the position, skills & visibility of the state onto the entity.
+		/// </summary>
+		static void apply_state(Entity& _entity, const Packets::s_ZoneEntity& _state);
+
+		template<class T>
+		void send(ENetPeer* _peer, T* _packet, const uint8_t _channel, const enet_uint32 _flags);
+
+	private:
+		uint32_t                                                   m_zoneId;
+		uint64_t                                                   m_tick = 0;
+
+		ENetHost*                                                  m_coordinatorHost;
+		ENetPeer*                                                  m_coordinator;
+		ENetHost*                                                  m_host;
+
+		ZoneLayout                                                 m_layout;
+
+		/// <summary>
+		/// Peers of the neighbouring zones, including the ones that are still connecting.
+		/// </summary>
+		std::unordered_map<uint32_t, ENetPeer*>                    m_links;
+		std::unordered_map<ENetPeer*, uint32_t>                    m_linkZones;
+
+		/// <summary>
+		/// The entities every neighbour mirrors into this zone, and the latest mirror of every neighbour received this tick.
+		/// </summary>
+		std::unordered_map<uint32_t, std::unordered_set<uint64_t>> m_mirrors;
+		std::unordered_map<uint32_t, Packets::s_ZoneMirror>        m_receivedMirrors;
+
+		/// <summary>
+		/// Players that got handed to this zone, keyed by the token they reconnect with.
+		/// </summary>
+		std::unordered_map<enet_uint32, PendingHandoff>            m_pendingHandoffs;
+	};
+}
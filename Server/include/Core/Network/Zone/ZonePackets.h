@@ -0,0 +1,169 @@
+#pragma once
+#include "Shared/Network/Packets/Packets.hpp"
+
+#include "Core/Network/Zone/ZoneLayout.h"
+
+/// <summary>
+/// Messages that get sent between zone processes & the zone coordinator, these never reach a client.
+/// </summary>
+enum class e_ZonePacket : uint8_t
+{
+	ZONE_NONE       = 0x00,
+
+	ZONE_REGISTER   = 0x01, //A zone identifies itself to the coordinator or a neighbour.
+
+	ZONE_LAYOUT     = 0x02, //The coordinator hands out the layout & which zones are online.
+
+	ZONE_HANDOFF    = 0x03, //Ownership of an entity moves to the receiving zone.
+
+	ZONE_MIRROR     = 0x04, //Read only copies of every entity near the border of the receiving zone.
+
+	ZONE_REMOTE_HIT = 0x05  //A mirrored entity got hit, has to get applied by the zone that owns it.
+};
+
+/// <summary>
+/// Channels of the links between zones.
+/// </summary>
+enum e_ZoneChannel : uint8_t
+{
+	ZONE_CHANNEL_RELIABLE = 0,
+
+	ZONE_CHANNEL_MIRROR   = 1,
+
+	ZONE_CHANNEL_COUNT
+};
+
+namespace Packets
+{
+	/// <summary>
+	/// Base of every zone message, the packet header is only there so the packet handler can serialize it.
+	/// </summary>
+	struct s_ZonePacket : public s_PacketHeader
+	{
+		e_ZonePacket type   = e_ZonePacket::ZONE_NONE;
+		uint32_t     zoneId = 0; //Zone that sent the message.
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(type, zoneId);
+		}
+	};
+
+	struct s_ZoneSkill
+	{
+		int32_t level        = 1;
+		int32_t levelBoosted = 1;
+		int32_t experience   = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(level, levelBoosted, experience);
+		}
+	};
+
+	/// <summary>
+	/// Full state of an entity, enough to carry on simulating it within another zone.
+	/// </summary>
+	struct s_ZoneEntity
+	{
+		uint64_t                 entityId     = 0;
+		bool                     bIsPlayer    = false;
+		uint8_t                  npcId        = 0;
+
+		int32_t                  posX         = 0;
+		int32_t                  posY         = 0;
+		int32_t                  respawnX     = 0;
+		int32_t                  respawnY     = 0;
+
+		std::vector<s_ZoneSkill> skills;
+
+		bool                     bIsDead      = false;
+		bool                     bIsHidden    = false;
+
+		//Players only.
+		std::string              name;
+		uint8_t                  rights       = 0;
+		bool                     bIsRunning   = false;
+
+		//The tile the entity is walking towards & what it's fighting.
+		bool                     bIsMoving    = false;
+		int32_t                  destinationX = 0;
+		int32_t                  destinationY = 0;
+		uint64_t                 combatTarget = 0;
+
+		//Npc's only.
+		uint8_t                  wanderingDistance    = 0;
+		uint8_t                  maxWanderingDistance = 0;
+		uint8_t                  attackRange          = 0;
+		bool                     bIsAgressive         = false;
+		float                    respawnTimer         = 0.0f;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(entityId, bIsPlayer, npcId);
+			ar(posX, posY, respawnX, respawnY);
+			ar(skills, bIsDead, bIsHidden);
+			ar(name, rights, bIsRunning);
+			ar(bIsMoving, destinationX, destinationY, combatTarget);
+			ar(wanderingDistance, maxWanderingDistance, attackRange, bIsAgressive, respawnTimer);
+		}
+	};
+
+	struct s_ZoneLayout : public s_ZonePacket
+	{
+		Server::ZoneLayout layout;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_ZonePacket>(this));
+			ar(layout);
+		}
+	};
+
+	struct s_ZoneHandoff : public s_ZonePacket
+	{
+		/// <summary>
+		/// Players hand the token to the zone they get redirected to, so it can match them to their state.
+		/// </summary>
+		uint32_t     token = 0;
+		s_ZoneEntity entity;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_ZonePacket>(this));
+			ar(token, entity);
+		}
+	};
+
+	struct s_ZoneMirror : public s_ZonePacket
+	{
+		std::vector<s_ZoneEntity> entities;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_ZonePacket>(this));
+			ar(entities);
+		}
+	};
+
+	struct s_ZoneRemoteHit : public s_ZonePacket
+	{
+		uint64_t attackerId = 0;
+		uint64_t targetId   = 0;
+		int32_t  damage     = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_ZonePacket>(this));
+			ar(attackerId, targetId, damage);
+		}
+	};
+}
@@ -4,6 +4,16 @@
 
 #include "Core/Network/NetworkHandler.h"
 
+#include "Core/Network/Zone/ZoneCoordinator.h"
+
+#include "Core/Network/Zone/ZoneLink.h"
+
+#include "Core/Network/Gateway/Gateway.h"
+
+#include "Core/Network/Gateway/GatewayShard.h"
+
+#include <cstring>
+
 int main(int argc, char** argv)
 {
 	//Initialise ENet before doing anything.
@@ -24,6 +34,66 @@ int main(int argc, char** argv)
 
 	atexit(enet_deinitialize);
 
+	//*--------------------------------------------------------------------------
+	// Partitioned world, every zone runs in a process of its own:
+	//   Server --coordinator [layout file]       Hands out the layout, defaults to 2 zones on this machine.
+	//   Server --zone <id> [coordinator address] Simulates a single zone of the layout.
+	//*
+	if (argc > 1 && strcmp(argv[1], "--coordinator") == 0)
+	{
+		std::optional<Server::ZoneLayout> layout = argc > 2 ? Server::ZoneLayout::load(argv[2]) : Server::ZoneLayout::create_loopback(2, 1, 16);
+
+		if (!layout.has_value())
+			return EXIT_FAILURE;
+
+		Server::ZoneCoordinator coordinator(layout.value());
+		coordinator.run();
+
+		return EXIT_SUCCESS;
+	}
+
+	if (argc > 2 && strcmp(argv[1], "--zone") == 0)
+	{
+		const uint32_t zoneId = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+		const char* coordinatorAddress = argc > 3 ? argv[3] : "127.0.0.1";
+
+		std::shared_ptr<Server::ZoneLink> zoneLink = Server::ZoneLink::join(zoneId, coordinatorAddress, Server::ZoneCoordinator::DEFAULT_PORT);
+
+		if (zoneLink == nullptr)
+			return EXIT_FAILURE;
+
+		const Server::ZoneDefinition& zone = zoneLink->get_zone();
+
+		NetworkHandler server = NetworkHandler::create_host(zone.address.c_str(), zone.clientPort, 10);
+		server.start_ticking(zoneLink);
+
+		return EXIT_SUCCESS;
+	}
+
+	//*--------------------------------------------------------------------------
+	// Clients connecting through gateways:
+	//   Server --behind-gateway                           Only accepts gateways, on port 1250.
+	//   Server --gateway [server address] [client port]   Accepts the clients, defaults to 127.0.0.1 & port 1234.
+	//*
+	if (argc > 1 && strcmp(argv[1], "--gateway") == 0)
+	{
+		const char* serverAddress = argc > 2 ? argv[2] : "127.0.0.1";
+		const uint16_t clientPort = argc > 3 ? static_cast<uint16_t>(std::strtoul(argv[3], nullptr, 10)) : Server::Gateway::DEFAULT_CLIENT_PORT;
+
+		Server::Gateway gateway(serverAddress, Server::GatewayShard::DEFAULT_PORT, clientPort);
+		gateway.run();
+
+		return EXIT_SUCCESS;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--behind-gateway") == 0)
+	{
+		NetworkHandler server = NetworkHandler::create_gateway_host(Server::GatewayShard::DEFAULT_PORT);
+		server.start_ticking();
+
+		return EXIT_SUCCESS;
+	}
+
 	//NetworkHandler server = NetworkHandler::create_host(ipaddress.c_str(), port, 100);
 	NetworkHandler server = NetworkHandler::create_local_host();
 	server.start_ticking();
@@ -18,6 +18,8 @@
 
 #include "Core/Game/Admin/CommandHandler.h"
 
+#include "Core/Network/Replication/ReplicationHandler.h"
+
 #include "Shared/Network/Packets/PacketHandler.hpp"
 
 #include "Shared/Navigation/AStar.hpp"
@@ -34,11 +36,12 @@ void Server::EventHandler::queue_incoming_event(ENetEvent* _event, RefClientInfo
 
 	switch (packetHeader.interpreter)
 	{
-		//TODO: Move these rpcs to a specific handler for immidiate unrelated to game events, e.g logout, ping
-		case e_PacketInterpreter::PACKET_PING:
+		//TODO: Move these rpcs to a specific handler for immidiate unrelated to game events, e.g logout
+		case e_PacketInterpreter::PACKET_SNAPSHOT_ACK:
 		{
-			_clientInfo->bAwaitingPing = false;
-			_clientInfo->ticksSinceLastResponse = 0;
+			Packets::s_SnapshotAck packet;
+			PacketHandler::retrieve_packet_data<Packets::s_SnapshotAck>(packet, _event);
+			g_globals.replicationHandler->acknowledge(static_cast<enet_uint32>(_clientInfo->clientId), packet.sequence);
 		}
 		return;
 
@@ -98,7 +101,7 @@ void Server::EventHandler::queue_incoming_event(ENetEvent* _event, RefClientInfo
 		break;
 	}
 
-	DEVIOUS_EVENT("Received packet from client handle: " << _clientInfo->peer->connectID << " Event Id: " << static_cast<unsigned>(packetHeader.interpreter));
+	DEVIOUS_EVENT("Received packet from client handle: " << _clientInfo->clientId << " Event Id: " << static_cast<unsigned>(packetHeader.interpreter));
 }
 
 void Server::EventHandler::handle_queud_events()
@@ -123,8 +126,6 @@ void Server::EventHandler::handle_queud_events()
 
 void Server::EventHandler::handle_client_specific_packets(RefClientInfo& _client)
 {
-	ENetHost* host = g_globals.networkHandler->get_server_host();
-
 	EventQuery eventQuery; 
 	_client->packetquery->move(&eventQuery);
 
@@ -155,11 +156,10 @@ void Server::EventHandler::handle_client_specific_packets(RefClientInfo& _client
 						response.message     = message->message;
 						response.author      = player->get_shown_name();
 
-						PacketHandler::send_packet_multicast<Packets::s_Message>
+						g_globals.networkHandler->send_packet_multicast<Packets::s_Message>
 						(
 							&response,
-							g_globals.networkHandler->get_server_host(),
-							0,
+							CHANNEL_CHAT,
 							ENET_PACKET_FLAG_RELIABLE
 						);
 					}
@@ -215,6 +215,12 @@ void Server::EventHandler::handle_client_specific_packets(RefClientInfo& _client
 		{
 			auto enttPacket = transform_packet<Packets::s_EntityMovement>(std::move(packet));
 
+			//Every position the walk results in carries the input back, so the client can tell it apart from its older inputs.
+			if (auto player = g_globals.entityHandler->get_entity(_client->clientId); player.has_value())
+			{
+				player.value()->inputSequence = std::max(player.value()->inputSequence, enttPacket->sequence);
+			}
+
 			const bool bReachedDest = g_globals.entityHandler->move_entity_to
 			(
 				_client->clientId, 
@@ -234,6 +240,7 @@ void Server::EventHandler::handle_client_specific_packets(RefClientInfo& _client
 					movementPacket.isRunning = enttPacket->isRunning;
 					movementPacket.x = enttPacket->x;
 					movementPacket.y = enttPacket->y;
+					movementPacket.sequence = enttPacket->sequence;
 				}
 
 				_client->packetquery->queue_packet
@@ -0,0 +1,36 @@
+#include "precomp.h"
+
+#include "Core/Events/Scheduler/ActionScheduler.h"
+
+Server::TimerHandle Server::ActionScheduler::schedule_in(const uint64_t _delayTicks, Action _action)
+{
+	return m_wheel.schedule(_delayTicks, std::move(_action));
+}
+
+Server::TimerHandle Server::ActionScheduler::schedule_at(const uint64_t _tick, Action _action)
+{
+	const uint64_t currentTick = m_wheel.get_current_tick();
+	const uint64_t delay       = _tick > currentTick ? _tick - currentTick : 1;
+
+	return m_wheel.schedule(delay, std::move(_action));
+}
+
+void Server::ActionScheduler::cancel(TimerHandle& _handle)
+{
+	m_wheel.cancel(_handle);
+}
+
+const bool Server::ActionScheduler::is_scheduled(const TimerHandle _handle) const
+{
+	return m_wheel.is_pending(_handle);
+}
+
+const uint64_t Server::ActionScheduler::get_current_tick() const
+{
+	return m_wheel.get_current_tick();
+}
+
+void Server::ActionScheduler::tick()
+{
+	m_wheel.advance();
+}
@@ -0,0 +1,92 @@
+#include "precomp.h"
+
+#include "Core/Events/Timer/TickClock.h"
+
+Server::TickClock::TickClock(const std::chrono::nanoseconds _period, const e_OverrunPolicy _policy) :
+	m_period(_period),
+	m_policy(_policy)
+{
+}
+
+void Server::TickClock::start(const Clock::time_point _now)
+{
+	m_origin     = _now;
+	m_originTick = 0;
+	m_metrics    = TickMetrics();
+}
+
+const bool Server::TickClock::try_advance(const Clock::time_point _now)
+{
+	const Clock::time_point deadline = get_deadline(m_metrics.tick + 1);
+
+	if (_now < deadline)
+		return false;
+
+	const std::chrono::nanoseconds lag = std::chrono::duration_cast<std::chrono::nanoseconds>(_now - deadline);
+
+	m_metrics.tick++;
+	m_metrics.lastLag = lag;
+	m_metrics.maxLag  = std::max(m_metrics.maxLag, lag);
+
+	if (lag < m_period)
+		return true;
+
+	m_metrics.overruns++;
+
+	//*------------------------------------------------------------------------------
+	// Whole periods we're behind on. Catching up leaves them due so they fire right
+	// after this one, but never more than the limit, a server that can't keep up
+	// would otherwise never get out of its backlog.
+	//*
+	const uint64_t behind  = static_cast<uint64_t>(lag / m_period);
+	const uint64_t allowed = m_policy == e_OverrunPolicy::CATCH_UP ? std::min(behind, MAX_CATCH_UP_TICKS) : 0;
+	const uint64_t skipped = behind - allowed;
+
+	if (skipped > 0)
+	{
+		m_metrics.tick         += skipped;
+		m_metrics.skippedTicks += skipped;
+
+		DEVIOUS_WARN("Tick " << m_metrics.tick << " started " << lag.count() / 1000000 << "ms late, skipped " << skipped << " ticks.");
+	}
+
+	return true;
+}
+
+const Server::TickClock::Clock::time_point Server::TickClock::get_next_deadline() const
+{
+	return get_deadline(m_metrics.tick + 1);
+}
+
+void Server::TickClock::set_period(const std::chrono::nanoseconds _period)
+{
+	m_origin     = get_deadline(m_metrics.tick);
+	m_originTick = m_metrics.tick;
+	m_period     = _period;
+}
+
+const std::chrono::nanoseconds Server::TickClock::get_period() const
+{
+	return m_period;
+}
+
+void Server::TickClock::set_overrun_policy(const e_OverrunPolicy _policy)
+{
+	m_policy = _policy;
+}
+
+const Server::e_OverrunPolicy Server::TickClock::get_overrun_policy() const
+{
+	return m_policy;
+}
+
+const Server::TickMetrics& Server::TickClock::get_metrics() const
+{
+	return m_metrics;
+}
+
+const Server::TickClock::Clock::time_point Server::TickClock::get_deadline(const uint64_t _tick) const
+{
+	const auto offset = m_period * static_cast<int64_t>(_tick - m_originTick);
+	return m_origin + std::chrono::duration_cast<Clock::duration>(offset);
+}
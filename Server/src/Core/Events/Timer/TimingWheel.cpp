@@ -0,0 +1,189 @@
+#include "precomp.h"
+
+#include "Core/Events/Timer/TimingWheel.h"
+
+Server::TimerHandle Server::TimingWheel::schedule(const uint64_t _delayTicks, Callback _callback)
+{
+	uint32_t index;
+
+	//*-------------------------------------------
+	// Reuse a released timer if there's any left.
+	//*
+	if (m_freeList.size() > 0)
+	{
+		index = m_freeList.back();
+		m_freeList.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(m_timers.size());
+		m_timers.emplace_back();
+	}
+
+	Timer& timer     = m_timers[index];
+	timer.expiry     = m_currentTick + std::max<uint64_t>(_delayTicks, 1);
+	timer.bIsPending = true;
+	timer.callback   = std::move(_callback);
+
+	m_pendingCount++;
+
+	const TimerHandle handle = make_handle(index, timer.generation);
+	insert(handle);
+
+	return handle;
+}
+
+void Server::TimingWheel::cancel(TimerHandle& _handle)
+{
+	if (Timer* timer = resolve(_handle); timer != nullptr)
+	{
+		const uint32_t index = static_cast<uint32_t>(_handle & 0xFFFFFFFF) - 1;
+
+		timer->bIsPending = false;
+		timer->callback   = nullptr;
+		timer->generation++;
+
+		m_freeList.push_back(index);
+		m_pendingCount--;
+	}
+
+	//The handle might still be sitting in a slot, it'll get skipped once its slot comes around.
+	_handle = INVALID_HANDLE;
+}
+
+const bool Server::TimingWheel::is_pending(const TimerHandle _handle) const
+{
+	return resolve(_handle) != nullptr;
+}
+
+void Server::TimingWheel::advance()
+{
+	m_currentTick++;
+
+	//*------------------------------------------------------------------------
+	// Whenever a lower level wraps around, pull the next slot of the level above
+	// down. Start at the highest level so timers can fall through multiple levels.
+	//*
+	for (uint32_t level = LEVEL_COUNT - 1; level > 0; level--)
+	{
+		const uint32_t shift = SLOT_BITS * level;
+		const uint64_t mask  = (static_cast<uint64_t>(1) << shift) - 1;
+
+		if ((m_currentTick & mask) == 0)
+		{
+			cascade(level, static_cast<uint32_t>((m_currentTick >> shift) & (SLOT_COUNT - 1)));
+		}
+	}
+
+	//*--------------------------------
+	// Fire all timers due in this tick.
+	//*
+	m_expiring.swap(m_levels[0][m_currentTick & (SLOT_COUNT - 1)]);
+
+	for (const TimerHandle handle : m_expiring)
+	{
+		Timer* timer = resolve(handle);
+
+		//Got cancelled after it got inserted.
+		if (timer == nullptr)
+			continue;
+
+		//Timers beyond the range of the wheel get parked, put them back until they're actually due.
+		if (timer->expiry > m_currentTick)
+		{
+			insert(handle);
+			continue;
+		}
+
+		Callback callback = std::move(timer->callback);
+
+		//Release the timer before invoking, the callback is allowed to schedule new timers.
+		{
+			timer->bIsPending = false;
+			timer->callback   = nullptr;
+			timer->generation++;
+
+			m_freeList.push_back(static_cast<uint32_t>(handle & 0xFFFFFFFF) - 1);
+			m_pendingCount--;
+		}
+
+		if (callback)
+		{
+			callback();
+		}
+	}
+
+	m_expiring.clear();
+}
+
+const uint64_t Server::TimingWheel::get_current_tick() const
+{
+	return m_currentTick;
+}
+
+const size_t Server::TimingWheel::get_pending_count() const
+{
+	return m_pendingCount;
+}
+
+void Server::TimingWheel::insert(const TimerHandle _handle)
+{
+	const Timer* timer = resolve(_handle);
+
+	if (timer == nullptr)
+		return;
+
+	constexpr uint64_t MAX_RANGE = (static_cast<uint64_t>(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+	//Anything beyond the range of the wheel gets parked at the furthest reachable tick.
+	const uint64_t delta  = std::min<uint64_t>(timer->expiry > m_currentTick ? timer->expiry - m_currentTick : 0, MAX_RANGE);
+	const uint64_t expiry = m_currentTick + delta;
+
+	uint32_t level = 0;
+
+	while (level < LEVEL_COUNT - 1 && delta >= (static_cast<uint64_t>(1) << (SLOT_BITS * (level + 1))))
+	{
+		level++;
+	}
+
+	const uint32_t slot = static_cast<uint32_t>((expiry >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+	m_levels[level][slot].push_back(_handle);
+}
+
+void Server::TimingWheel::cascade(const uint32_t _level, const uint32_t _slot)
+{
+	Slot timers;
+	timers.swap(m_levels[_level][_slot]);
+
+	for (const TimerHandle handle : timers)
+	{
+		insert(handle);
+	}
+}
+
+Server::TimingWheel::Timer* Server::TimingWheel::resolve(const TimerHandle _handle)
+{
+	return const_cast<Timer*>(static_cast<const TimingWheel*>(this)->resolve(_handle));
+}
+
+const Server::TimingWheel::Timer* Server::TimingWheel::resolve(const TimerHandle _handle) const
+{
+	const uint32_t index      = static_cast<uint32_t>(_handle & 0xFFFFFFFF);
+	const uint32_t generation = static_cast<uint32_t>(_handle >> 32);
+
+	//Indices are stored offset by one so a handle of 0 is never valid.
+	if (index == 0 || index > m_timers.size())
+		return nullptr;
+
+	const Timer& timer = m_timers[index - 1];
+
+	if (!timer.bIsPending || timer.generation != generation)
+		return nullptr;
+
+	return &timer;
+}
+
+Server::TimerHandle Server::TimingWheel::make_handle(const uint32_t _index, const uint32_t _generation)
+{
+	return (static_cast<uint64_t>(_generation) << 32) | static_cast<uint64_t>(_index + 1);
+}
@@ -12,6 +12,14 @@
 
 #include "Core/Network/Connection/ConnectionHandler.h"
 
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Core/Network/NetworkHandler.h"
+
+#include "Core/Game/World/WorldInstance.h"
+
 bool CommandHandler::try_handle_as_command(std::shared_ptr<Player> _player, const std::string& _string)
 {
 	const static std::string commandPrefix = "::";
@@ -295,6 +303,174 @@ bool CommandHandler::try_handle_as_command(std::shared_ptr<Player> _player, cons
 			return true;
 		}
 
+		if(commandArgs[0] == "dormancy" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
+		{
+			Server::RegionSettings& settings = g_globals.entityHandler->get_region_grid().get_settings();
+
+			if (commandArgs.size() > 2)
+			{
+				int32_t radius, interval;
+
+				if (try_parse_as_int(commandArgs[1], radius) && try_parse_as_int(commandArgs[2], interval) && radius >= 0 && interval >= 0)
+				{
+					settings.activeRadius        = radius;
+					settings.dormantTickInterval = static_cast<uint32_t>(interval);
+				}
+				else
+				{
+					_player->whisper("<col=#FF0000>[Server]: Invalid arguments were specified.");
+					return true;
+				}
+			}
+
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Active region radius : " + std::to_string(settings.activeRadius));
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Dormant tick interval : " + std::to_string(settings.dormantTickInterval));
+			return true;
+		}
+
+		if(commandArgs[0] == "replication" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
+		{
+			std::shared_ptr<Server::ReplicationHandler> replication = g_globals.replicationHandler;
+
+			if (commandArgs.size() > 1)
+			{
+				if (commandArgs[1] == "on" || commandArgs[1] == "off")
+				{
+					replication->set_enabled(commandArgs[1] == "on");
+				}
+				else
+				{
+					_player->whisper("<col=#FF0000>[Server]: Invalid arguments were specified.");
+					return true;
+				}
+			}
+
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Snapshot replication : " + std::string(replication->is_enabled() ? "on" : "off"));
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Snapshot sequence : " + std::to_string(replication->get_sequence()));
+
+			if (std::optional<uint64_t> optHandle = g_globals.entityHandler->transpose_player_to_client_handle(_player->uuid); optHandle.has_value())
+			{
+				const uint32_t byteBudget = replication->get_byte_budget(static_cast<enet_uint32>(optHandle.value()));
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Snapshot byte budget : " + std::to_string(byteBudget));
+			}
+			return true;
+		}
+
+		if(commandArgs[0] == "netstats" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
+		{
+			std::shared_ptr<Player> target = _player;
+
+			if (commandArgs.size() > 1)
+			{
+				std::string fullName = commandArgs[1];
+
+				//If there are words to attach back together, do so.
+				for (int32_t i = 2; i < commandArgs.size(); i++)
+				{
+					fullName.append(" ");
+					fullName.append(commandArgs[i]);
+				}
+
+				auto optTarget = g_globals.entityHandler->get_player_by_name(fullName);
+
+				if (!optTarget.has_value())
+				{
+					_player->whisper("<col=#FF0000>[Server]: The player you tried to inspect does not exist.");
+					return true;
+				}
+
+				target = optTarget.value();
+			}
+
+			const enet_uint32 clientHandle = static_cast<enet_uint32>(g_globals.entityHandler->transpose_player_to_client_handle(target->uuid).value());
+
+			if (std::optional<Server::ConnectionStats> optStats = g_globals.telemetryHandler->get_stats(clientHandle); optStats.has_value())
+			{
+				const Server::ConnectionStats& stats = optStats.value();
+
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Connection of : <col=#FF0000>" + target->get_shown_name());
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Round trip time : " + std::to_string(static_cast<int32_t>(stats.roundTripTime)) + "ms (lowest " + std::to_string(stats.lowestRoundTripTime) + "ms)");
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Jitter : " + std::to_string(static_cast<int32_t>(stats.jitter)) + "ms");
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Packet loss : " + std::to_string(static_cast<int32_t>(stats.packetLoss * 100.0f)) + "%");
+				_player->whisper("<col=#FF0000>[Server]: <col=#000000>Sent : " + std::to_string(static_cast<int32_t>(stats.bytesSentPerSecond)) + " B/s, received : " + std::to_string(static_cast<int32_t>(stats.bytesReceivedPerSecond)) + " B/s");
+			}
+
+			return true;
+		}
+
+		if(commandArgs[0] == "tick" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
+		{
+			Server::TickClock& tickClock = g_globals.instance->get_tick_clock();
+
+			if (commandArgs.size() > 1)
+			{
+				int32_t periodMs;
+
+				if (commandArgs[1] == "catchup" || commandArgs[1] == "skip")
+				{
+					tickClock.set_overrun_policy(commandArgs[1] == "catchup" ? Server::e_OverrunPolicy::CATCH_UP : Server::e_OverrunPolicy::SKIP);
+				}
+				else if (try_parse_as_int(commandArgs[1], periodMs) && periodMs > 0)
+				{
+					g_globals.instance->set_tick_period(std::chrono::milliseconds(periodMs));
+				}
+				else
+				{
+					_player->whisper("<col=#FF0000>[Server]: Invalid arguments were specified.");
+					return true;
+				}
+			}
+
+			const Server::TickMetrics& metrics = tickClock.get_metrics();
+
+			const auto toMicroseconds = [](const std::chrono::nanoseconds _duration)
+			{
+				return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(_duration).count());
+			};
+
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Tick : " + std::to_string(metrics.tick) + " every " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(tickClock.get_period()).count()) + "ms");
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Overrun policy : " + std::string(tickClock.get_overrun_policy() == Server::e_OverrunPolicy::CATCH_UP ? "catchup" : "skip"));
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Lag : " + toMicroseconds(metrics.lastLag) + "us (max " + toMicroseconds(metrics.maxLag) + "us)");
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Overruns : " + std::to_string(metrics.overruns) + ", skipped ticks : " + std::to_string(metrics.skippedTicks));
+			return true;
+		}
+
+		if(commandArgs[0] == "instance" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
+		{
+			std::shared_ptr<NetworkHandler> networkHandler = g_globals.networkHandler;
+
+			if (commandArgs.size() > 1)
+			{
+				int32_t instanceId;
+
+				if (commandArgs[1] == "new")
+				{
+					std::shared_ptr<Server::WorldInstance> instance = networkHandler->create_instance();
+					instance->start();
+
+					instanceId = static_cast<int32_t>(instance->get_id());
+				}
+				else if (!try_parse_as_int(commandArgs[1], instanceId) || instanceId < 0 || static_cast<uint32_t>(instanceId) >= networkHandler->get_instance_count())
+				{
+					_player->whisper("<col=#FF0000>[Server]: Invalid arguments were specified.");
+					return true;
+				}
+
+				if (static_cast<uint32_t>(instanceId) != g_globals.instance->get_id())
+				{
+					if (std::optional<uint64_t> optHandle = g_globals.entityHandler->transpose_player_to_client_handle(_player->uuid); optHandle.has_value())
+					{
+						g_globals.connectionHandler->flag_for_transfer(static_cast<enet_uint32>(optHandle.value()), static_cast<uint32_t>(instanceId));
+						_player->whisper("<col=#FF0000>[Server]: <col=#000000>Moving to instance : " + std::to_string(instanceId));
+					}
+					return true;
+				}
+			}
+
+			_player->whisper("<col=#FF0000>[Server]: <col=#000000>Instance : " + std::to_string(g_globals.instance->get_id()) + " of " + std::to_string(networkHandler->get_instance_count()));
+			return true;
+		}
+
 		if(commandArgs[0] == "spawnnpc" && _player->get_player_rights() == Player::e_PlayerRights::Admin)
 		{
 			if (commandArgs.size() > 1)
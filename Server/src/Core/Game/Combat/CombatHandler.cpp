@@ -66,11 +66,11 @@ const bool CombatHandler::engage(std::shared_ptr<Player> _a, std::shared_ptr<Ent
 		// TODO: In the future when we introduce items, we want to make the attack range dependent on attack style and weapons.
 		// For NPC's this would be predefined based on the attack they do.
 		//*      
-		if (_a->tickCounter <= 0)
+		if (_a->can_attack())
 		{
 			const int32_t tempAttackDelayTicks = 2;
 
-			_a->tickCounter = tempAttackDelayTicks;
+			_a->set_attack_delay(tempAttackDelayTicks);
 
 			hit(_a, _b);
 
@@ -114,9 +114,9 @@ const bool CombatHandler::engage(std::shared_ptr<NPC> _a, std::shared_ptr<Entity
 	// TODO: In the future when we introduce items, we want to make the attack range dependent on attack style and weapons.
 	// For NPC's this would be predefined based on the attack they do.
 	//*      
-	if (_a->tickCounter <= 0)
+	if (_a->can_attack())
 	{
-		_a->tickCounter = _a->get_attack_speed();
+		_a->set_attack_delay(_a->get_attack_speed());
 		
 		hit(_a, _b);
 
@@ -156,6 +156,8 @@ void CombatHandler::queue_combat_packet(RefClientInfo _client, DM::Utils::UUID _
 	packet.action      = e_Action::SOFT_ACTION;
 	packet.entityId    = _targetUUID;
 
+	_client->combatTarget = _targetUUID;
+
 	_client->packetquery->queue_packet
 	(
 		std::make_unique<Packets::s_ActionPacket>(packet)
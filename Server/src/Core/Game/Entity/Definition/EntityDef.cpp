@@ -18,6 +18,10 @@
 
 #include "Core/Config/Config.h"
 
+#include "Core/Events/Scheduler/ActionScheduler.h"
+
+#include "Core/Network/Zone/ZoneLink.h"
+
 #include "Shared/Network/Packets/PacketHandler.hpp"
 
 #include "Shared/Utilities/Math.hpp"
@@ -30,16 +34,18 @@ void Entity::hide_entity(const bool _bShouldHide) const
 {
 	m_bHideEntity = _bShouldHide;
 
+	if (g_globals.entityHandler->is_replicated())
+		return;
+
 	Packets::s_HideEntity packet;
 	packet.interpreter = e_PacketInterpreter::PACKET_ENTITY_HIDE;
 	packet.entityId    = uuid;
 	packet.bShouldHide = _bShouldHide;
 
-	PacketHandler::send_packet_multicast<Packets::s_HideEntity>
+	g_globals.networkHandler->send_packet_multicast<Packets::s_HideEntity>
 	(
 		&packet,
-		g_globals.networkHandler->get_server_host(),
-		0,
+		CHANNEL_RELIABLE,
 		ENET_PACKET_FLAG_RELIABLE
 	);
 }
@@ -48,23 +54,38 @@ void Entity::teleport_to(Utilities::ivec2 _destination)
 {
 	position = _destination;
 
+	if (auto optEntity = g_globals.entityHandler->get_entity(uuid); optEntity.has_value())
+	{
+		g_globals.entityHandler->update_entity_region(optEntity.value());
+	}
+
 	Packets::s_TeleportEntity packet;
 	packet.interpreter = e_PacketInterpreter::PACKET_ENTITY_TELEPORT;
 	packet.entityId = uuid;
 	packet.x = _destination.x;
 	packet.y = _destination.y;
 
-	PacketHandler::send_packet_multicast<Packets::s_TeleportEntity>
-	(
-		&packet,
-		g_globals.networkHandler->get_server_host(),
-		0,
-		ENET_PACKET_FLAG_RELIABLE
-	);
+	g_globals.entityHandler->send_position(uuid, PacketHandler::serialize<Packets::s_TeleportEntity>(&packet), CHANNEL_MOVEMENT, ENET_PACKET_FLAG_RELIABLE);
 }
 
 void Entity::hit(std::shared_ptr<Entity> _from, const int32_t _damage)
 {
+	//*-------------------------------------------------------------------
+	// Mirrors are owned by a neighbouring zone, which applies the damage.
+	// The new hitpoints come back with its next mirror.
+	//*
+	if (m_bIsMirror)
+	{
+		broadcast_hit(_from, _damage);
+
+		if (g_globals.zoneLink != nullptr)
+		{
+			g_globals.zoneLink->forward_hit(_from->uuid, uuid, _damage);
+		}
+
+		return;
+	}
+
 	//*----------------
 	// Apply the damage
 	//*
@@ -96,46 +117,57 @@ void Entity::die()
 
 		m_bIsDead = true;
 
-		Packets::s_ActionPacket packet;
-		packet.interpreter = e_PacketInterpreter::PACKET_ENTITY_DEATH;
-		packet.entityId = uuid;
-		PacketHandler::send_packet_multicast<Packets::s_ActionPacket>
-		(
-			&packet, g_globals.networkHandler->get_server_host(),
-			0,
-			0
-		);
-	}
-}
-
-void Entity::update()
-{
-	if(tickCounter > 0) 
-	{
-		tickCounter--;
-	}
-
-	if(m_bIsDead) 
-	{
-		m_respawnTimerElapsed++;
+		if (!g_globals.entityHandler->is_replicated())
+		{
+			Packets::s_ActionPacket packet;
+			packet.interpreter = e_PacketInterpreter::PACKET_ENTITY_DEATH;
+			packet.entityId = uuid;
+			g_globals.networkHandler->send_packet_multicast<Packets::s_ActionPacket>
+			(
+				&packet,
+				CHANNEL_RELIABLE,
+				ENET_PACKET_FLAG_RELIABLE
+			);
+		}
 
-		//*------------------------------------------------------
-		// Hide the NPC when it's past the death transition time.
+		//*---------------------------------------------------------------
+		// Stop updating the entity and schedule everything that follows up
+		// on its death, the entity gets looked up again once it's due in case
+		// it got removed in the meantime.
 		//*
-
-		if (!m_bHideEntity)
 		{
-			if (m_respawnTimerElapsed > m_deathTransitionTime)
+			const DM::Utils::UUID entityId = uuid;
+
+			g_globals.entityHandler->set_entity_ticking(uuid, false, e_TickSuspension::DEAD);
+
+			//Hide the entity when it's past the death transition time.
+			m_hideAction = g_globals.scheduler->schedule_in(m_deathTransitionTime + 1, [entityId]()
 			{
-				hide_entity(true);
-			}
-		}
+				if (auto optEntity = g_globals.entityHandler->get_entity(entityId); optEntity.has_value())
+				{
+					if (!optEntity.value()->is_hidden())
+					{
+						optEntity.value()->hide_entity(true);
+					}
+				}
+			});
 
-		if(m_respawnTimerElapsed >= get_respawn_timer()) 
-		{
-			respawn();
+			m_respawnAction = g_globals.scheduler->schedule_in(std::max<int32_t>(get_respawn_timer(), 1), [entityId]()
+			{
+				if (auto optEntity = g_globals.entityHandler->get_entity(entityId); optEntity.has_value())
+				{
+					optEntity.value()->respawn();
+				}
+			});
 		}
+	}
+}
 
+void Entity::update()
+{
+	//Dead entities wait on their scheduled respawn.
+	if(m_bIsDead) 
+	{
 		return;
 	}
 
@@ -165,6 +197,16 @@ void Entity::set_target(std::shared_ptr<Entity> _entity, bool _bWasInstigated)
 
 }
 
+const bool Entity::can_attack() const
+{
+	return g_globals.scheduler->get_current_tick() >= m_attackReadyTick;
+}
+
+void Entity::set_attack_delay(const int32_t _ticks)
+{
+	m_attackReadyTick = g_globals.scheduler->get_current_tick() + std::max<int32_t>(_ticks, 0);
+}
+
 int Entity::get_attack_range()
 {
 	return 0;
@@ -182,6 +224,10 @@ int32_t Entity::get_respawn_timer()
 
 void Entity::respawn()
 {
+	//Respawning might happen before the death transition has passed.
+	g_globals.scheduler->cancel(m_hideAction);
+	g_globals.scheduler->cancel(m_respawnAction);
+
 	//*
 	// Destroy entity permanently serversided & client sided if the respawn timer is smaller than 1 tick.
 	//*
@@ -196,7 +242,9 @@ void Entity::respawn()
 	//*
 	{
 		m_bIsDead = false;
-		m_respawnTimerElapsed = 0.0f;
+		m_attackReadyTick = 0;
+
+		g_globals.entityHandler->set_entity_ticking(uuid, true, e_TickSuspension::DEAD);
 	}
 
 	//*
@@ -225,15 +273,15 @@ void Entity::respawn()
 	//*
 	// Signal respawn to the client.
 	//*
+	if (!g_globals.entityHandler->is_replicated())
 	{
 		Packets::s_ActionPacket packet;
 		packet.interpreter = e_PacketInterpreter::PACKET_ENTITY_RESPAWN;
 		packet.entityId = uuid;
-		PacketHandler::send_packet_multicast<Packets::s_ActionPacket>
+		g_globals.networkHandler->send_packet_multicast<Packets::s_ActionPacket>
 		(
 			&packet,
-			g_globals.networkHandler->get_server_host(),
-			0,
+			CHANNEL_RELIABLE,
 			ENET_PACKET_FLAG_RELIABLE
 		);
 	}
@@ -260,17 +308,19 @@ void Entity::broadcast_hit(std::shared_ptr<Entity> _from, int32_t _hitAmount) co
 	packet.toEntityId   = uuid;
 	packet.hitAmount    = _hitAmount;
 
-	PacketHandler::send_packet_multicast<Packets::s_EntityHit>
+	g_globals.networkHandler->send_packet_multicast<Packets::s_EntityHit>
 	(
 		&packet,
-		g_globals.networkHandler->get_server_host(),
-		0,
+		CHANNEL_RELIABLE,
 		ENET_PACKET_FLAG_RELIABLE
 	);
 }
 
 void Entity::broadcast_skill(DM::SKILLS::e_skills _skillType) 
 {
+	if (g_globals.entityHandler->is_replicated())
+		return;
+
 	const DM::SKILLS::Skill& skill = skills[_skillType];
 
 	Packets::s_UpdateSkill packet;
@@ -281,11 +331,10 @@ void Entity::broadcast_skill(DM::SKILLS::e_skills _skillType)
 	packet.level        = skill.level;
 	packet.levelBoosted = skill.levelboosted;
 
-	PacketHandler::send_packet_multicast<Packets::s_UpdateSkill>
+	g_globals.networkHandler->send_packet_multicast<Packets::s_UpdateSkill>
 	(
 		&packet,
-		g_globals.networkHandler->get_server_host(),
-		0,
+		CHANNEL_RELIABLE,
 		ENET_PACKET_FLAG_RELIABLE
 	);
 }
@@ -300,6 +349,11 @@ const bool Entity::is_hidden() const
 	return m_bHideEntity;
 }
 
+const bool Entity::is_mirror() const
+{
+	return m_bIsMirror;
+}
+
 /// <summary>
 /// TODO: Replace these with statemachines maybe?
 /// </summary>
@@ -381,13 +435,18 @@ void NPC::set_target(std::shared_ptr<Entity> _entity, bool _bWasInstigated)
 		//*
 		if (_bWasInstigated)
 		{
-			tickCounter = get_attack_speed();
+			set_attack_delay(get_attack_speed());
 		}
 
 		m_target = _entity;
 	}
 }
 
+std::shared_ptr<Entity> NPC::get_target() const
+{
+	return m_target.lock();
+}
+
 int NPC::get_attack_range() 
 {
 	return attackRange;
@@ -415,16 +474,18 @@ const std::string Player::get_shown_name() const
 
 void Player::broadcast_name()
 {
+	if (g_globals.entityHandler->is_replicated())
+		return;
+
 	Packets::s_NameChange packet;
 	packet.entityId = uuid;
 	packet.interpreter = e_PacketInterpreter::PACKET_CHANGE_NAME;
 	packet.name = get_shown_name();
 
-	PacketHandler::send_packet_multicast<Packets::s_NameChange>
+	g_globals.networkHandler->send_packet_multicast<Packets::s_NameChange>
 	(
 		&packet,
-		g_globals.networkHandler->get_server_host(),
-		0,
+		CHANNEL_RELIABLE,
 		ENET_PACKET_FLAG_RELIABLE
 	);
 }
@@ -450,12 +511,12 @@ void Player::whisper(const std::string& _message) const
 		response.message  = _message;
 		response.author   = "";
 
-		PacketHandler::send_packet<Packets::s_Message>
+		g_globals.networkHandler->send_packet<Packets::s_Message>
 		(
 			&response,
 			info->peer,
-			g_globals.networkHandler->get_server_host(),
-			0,
+			clientHandle,
+			CHANNEL_CHAT,
 			ENET_PACKET_FLAG_RELIABLE
 		);
 	}
@@ -10,6 +10,10 @@
 
 #include "Core/Events/Query/EventQuery.h"
 
+#include "Core/Events/Scheduler/ActionScheduler.h"
+
+#include "Core/Network/Replication/ReplicationHandler.h"
+
 #include "Core/Globals/S_Globals.h"
 
 #include "Shared/Network/Packets/PacketHandler.hpp"
@@ -48,6 +52,7 @@ void Server::EntityHandler::register_player(const uint64_t _clientId)
 	m_entities[_clientId]       = std::make_shared<Player>();
 	m_entities[_clientId]->uuid = client->playerId;
 	m_playerToClientHandles[client->playerId] = _clientId;
+	m_tickingChanges.push_back({ m_entities[_clientId], true, e_TickSuspension::NONE });
 	DEVIOUS_EVENT("Player " << _clientId << " has logged in.");
 }
 
@@ -99,6 +104,7 @@ bool Server::EntityHandler::move_entity_to(const EntityUUID _entityId, const Uti
 
 		//Move the Entity.
 		m_entities[_entityId]->position = nextPos;
+		update_entity_region(m_entities[_entityId]);
 
 		//Send packet
 		{
@@ -108,9 +114,13 @@ bool Server::EntityHandler::move_entity_to(const EntityUUID _entityId, const Uti
 				packet.entityId = m_entities[_entityId]->uuid;
 				packet.x = nextPos.x;
 				packet.y = nextPos.y;
+				packet.sequence = m_entities[_entityId]->inputSequence;
+				packet.tick = static_cast<uint32_t>(g_globals.scheduler->get_current_tick());
 			}
 
-			PacketHandler::send_packet_multicast<Packets::s_EntityMovement>(&packet, g_globals.networkHandler->get_server_host(), 0, ENET_PACKET_FLAG_RELIABLE);
+			//Unreliable, a lost position gets corrected by the next one or by the next keyframe.
+			send_position(m_entities[_entityId]->uuid, PacketHandler::serialize<Packets::s_EntityMovement>(&packet), CHANNEL_MOVEMENT, 0);
+			m_keyframesLeft[_entityId] = KEYFRAME_REPEATS;
 		}
 	}
 
@@ -198,9 +208,18 @@ void Server::EntityHandler::create_world_npc(uint8_t npcId, Utilities::ivec2 _po
 	
 	m_npcHandles.push_back(data.uuid);
 
+	//Npc's only tick when a player is near.
+	{
+		std::shared_ptr<Entity> npc = m_entities[data.uuid];
+
+		m_regions.insert(npc);
+		m_tickingChanges.push_back({ npc, m_regions.is_active(npc->m_region), e_TickSuspension::DORMANT });
+	}
+
 	//*------------------------------------------------
 	// Notice to clients that a new entity has spawned.
 	//*
+	if (!is_replicated())
 	{
 		Packets::s_CreateEntity packet;
 		packet.interpreter = e_PacketInterpreter::PACKET_CREATE_ENTITY;
@@ -209,16 +228,57 @@ void Server::EntityHandler::create_world_npc(uint8_t npcId, Utilities::ivec2 _po
 		packet.posX = _pos.x;
 		packet.posY = _pos.y;
 
-		PacketHandler::send_packet_multicast<Packets::s_CreateEntity>
+		g_globals.networkHandler->send_packet_multicast<Packets::s_CreateEntity>
 		(
 			&packet,
-			g_globals.networkHandler->get_server_host(),
-			0,
+			CHANNEL_RELIABLE,
 			ENET_PACKET_FLAG_RELIABLE
 		);
 	}
 }
 
+void Server::EntityHandler::add_mirror(std::shared_ptr<Entity> _entity)
+{
+	if (m_entities.find(_entity->uuid) != m_entities.end())
+	{
+		DEVIOUS_WARN("Can't mirror entity " << _entity->uuid << ", an entity already exists with this uuid.");
+		return;
+	}
+
+	_entity->m_bIsMirror = true;
+
+	m_entities[_entity->uuid] = _entity;
+	m_mirrors.insert(_entity->uuid);
+}
+
+void Server::EntityHandler::remove_mirror(DM::Utils::UUID _uuid)
+{
+	if (m_mirrors.erase(_uuid) > 0)
+	{
+		m_entities.erase(_uuid);
+
+		//A pending removal would otherwise hit whatever takes the place of the mirror.
+		m_toRemove.erase(std::remove(m_toRemove.begin(), m_toRemove.end(), _uuid), m_toRemove.end());
+	}
+}
+
+void Server::EntityHandler::adopt_npc(std::shared_ptr<NPC> _npc)
+{
+	_npc->m_bIsMirror = false;
+
+	m_entities[_npc->uuid] = _npc;
+
+	//Npc's that wander back & forth over the border already have a handle from the last time they were here.
+	if (std::find(m_npcHandles.begin(), m_npcHandles.end(), _npc->uuid) == m_npcHandles.end())
+	{
+		m_npcHandles.push_back(_npc->uuid);
+	}
+
+	//Same as a freshly spawned npc, it only ticks when a player is near.
+	m_regions.insert(_npc);
+	m_tickingChanges.push_back({ _npc, m_regions.is_active(_npc->m_region), e_TickSuspension::DORMANT });
+}
+
 const std::vector<std::shared_ptr<NPC>> Server::EntityHandler::get_world_npcs()
 {
 	std::vector<std::shared_ptr<NPC>> npcs;
@@ -304,32 +364,242 @@ void Server::EntityHandler::destroy_entity(DM::Utils::UUID _uuid)
 	m_toRemove.push_back(_uuid);
 }
 
+void Server::EntityHandler::set_entity_ticking(DM::Utils::UUID _uuid, const bool _bShouldTick, const e_TickSuspension _reason)
+{
+	if (auto optEntity = get_entity(_uuid); optEntity.has_value())
+	{
+		m_tickingChanges.push_back({ optEntity.value(), _bShouldTick, _reason });
+	}
+}
+
+void Server::EntityHandler::update_entity_region(std::shared_ptr<Entity> _entity)
+{
+	if (m_regions.relocate(_entity))
+	{
+		m_tickingChanges.push_back({ _entity, m_regions.is_active(_entity->m_region), e_TickSuspension::DORMANT });
+	}
+}
+
+Server::RegionGrid& Server::EntityHandler::get_region_grid()
+{
+	return m_regions;
+}
+
+const bool Server::EntityHandler::is_replicated() const
+{
+	return g_globals.replicationHandler != nullptr && g_globals.replicationHandler->is_enabled();
+}
+
+void Server::EntityHandler::send_position(const EntityUUID _uuid, const std::string& _data, const uint8_t _channel, const enet_uint32 _flags)
+{
+	if (!is_replicated())
+	{
+		g_globals.networkHandler->send_data_multicast(_data, _channel, _flags);
+		return;
+	}
+
+	const auto it = m_playerToClientHandles.find(_uuid);
+
+	if (it == m_playerToClientHandles.end())
+		return;
+
+	if (RefClientInfo clientInfo = g_globals.connectionHandler->get_client_info(static_cast<enet_uint32>(it->second)); clientInfo != nullptr)
+	{
+		g_globals.networkHandler->send_data(clientInfo->peer, static_cast<enet_uint32>(it->second), _data, _channel, _flags);
+	}
+}
+
+void Server::EntityHandler::apply_ticking(std::shared_ptr<Entity> _entity, const bool _bShouldTick, const e_TickSuspension _reason)
+{
+	if (_bShouldTick)
+	{
+		_entity->m_tickSuspension &= ~static_cast<uint8_t>(_reason);
+	}
+	else
+	{
+		_entity->m_tickSuspension |= static_cast<uint8_t>(_reason);
+	}
+
+	link_ticking(_entity, _entity->m_tickSuspension == 0);
+}
+
+void Server::EntityHandler::link_ticking(std::shared_ptr<Entity> _entity, const bool _bShouldTick)
+{
+	const bool bIsTicking = _entity->m_tickIndex != SIZE_MAX;
+
+	if (_bShouldTick && !bIsTicking)
+	{
+		_entity->m_tickIndex = m_tickingEntities.size();
+		m_tickingEntities.push_back(_entity);
+	}
+	else if (!_bShouldTick && bIsTicking)
+	{
+		//Swap the last ticking entity into the place of the one that's being removed.
+		const size_t index = _entity->m_tickIndex;
+
+		m_tickingEntities[index] = m_tickingEntities.back();
+		m_tickingEntities[index]->m_tickIndex = index;
+		m_tickingEntities.pop_back();
+
+		_entity->m_tickIndex = SIZE_MAX;
+	}
+}
+
+void Server::EntityHandler::update_dormancy()
+{
+	m_regionObservers.clear();
+	m_wokenRegions.clear();
+	m_dormantRegions.clear();
+
+	for (const auto& [playerId, clientHandle] : m_playerToClientHandles)
+	{
+		if (auto it = m_entities.find(clientHandle); it != m_entities.end())
+		{
+			m_regionObservers.push_back(it->second->position);
+		}
+	}
+
+	//Players across the border can still fight the npc's of this zone.
+	for (const EntityUUID mirrorId : m_mirrors)
+	{
+		if (auto it = m_entities.find(mirrorId); it != m_entities.end() && std::dynamic_pointer_cast<Player>(it->second) != nullptr)
+		{
+			m_regionObservers.push_back(it->second->position);
+		}
+	}
+
+	m_regions.update_active_regions(m_regionObservers, m_wokenRegions, m_dormantRegions);
+
+	for (const Utilities::ivec2& region : m_wokenRegions)
+	{
+		for (const std::shared_ptr<Entity>& entity : m_regions.get_entities(region))
+		{
+			m_tickingChanges.push_back({ entity, true, e_TickSuspension::DORMANT });
+		}
+	}
+
+	//Nobody is around anymore to fight, so let go of any target.
+	for (const Utilities::ivec2& region : m_dormantRegions)
+	{
+		for (const std::shared_ptr<Entity>& entity : m_regions.get_entities(region))
+		{
+			entity->disengage();
+			m_tickingChanges.push_back({ entity, false, e_TickSuspension::DORMANT });
+		}
+	}
+}
+
+void Server::EntityHandler::tick_dormant_entities()
+{
+	const uint32_t interval = m_regions.get_settings().dormantTickInterval;
+
+	if (interval == 0 || g_globals.scheduler->get_current_tick() % interval != 0)
+		return;
+
+	//*------------------------------------------------------------------------
+	// Gather first, updating might move entities between regions.
+	// Only entities that are solely suspended for being dormant get updated.
+	//*
+	m_dormantTicking.clear();
+
+	for (const Utilities::ivec2& region : m_regions.get_dormant_regions())
+	{
+		for (const std::shared_ptr<Entity>& entity : m_regions.get_entities(region))
+		{
+			if (entity->m_tickSuspension == static_cast<uint8_t>(e_TickSuspension::DORMANT))
+			{
+				m_dormantTicking.push_back(entity);
+			}
+		}
+	}
+
+	for (const std::shared_ptr<Entity>& entity : m_dormantTicking)
+	{
+		entity->update();
+	}
+}
+
 void Server::EntityHandler::tick()
 {
+	update_dormancy();
+
+	for (auto& [entity, bShouldTick, reason] : m_tickingChanges)
+	{
+		apply_ticking(entity, bShouldTick, reason);
+	}
+
+	m_tickingChanges.clear();
+
 	for (DM::Utils::UUID enttId : m_toRemove)
 	{
 		if (m_entities.find(enttId) != m_entities.end())
 		{
-			Packets::s_CreateEntity playerData;
-			playerData.interpreter = e_PacketInterpreter::PACKET_REMOVE_ENTITY;
-			playerData.entityId    = m_entities[enttId]->uuid;
+			link_ticking(m_entities[enttId], false);
+			m_regions.remove(m_entities[enttId]);
 
-			PacketHandler::send_packet_multicast<Packets::s_CreateEntity>
-			(
-				&playerData,
-				g_globals.networkHandler->get_server_host(),
-				0,
-				ENET_PACKET_FLAG_RELIABLE
-			);
+			if (!is_replicated())
+			{
+				Packets::s_CreateEntity playerData;
+				playerData.interpreter = e_PacketInterpreter::PACKET_REMOVE_ENTITY;
+				playerData.entityId    = m_entities[enttId]->uuid;
+
+				g_globals.networkHandler->send_packet_multicast<Packets::s_CreateEntity>
+				(
+					&playerData,
+					CHANNEL_RELIABLE,
+					ENET_PACKET_FLAG_RELIABLE
+				);
+			}
 
 			m_entities.erase(enttId);
+			m_mirrors.erase(enttId);
 		}
 	}
 
 	m_toRemove.clear();
 
-	for(const auto&[uuid, entity] : m_entities) 
+	//Entities that stop ticking this cycle only get removed next cycle, so indexing stays valid.
+	for(size_t i = 0; i < m_tickingEntities.size(); i++) 
 	{
-		entity->update();
+		m_tickingEntities[i]->update();
+	}
+
+	tick_dormant_entities();
+
+	send_movement_keyframes();
+}
+
+void Server::EntityHandler::send_movement_keyframes()
+{
+	if (g_globals.scheduler->get_current_tick() % KEYFRAME_TICK_INTERVAL != 0)
+		return;
+
+	//*-------------------------------------------------------------------------
+	// Resend the position of everything that moved lately, so clients that lost
+	// any of the unreliable ones catch up. Keyframes go out unreliable over the
+	// movement channel, a lost one never holds up the positions after it and
+	// the next keyframe of the entity repeats it.
+	//*
+	for (auto it = m_keyframesLeft.begin(); it != m_keyframesLeft.end();)
+	{
+		const auto entityIt = m_entities.find(it->first);
+
+		const bool bIsLastKeyframe = entityIt == m_entities.end() || --it->second == 0;
+		it = bIsLastKeyframe ? m_keyframesLeft.erase(it) : std::next(it);
+
+		if (entityIt == m_entities.end())
+			continue;
+
+		const std::shared_ptr<Entity>& entity = entityIt->second;
+
+		Packets::s_EntityMovement packet;
+		packet.interpreter = e_PacketInterpreter::PACKET_MOVE_ENTITY;
+		packet.entityId    = entity->uuid;
+		packet.x           = entity->position.x;
+		packet.y           = entity->position.y;
+		packet.sequence    = entity->inputSequence;
+		packet.tick        = static_cast<uint32_t>(g_globals.scheduler->get_current_tick());
+
+		send_position(entity->uuid, PacketHandler::serialize<Packets::s_EntityMovement>(&packet), CHANNEL_MOVEMENT, 0);
 	}
 }
@@ -0,0 +1,152 @@
+#include "precomp.h"
+
+#include "Core/Game/World/RegionGrid.h"
+
+#include "Core/Game/Entity/Definition/EntityDef.h"
+
+const Utilities::ivec2 Server::RegionGrid::get_region(const Utilities::ivec2 _position)
+{
+	//Round towards negative infinity so negative coordinates don't share region 0.
+	const auto floor_div = [](const int32_t _value)
+	{
+		return _value >= 0 ? _value / REGION_SIZE : (_value - REGION_SIZE + 1) / REGION_SIZE;
+	};
+
+	return Utilities::ivec2(floor_div(_position.x), floor_div(_position.y));
+}
+
+void Server::RegionGrid::insert(std::shared_ptr<Entity> _entity)
+{
+	if (contains(_entity))
+		return;
+
+	const Utilities::ivec2 region = get_region(_entity->position);
+	Bucket& bucket = m_regions[region];
+
+	if (bucket.empty() && !is_active(region))
+	{
+		m_dormantRegions.insert(region);
+	}
+
+	_entity->m_region      = region;
+	_entity->m_regionIndex = bucket.size();
+
+	bucket.push_back(_entity);
+}
+
+void Server::RegionGrid::remove(std::shared_ptr<Entity> _entity)
+{
+	if (!contains(_entity))
+		return;
+
+	Bucket& bucket = m_regions[_entity->m_region];
+
+	//Swap the last entity of the region into the place of the one that's being removed.
+	{
+		const size_t index = _entity->m_regionIndex;
+
+		bucket[index] = bucket.back();
+		bucket[index]->m_regionIndex = index;
+		bucket.pop_back();
+	}
+
+	if (bucket.size() == 0)
+	{
+		m_regions.erase(_entity->m_region);
+		m_dormantRegions.erase(_entity->m_region);
+	}
+
+	_entity->m_regionIndex = SIZE_MAX;
+}
+
+const bool Server::RegionGrid::relocate(std::shared_ptr<Entity> _entity)
+{
+	if (!contains(_entity) || get_region(_entity->position) == _entity->m_region)
+		return false;
+
+	remove(_entity);
+	insert(_entity);
+
+	return true;
+}
+
+const bool Server::RegionGrid::contains(std::shared_ptr<Entity> _entity) const
+{
+	return _entity->m_regionIndex != SIZE_MAX;
+}
+
+const bool Server::RegionGrid::is_active(const Utilities::ivec2 _region) const
+{
+	return m_activeRegions.find(_region) != m_activeRegions.end();
+}
+
+void Server::RegionGrid::update_active_regions(const std::vector<Utilities::ivec2>& _observers, std::vector<Utilities::ivec2>& _woken, std::vector<Utilities::ivec2>& _dormant)
+{
+	const int32_t radius = std::max<int32_t>(m_settings.activeRadius, 0);
+
+	m_nextActiveRegions.clear();
+
+	for (const Utilities::ivec2& observer : _observers)
+	{
+		const Utilities::ivec2 center = get_region(observer);
+
+		for (int32_t y = -radius; y <= radius; y++)
+		{
+			for (int32_t x = -radius; x <= radius; x++)
+			{
+				m_nextActiveRegions.insert(center + Utilities::ivec2(x, y));
+			}
+		}
+	}
+
+	//*----------------------------------------------------------
+	// Compare against the previous active regions, only regions
+	// around players get visited so dormant regions cost nothing.
+	//*
+	for (const Utilities::ivec2& region : m_nextActiveRegions)
+	{
+		if (m_activeRegions.find(region) == m_activeRegions.end())
+		{
+			_woken.push_back(region);
+			m_dormantRegions.erase(region);
+		}
+	}
+
+	for (const Utilities::ivec2& region : m_activeRegions)
+	{
+		if (m_nextActiveRegions.find(region) == m_nextActiveRegions.end())
+		{
+			_dormant.push_back(region);
+
+			if (m_regions.find(region) != m_regions.end())
+			{
+				m_dormantRegions.insert(region);
+			}
+		}
+	}
+
+	m_activeRegions.swap(m_nextActiveRegions);
+}
+
+const Server::RegionGrid::Bucket& Server::RegionGrid::get_entities(const Utilities::ivec2 _region) const
+{
+	static const Bucket empty;
+
+	const auto it = m_regions.find(_region);
+	return it == m_regions.end() ? empty : it->second;
+}
+
+const std::unordered_map<Utilities::ivec2, Server::RegionGrid::Bucket>& Server::RegionGrid::get_regions() const
+{
+	return m_regions;
+}
+
+const std::unordered_set<Utilities::ivec2>& Server::RegionGrid::get_dormant_regions() const
+{
+	return m_dormantRegions;
+}
+
+Server::RegionSettings& Server::RegionGrid::get_settings()
+{
+	return m_settings;
+}
@@ -5,12 +5,17 @@
 #include "Core/Game/World/NPCWorldSpawn.h"
 #include "Core/Game/Entity/EntityHandler.h"
 #include "Core/Globals/S_Globals.h"
+#include "Core/Network/Zone/ZoneLink.h"
 
 void Server::World::init()
 {
 	//Load in all Static World Entities.
 	for (const NPCSpawn& spawn : get_world_spawns())
 	{
+		//Every zone only spawns the npc's within its own bounds.
+		if (g_globals.zoneLink != nullptr && !g_globals.zoneLink->get_zone().contains(spawn.spawnCoords))
+			continue;
+
 		//TODO: Handle respawning
 		g_globals.entityHandler->create_world_npc(spawn.npcId, spawn.spawnCoords, spawn.ticksTillRespawn);
 		DEVIOUS_EVENT("Spawned NPC ID: " << spawn.npcId << " into the world at: " << spawn.spawnCoords.x << ", " << spawn.spawnCoords.y << ".")
@@ -0,0 +1,195 @@
+#include "precomp.h"
+
+#include "Core/Game/World/WorldInstance.h"
+
+#include "Core/Network/NetworkHandler.h"
+
+#include "Core/Network/Connection/ConnectionHandler.h"
+
+#include "Core/Network/Client/ClientInfo.h"
+
+#include "Core/Network/Ingress/IngressShard.h"
+
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Core/Network/Zone/ZoneLink.h"
+
+#include "Core/Game/Entity/EntityHandler.h"
+
+#include "Core/Game/World/World.h"
+
+#include "Core/Events/Handler/EventHandler.h"
+
+#include "Core/Events/Scheduler/ActionScheduler.h"
+
+#include "Core/Globals/S_Globals.h"
+
+Server::WorldInstance::WorldInstance(const uint32_t _id, std::shared_ptr<NetworkHandler> _networkHandler) :
+	m_id(_id),
+	m_networkHandler(_networkHandler),
+	m_connectionHandler(std::make_shared<ConnectionHandler>()),
+	m_entityHandler(std::make_shared<EntityHandler>()),
+	m_world(std::make_shared<World>()),
+	m_scheduler(std::make_shared<ActionScheduler>()),
+	m_replicationHandler(std::make_shared<ReplicationHandler>()),
+	m_telemetryHandler(std::make_shared<TelemetryHandler>())
+{
+}
+
+Server::WorldInstance::~WorldInstance()
+{
+	stop();
+}
+
+void Server::WorldInstance::start()
+{
+	m_bIsRunning = true;
+	m_thread = std::thread(&WorldInstance::run, this);
+}
+
+void Server::WorldInstance::run()
+{
+	m_bIsRunning = true;
+
+	bind_globals();
+
+	m_world->init();
+
+	DEVIOUS_EVENT("World instance " << m_id << " started ticking.");
+
+	std::vector<IngressEvent> events;
+
+	m_tickClock.start(Clock::now());
+
+	while (m_bIsRunning)
+	{
+		m_reactor.wait_until(m_tickClock.get_next_deadline());
+
+		//*------------------------------------------------------------------------
+		// Tick, when the instance fell behind the clock leaves the missed deadlines
+		// due and the next passes run them straight away.
+		//*
+		if (!m_tickClock.try_advance(Clock::now()))
+			continue;
+
+		//Collect everything the clients of this instance sent since the last tick.
+		m_networkHandler->collect_events(m_id, events);
+
+		handle_events(events);
+		events.clear();
+
+		tick();
+	}
+}
+
+void Server::WorldInstance::stop()
+{
+	m_bIsRunning = false;
+	m_reactor.wake();
+
+	if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+	{
+		m_thread.join();
+	}
+}
+
+const uint32_t Server::WorldInstance::get_id() const
+{
+	return m_id;
+}
+
+Server::TickClock& Server::WorldInstance::get_tick_clock()
+{
+	return m_tickClock;
+}
+
+const uint32_t Server::WorldInstance::get_tick_period_ms() const
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(m_tickClock.get_period()).count());
+}
+
+void Server::WorldInstance::set_tick_period(const std::chrono::milliseconds _period)
+{
+	m_tickClock.set_period(_period);
+
+	Packets::s_TickPeriod packet;
+	packet.interpreter = e_PacketInterpreter::PACKET_TICK_PERIOD;
+	packet.period      = get_tick_period_ms();
+
+	m_networkHandler->send_packet_multicast<Packets::s_TickPeriod>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+}
+
+void Server::WorldInstance::set_zone_link(std::shared_ptr<ZoneLink> _zoneLink)
+{
+	m_zoneLink = _zoneLink;
+}
+
+void Server::WorldInstance::bind_globals()
+{
+	g_globals.connectionHandler  = m_connectionHandler;
+	g_globals.entityHandler      = m_entityHandler;
+	g_globals.networkHandler     = m_networkHandler;
+	g_globals.world              = m_world;
+	g_globals.scheduler          = m_scheduler;
+	g_globals.replicationHandler = m_replicationHandler;
+	g_globals.telemetryHandler   = m_telemetryHandler;
+	g_globals.instance           = shared_from_this();
+	g_globals.zoneLink           = m_zoneLink;
+}
+
+void Server::WorldInstance::handle_events(std::vector<IngressEvent>& _events)
+{
+	for (IngressEvent& event : _events)
+	{
+		ENetEvent& e = event.event;
+
+		switch (e.type)
+		{
+			//Also received when a client gets transferred to this instance, clients redirected by another zone connect with their handoff token.
+			case ENET_EVENT_TYPE_CONNECT:
+			{
+				m_connectionHandler->register_client(e.peer, event.clientHandle, e.data);
+			}
+			break;
+
+			//Also received once ENet times out a peer that stopped responding.
+			case ENET_EVENT_TYPE_DISCONNECT:
+			{
+				m_connectionHandler->disconnect_client(event.clientHandle);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				//Clients that got transferred away can still have packets on their way to us.
+				if (RefClientInfo clientInfo = m_connectionHandler->get_client_info(event.clientHandle); clientInfo != nullptr)
+				{
+					EventHandler::queue_incoming_event(&e, clientInfo);
+				}
+
+				enet_packet_destroy(e.packet);
+			}
+			break;
+		}
+	}
+}
+
+void Server::WorldInstance::tick()
+{
+	m_scheduler->tick();
+	EventHandler::handle_queud_events();
+	m_connectionHandler->update_idle_timers();
+	m_connectionHandler->transfer_flagged_clients();
+	m_entityHandler->tick();
+
+	if (m_zoneLink != nullptr)
+	{
+		m_zoneLink->tick();
+	}
+
+	m_connectionHandler->send_join_snapshots();
+	m_telemetryHandler->tick();
+	m_replicationHandler->tick();
+}
@@ -4,14 +4,17 @@
 
 #include "Core/Events/Query/EventQuery.h"
 
+#include "Core/Network/Connection/ConnectionHandler.h"
+
+#include "Core/Globals/S_Globals.h"
+
 
 ClientInfo::ClientInfo()
 {
 	peer		  = nullptr;
 	playerId      = 0;
-	idleticks     = 0;
+	handleIndex   = 0;
 	clientId      = 0;
-	bAwaitingPing = false;
 	packetquery   = nullptr; 
 }
 
@@ -23,7 +26,5 @@ ClientInfo::~ClientInfo()
 
 void ClientInfo::refresh()
 {
-	bAwaitingPing = false;
-	ticksSinceLastResponse = 0;
-	idleticks = 0;
+	g_globals.connectionHandler->register_activity(*this);
 }
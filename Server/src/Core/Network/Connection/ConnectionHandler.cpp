@@ -12,78 +12,117 @@
 
 #include "Core/Events/Query/EventQuery.h"
 
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Core/Network/Zone/ZoneLink.h"
+
+#include "Core/Game/World/WorldInstance.h"
+
 #include "Core/Config/Config.h"
 
 #include "Core/Globals/S_Globals.h"
 
 #include <enet/enet.h>
 
+#include <chrono>
+
 void Server::ConnectionHandler::update_idle_timers()
 {
-	ENetHost* server = g_globals.networkHandler->get_server_host();
+	//Fires all deadlines that are due this tick, timed out clients get pushed onto the pending disconnects.
+	m_idleTimers.advance();
 
-	for (auto& pair : m_clientInfo)
+	//Disconnect all timed out client handles.
+	if(m_pendingDisconnects.size() > 0)
 	{
-		RefClientInfo clientInfo = pair.second;
-		uint32_t ticks = clientInfo->idleticks++;
-
-		//Either send the player a warning with the amount of ticks he's been inactive 
-		//or completely disconnect the player.
-		if(ticks == TICKS_TILL_TIMEOUT_WARNING) 
+		for (enet_uint32 clientHandle : m_pendingDisconnects)
 		{
-			Packets::s_PacketHeader packet;
-			packet.interpreter = e_PacketInterpreter::PACKET_TIMEOUT_WARNING;
-			PacketHandler::send_packet<Packets::s_PacketHeader>(&packet, clientInfo->peer, server, 0, ENET_PACKET_FLAG_RELIABLE);
+			disconnect_client(clientHandle);
 		}
-		else if(ticks >= TICKS_TILL_TIMEOUT) 
+
+		m_pendingDisconnects.clear();
+	}
+}
+
+void Server::ConnectionHandler::register_activity(ClientInfo& _client)
+{
+	//*-----------------------------------------------------------------------
+	// Active clients send packets nearly every tick, re-scheduling their
+	// deadlines every time would leave a cancelled handle behind in the
+	// wheel for hours. The deadlines catch up on the activity once they fire.
+	//*
+	_client.lastActivityTick = m_idleTimers.get_current_tick();
+}
+
+void Server::ConnectionHandler::arm_warning_timer(ClientInfo& _client, const uint64_t _delayTicks)
+{
+	const enet_uint32 clientHandle = static_cast<enet_uint32>(_client.clientId);
+
+	//Send the player a warning once he's been inactive for a long time.
+	_client.warningTimer = m_idleTimers.schedule(_delayTicks, [this, clientHandle]()
+	{
+		RefClientInfo clientInfo = get_client_info(clientHandle);
+
+		if (clientInfo == nullptr)
+			return;
+
+		const uint64_t idleTicks = m_idleTimers.get_current_tick() - clientInfo->lastActivityTick;
+
+		if (idleTicks < TICKS_TILL_TIMEOUT_WARNING)
 		{
-			m_pendingDisconnects.push_back(static_cast<enet_uint32>(clientInfo->clientId));
-			DEVIOUS_LOG("Registered client: " << clientInfo->clientId << " for disconnect.");
-			continue;
+			arm_warning_timer(*clientInfo, TICKS_TILL_TIMEOUT_WARNING - idleTicks);
+			return;
 		}
 
-		//Checks whether the client needs to have a ping sent out to check if the client is still in a position to get reached.
-		//
-		//
-		if(!clientInfo->bAwaitingPing) 
+		if (clientInfo->warnedActivityTick != clientInfo->lastActivityTick)
 		{
-			if((ticks % PING_TICK_INTERVAL == 0 && ticks > 0) || !clientInfo->peer) 
-			{
-				clientInfo->bAwaitingPing = true;
+			clientInfo->warnedActivityTick = clientInfo->lastActivityTick;
 
-				Packets::s_PacketHeader packet;
-				packet.interpreter = e_PacketInterpreter::PACKET_PING;
-				PacketHandler::send_packet<Packets::s_PacketHeader>(&packet, clientInfo->peer, server, 0, ENET_PACKET_FLAG_RELIABLE);
-			}
+			Packets::s_PacketHeader packet;
+			packet.interpreter = e_PacketInterpreter::PACKET_TIMEOUT_WARNING;
+			g_globals.networkHandler->send_packet<Packets::s_PacketHeader>(&packet, clientInfo->peer, clientHandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
 		}
-		else
-		{
-			clientInfo->ticksSinceLastResponse++;
 
-			if (clientInfo->ticksSinceLastResponse >= MAX_TICK_INTERVAL_NO_RESPONSE)
-			{
-				DEVIOUS_LOG("Couldnt retrieve any sign of connection from " << clientInfo->clientId << ". Disconnecting...");
-				m_pendingDisconnects.push_back((enet_uint32)clientInfo->clientId);
-				continue;
-			}
-		}
-	}
+		//Checks back in time to warn the client about its next idle period.
+		arm_warning_timer(*clientInfo, TICKS_TILL_TIMEOUT_WARNING);
+	});
+}
 
-	//Disconnect all timed out client handles.
-	if(m_pendingDisconnects.size() > 0)
+void Server::ConnectionHandler::arm_timeout_timer(ClientInfo& _client, const uint64_t _delayTicks)
+{
+	const enet_uint32 clientHandle = static_cast<enet_uint32>(_client.clientId);
+
+	//Completely disconnect the player once he's been inactive for too long.
+	_client.timeoutTimer = m_idleTimers.schedule(_delayTicks, [this, clientHandle]()
 	{
-		for (enet_uint32 clientHandle : m_pendingDisconnects)
+		RefClientInfo clientInfo = get_client_info(clientHandle);
+
+		if (clientInfo == nullptr)
+			return;
+
+		const uint64_t idleTicks = m_idleTimers.get_current_tick() - clientInfo->lastActivityTick;
+
+		if (idleTicks < TICKS_TILL_TIMEOUT)
 		{
-			disconnect_client(clientHandle);
+			arm_timeout_timer(*clientInfo, TICKS_TILL_TIMEOUT - idleTicks);
+			return;
 		}
 
-		m_pendingDisconnects.clear();
-	}
+		m_pendingDisconnects.push_back(clientHandle);
+		DEVIOUS_LOG("Registered client: " << clientHandle << " for disconnect.");
+	});
 }
 
-void Server::ConnectionHandler::register_client(ENetPeer* _peer)
+void Server::ConnectionHandler::cancel_idle_timers(ClientInfo& _client)
 {
-	const enet_uint32 clientId = _peer->connectID;
+	m_idleTimers.cancel(_client.warningTimer);
+	m_idleTimers.cancel(_client.timeoutTimer);
+}
+
+void Server::ConnectionHandler::register_client(ENetPeer* _peer, const enet_uint32 _clienthandle, const enet_uint32 _connectData)
+{
+	const enet_uint32 clientId = _clienthandle;
 
 	if (m_clientInfo.find(clientId) != m_clientInfo.end())
 	{
@@ -91,24 +130,36 @@ void Server::ConnectionHandler::register_client(ENetPeer* _peer)
 		return;
 	}
 
+	//The state of a player that walked over from a neighbouring zone.
+	std::optional<Packets::s_ZoneEntity> handoff;
+
+	if (_connectData != 0 && g_globals.zoneLink != nullptr)
+	{
+		handoff = g_globals.zoneLink->claim_handoff(_connectData);
+	}
+
 	RefClientInfo newClient = std::make_shared<ClientInfo>();
 	newClient->peer = _peer;
 	newClient->clientId = (uint64_t)clientId;
-	newClient->playerId = DM::Utils::UUID::generate();
-	newClient->bAwaitingPing = false;
-	newClient->idleticks = 0;
-	newClient->ticksSinceLastResponse = 0;
+	newClient->playerId = handoff.has_value() ? DM::Utils::UUID(handoff->entityId) : DM::Utils::UUID::generate();
 	newClient->packetquery = new EventQuery();
 
 	//Generate Client info & Register the handle.
 	{
+		newClient->handleIndex = m_clientHandles.size();
+
 		m_clientInfo[clientId] = newClient;
 		m_clientHandles.push_back(clientId); 
 	}
 
-	std::shared_ptr<Server::EntityHandler> eHandler = g_globals.entityHandler;
+	//Start counting down from the moment the client connects.
+	register_activity(*newClient);
+	arm_warning_timer(*newClient, TICKS_TILL_TIMEOUT_WARNING);
+	arm_timeout_timer(*newClient, TICKS_TILL_TIMEOUT);
 
-	ENetHost* server = g_globals.networkHandler->get_server_host();
+	g_globals.telemetryHandler->register_client(clientId, _peer);
+
+	std::shared_ptr<Server::EntityHandler> eHandler = g_globals.entityHandler;
 
 	//Register our player in the player handler.
 	eHandler->register_player(newClient->clientId);
@@ -119,81 +170,182 @@ void Server::ConnectionHandler::register_client(ENetPeer* _peer)
 		packet.interpreter = e_PacketInterpreter::PACKET_CREATE_ENTITY;
 		packet.entityId    = newClient->playerId;
 		packet.npcId = 0;
-		packet.posX  = 0;
-		packet.posY  = 0;
+		packet.posX  = handoff.has_value() ? handoff->posX : 0;
+		packet.posY  = handoff.has_value() ? handoff->posY : 0;
 		packet.bIsHidden = false;
 
-		//Sign to all clients that are already connected that a new player has joined.
-		PacketHandler::send_packet_multicast<Packets::s_CreateEntity>(&packet, server, 0, ENET_PACKET_FLAG_RELIABLE);
-	}
-
-	//Send a packet to the client so they can indentify their local player.
-	{
-		Packets::s_CreateEntity player;
-		player.interpreter = e_PacketInterpreter::PACKET_ASSIGN_LOCAL_PLAYER_ENTITY;
-		player.entityId = newClient->playerId;
-		PacketHandler::send_packet<Packets::s_CreateEntity>(&player, newClient->peer, server, 0, ENET_PACKET_FLAG_RELIABLE);
+		//Sign to all clients that are already connected that a new player has joined, snapshots create it otherwise.
+		if (!eHandler->is_replicated())
+		{
+			g_globals.networkHandler->send_packet_multicast<Packets::s_CreateEntity>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
 	}
 
-	//Set temporary name for the player.
+	//Set temporary name for the player, or restore the player that got handed off to us.
 	{
 		auto player = std::static_pointer_cast<Player>
 		(
 			eHandler->get_entity(newClient->clientId).value()
 		);
 
-		const std::string name = "Player" ;
-		player->set_name(name);
-		player->whisper("Welcome to my DeviousMUD 2D Clone!");
-		player->whisper("Use ::changename [name] to change your name ingame.");
+		if (handoff.has_value())
+		{
+			g_globals.zoneLink->restore_player(*newClient, player, handoff.value());
+		}
+		else
+		{
+			const std::string name = "Player" ;
+			player->set_name(name);
+			player->whisper("Welcome to my DeviousMUD 2D Clone!");
+			player->whisper("Use ::changename [name] to change your name ingame.");
+		}
 	}
 
-	//Send all existing players over to the registered player.
-	for (const enet_uint32 handle : m_clientHandles)
+	//The rest of the world gets sent over as a single snapshot at the end of the tick.
+	m_pendingJoins.push_back(clientId);
+}
+
+void Server::ConnectionHandler::send_join_snapshots()
+{
+	if (m_pendingJoins.size() == 0)
+		return;
+
+#ifdef _DM_DEBUG
+	const auto startTime = std::chrono::high_resolution_clock::now();
+#endif
+
+	std::shared_ptr<Server::EntityHandler> eHandler = g_globals.entityHandler;
+
+	//*-----------------------------------------------------------------------
+	// Collect the state of every entity, skills only get sent over when they
+	// differ from the defaults the client already creates its entities with.
+	//*
+	DM::SKILLS::SkillMap defaultSkills;
+
+	std::vector<Packets::s_SnapshotEntity> entities;
 	{
-		if (clientId == handle) //If it's our own client, skip.
-			continue;
+		const auto allEntities = eHandler->get_all_entities();
+		entities.reserve(allEntities.size());
 
-		if (auto optPlayer = eHandler->get_entity((uint64_t)handle); optPlayer.has_value())
+		for (const auto& entity : allEntities)
 		{
-			// Send creation packet
+			Packets::s_SnapshotEntity& snapshotEntity = entities.emplace_back();
+			snapshotEntity.entityId  = entity->uuid;
+			snapshotEntity.posX      = entity->position.x;
+			snapshotEntity.posY      = entity->position.y;
+			snapshotEntity.bIsHidden = entity->is_hidden();
+
+			if (auto player = std::dynamic_pointer_cast<Player>(entity); player != nullptr)
 			{
-				Packets::s_CreateEntity packet;
-				packet.interpreter = e_PacketInterpreter::PACKET_CREATE_ENTITY;
-				packet.entityId = optPlayer.value()->uuid;
-				packet.npcId = 0;
-				packet.posX = optPlayer.value()->position.x;
-				packet.posY = optPlayer.value()->position.y;
-				packet.bIsHidden = optPlayer.value()->is_hidden();
-
-				PacketHandler::send_packet<Packets::s_CreateEntity>(&packet, newClient->peer, server, 0, ENET_PACKET_FLAG_RELIABLE);
+				snapshotEntity.npcId = 0;
+				snapshotEntity.name  = player->get_shown_name();
 			}
-
-			// Update the player its name.
+			else if (auto npc = std::dynamic_pointer_cast<NPC>(entity); npc != nullptr)
 			{
-				std::shared_ptr<Player> player = std::static_pointer_cast<Player>(optPlayer.value());
+				snapshotEntity.npcId = npc->npcId;
+			}
 
-				Packets::s_NameChange packet;
-				packet.interpreter = e_PacketInterpreter::PACKET_CHANGE_NAME;
-				packet.entityId = player->uuid;
-				packet.name     = player->get_shown_name();
+			for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+			{
+				const DM::SKILLS::e_skills skillType    = static_cast<DM::SKILLS::e_skills>(i);
+				const DM::SKILLS::Skill&   skill        = entity->skills[skillType];
+				const DM::SKILLS::Skill&   defaultSkill = defaultSkills[skillType];
+
+				if (skill.level != defaultSkill.level || skill.levelboosted != defaultSkill.levelboosted)
+				{
+					snapshotEntity.skills.push_back({ i, skill.level, skill.levelboosted });
+				}
 			}
 		}
 	}
 
-	//Send all existing npcs over to the registered player.
-	for (const auto& entity : eHandler->get_world_npcs())
+	//*----------------------------------------------------------------------------
+	// Serialize the snapshot in chunks once, every joining client receives the
+	// exact same data. The packets themselves can't be shared, joining clients
+	// might be connected to different shards which each release them on their own.
+	//*
+	std::vector<std::string> chunks;
 	{
-		Packets::s_CreateEntity packet;
-		packet.interpreter = e_PacketInterpreter::PACKET_CREATE_ENTITY;
-		packet.entityId  = entity->uuid;
-		packet.npcId     = entity->npcId;
-		packet.posX      = entity->position.x;
-		packet.posY      = entity->position.y;
-		packet.bIsHidden = entity->is_hidden();
+		const uint32_t chunkCount = std::max<uint32_t>(1, static_cast<uint32_t>((entities.size() + SNAPSHOT_ENTITIES_PER_CHUNK - 1) / SNAPSHOT_ENTITIES_PER_CHUNK));
 
-		PacketHandler::send_packet<Packets::s_CreateEntity>(&packet, newClient->peer, server, 0, ENET_PACKET_FLAG_RELIABLE);
+		for (uint32_t i = 0; i < chunkCount; i++)
+		{
+			const size_t first = static_cast<size_t>(i) * SNAPSHOT_ENTITIES_PER_CHUNK;
+			const size_t last  = std::min<size_t>(first + SNAPSHOT_ENTITIES_PER_CHUNK, entities.size());
+
+			Packets::s_WorldSnapshot snapshot;
+			snapshot.interpreter = e_PacketInterpreter::PACKET_WORLD_SNAPSHOT;
+			snapshot.chunkIndex  = i;
+			snapshot.chunkCount  = chunkCount;
+			snapshot.entities.assign
+			(
+				std::make_move_iterator(entities.begin() + first),
+				std::make_move_iterator(entities.begin() + last)
+			);
+
+			chunks.push_back(PacketHandler::serialize<Packets::s_WorldSnapshot>(&snapshot));
+		}
 	}
+
+#ifdef _DM_DEBUG
+	const auto buildTime = std::chrono::high_resolution_clock::now();
+#endif
+
+	//Ticks get stamped on the packets without their duration, the client only hears about it now and whenever it changes.
+	Packets::s_TickPeriod tickPeriod;
+	tickPeriod.interpreter = e_PacketInterpreter::PACKET_TICK_PERIOD;
+	tickPeriod.period      = g_globals.instance->get_tick_period_ms();
+
+	for (const enet_uint32 clientHandle : m_pendingJoins)
+	{
+		RefClientInfo clientInfo = get_client_info(clientHandle);
+
+		if (clientInfo == nullptr)
+			continue;
+
+		g_globals.networkHandler->send_packet<Packets::s_TickPeriod>(&tickPeriod, clientInfo->peer, clientHandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+
+		for (const std::string& chunk : chunks)
+		{
+			g_globals.networkHandler->send_data(clientInfo->peer, clientHandle, chunk, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
+
+		//Send a packet to the client so they can indentify their local player, their entity is part of the snapshot.
+		{
+			Packets::s_CreateEntity player;
+			player.interpreter = e_PacketInterpreter::PACKET_ASSIGN_LOCAL_PLAYER_ENTITY;
+			player.entityId = clientInfo->playerId;
+			g_globals.networkHandler->send_packet<Packets::s_CreateEntity>(&player, clientInfo->peer, clientHandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
+
+		//Resend the name now the client knows which entity is theirs, so it ends up in their chatbox.
+		if (auto optPlayer = eHandler->get_entity(clientInfo->clientId); optPlayer.has_value())
+		{
+			std::shared_ptr<Player> player = std::static_pointer_cast<Player>(optPlayer.value());
+
+			Packets::s_NameChange packet;
+			packet.interpreter = e_PacketInterpreter::PACKET_CHANGE_NAME;
+			packet.entityId = player->uuid;
+			packet.name     = player->get_shown_name();
+			g_globals.networkHandler->send_packet<Packets::s_NameChange>(&packet, clientInfo->peer, clientHandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
+	}
+
+#ifdef _DM_DEBUG
+	const auto endTime = std::chrono::high_resolution_clock::now();
+
+	size_t snapshotSize = 0;
+	for (const std::string& chunk : chunks)
+	{
+		snapshotSize += chunk.size();
+	}
+
+	DEVIOUS_LOG("Sent world snapshot of " << entities.size() << " entities (" << chunks.size() << " chunks, " << snapshotSize << " bytes) to "
+		        << m_pendingJoins.size() << " joining client(s). Build: " << std::chrono::duration_cast<std::chrono::microseconds>(buildTime - startTime).count()
+		        << "us, send: " << std::chrono::duration_cast<std::chrono::microseconds>(endTime - buildTime).count() << "us.");
+#endif
+
+	m_pendingJoins.clear();
 }
 
 void Server::ConnectionHandler::flag_for_disconnect(const enet_uint32& _clienthandle)
@@ -201,6 +353,47 @@ void Server::ConnectionHandler::flag_for_disconnect(const enet_uint32& _clientha
 	m_pendingDisconnects.push_back(_clienthandle);
 }
 
+void Server::ConnectionHandler::flag_for_transfer(const enet_uint32 _clienthandle, const uint32_t _instanceId)
+{
+	m_pendingTransfers.push_back({ _clienthandle, _instanceId });
+}
+
+void Server::ConnectionHandler::transfer_flagged_clients()
+{
+	if (m_pendingTransfers.size() == 0)
+		return;
+
+	for (const auto& [clientHandle, instanceId] : m_pendingTransfers)
+	{
+		RefClientInfo clientInfo = get_client_info(clientHandle);
+
+		if (clientInfo == nullptr || instanceId >= g_globals.networkHandler->get_instance_count())
+			continue;
+
+		ENetPeer* peer = clientInfo->peer;
+
+		remove_client(clientHandle);
+
+		//Let the client drop the world it's leaving, the instance it joins sends it a snapshot of its own.
+		{
+			Packets::s_PacketHeader packet;
+			packet.interpreter = e_PacketInterpreter::PACKET_CHANGE_INSTANCE;
+			g_globals.networkHandler->send_packet<Packets::s_PacketHeader>(&packet, peer, clientHandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
+
+		if (!g_globals.networkHandler->transfer_client(peer, clientHandle, instanceId))
+		{
+			DEVIOUS_WARN("Couldn't transfer client " << clientHandle << " to instance " << instanceId << ", disconnecting it.");
+			g_globals.networkHandler->disconnect(peer, clientHandle);
+			continue;
+		}
+
+		DEVIOUS_LOG("Transferred client " << clientHandle << " to instance " << instanceId << ".");
+	}
+
+	m_pendingTransfers.clear();
+}
+
 void Server::ConnectionHandler::disconnect_client(const enet_uint32& _clienthandle)
 {
 	if (m_clientInfo.find(_clienthandle) == m_clientInfo.end())
@@ -209,22 +402,37 @@ void Server::ConnectionHandler::disconnect_client(const enet_uint32& _clienthand
 		return;
 	}
 
-	enet_peer_disconnect_now(m_clientInfo[_clienthandle]->peer, NULL);
+	g_globals.networkHandler->disconnect(m_clientInfo[_clienthandle]->peer, _clienthandle);
+
+	remove_client(_clienthandle);
+}
 
+void Server::ConnectionHandler::remove_client(const enet_uint32 _clienthandle)
+{
 	//Logout the player
 	{
 		g_globals.entityHandler->logout_player(m_clientInfo[_clienthandle]->clientId);
 	}
 
-	//Find and remove the clienthandle of the client that we're disconnecting.
-	const auto it = std::find_if(m_clientHandles.begin(), m_clientHandles.end(), [&_clienthandle](const enet_uint32& _handle)
+	cancel_idle_timers(*m_clientInfo[_clienthandle]);
+
+	g_globals.replicationHandler->remove_client(_clienthandle);
+	g_globals.telemetryHandler->remove_client(_clienthandle);
+
+	//Remove the clienthandle by swapping the last handle into its place.
 	{
-		return _clienthandle == _handle;
-	});
+		const size_t index = m_clientInfo[_clienthandle]->handleIndex;
+		const enet_uint32 lastHandle = m_clientHandles.back();
+
+		m_clientHandles[index] = lastHandle;
+		m_clientInfo[lastHandle]->handleIndex = index;
+		m_clientHandles.pop_back();
+	}
 
-	if (it != m_clientHandles.end())
+	//A client that disconnects before receiving its snapshot doesn't need one anymore.
+	if (auto it = std::find(m_pendingJoins.begin(), m_pendingJoins.end(), _clienthandle); it != m_pendingJoins.end())
 	{
-		m_clientHandles.erase(it);
+		m_pendingJoins.erase(it);
 	}
 
 	//Remove client entry
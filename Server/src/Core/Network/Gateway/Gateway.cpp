@@ -0,0 +1,453 @@
+#include "precomp.h"
+
+#include "Core/Network/Gateway/Gateway.h"
+
+#include "Core/Network/Gateway/GatewayPackets.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+#include "Shared/Network/Packets/PacketChannels.hpp"
+
+template<class T>
+void Server::Gateway::send_upstream(T* _packet, const uint8_t _channel, const enet_uint32 _flags)
+{
+	if (!m_bIsUpstreamConnected)
+		return;
+
+	const std::string data = PacketHandler::serialize<T>(_packet);
+	ENetPacket* packet = enet_packet_create(data.data(), data.size(), _flags);
+
+	if (enet_peer_send(m_upstream, _channel, packet) != 0)
+	{
+		enet_packet_destroy(packet);
+	}
+}
+
+ENetHost* Server::Gateway::create_client_host(const uint16_t _port)
+{
+	ENetAddress address;
+	address.m_host = ENET_HOST_ANY;
+	address.port = _port;
+
+	ENetHost* host = enet_host_create(&address, MAX_CLIENTS, CHANNEL_COUNT, 0, 0);
+
+	//Compress all outgoing packets, the client has to enable the same compressor.
+	if (host != nullptr && enet_host_compress_with_range_coder(host) != 0)
+	{
+		DEVIOUS_WARN("Couldn't enable packet compression, packets will be sent uncompressed.");
+	}
+
+	return host;
+}
+
+Server::Gateway::Gateway(const char* _serverAddress, const uint16_t _serverPort, const uint16_t _clientPort) :
+	m_clientHost(create_client_host(_clientPort)),
+	m_upstreamHost(enet_host_create(nullptr, 1, CHANNEL_COUNT, 0, 0)),
+	m_reactor(m_clientHost)
+{
+	if (m_clientHost == nullptr || m_upstreamHost == nullptr)
+	{
+		DEVIOUS_ERR("An error occurred while trying to create the hosts of the gateway.");
+		exit(EXIT_FAILURE);
+	}
+
+	enet_address_set_host(&m_serverAddress, _serverAddress);
+	m_serverAddress.port = _serverPort;
+
+	//Whatever the server sends wakes the gateway up just like the clients do.
+	m_reactor.watch(m_upstreamHost);
+
+	DEVIOUS_EVENT("Gateway listening on port " << _clientPort << " for the server at: [" << _serverAddress << ":" << _serverPort << "].");
+}
+
+Server::Gateway::~Gateway()
+{
+	enet_host_destroy(m_clientHost);
+	enet_host_destroy(m_upstreamHost);
+}
+
+void Server::Gateway::run()
+{
+	Clock::time_point nextStats = Clock::now() + STATS_INTERVAL;
+
+	while (true)
+	{
+		//The clients keep getting serviced while the gateway reconnects, new ones get turned away until it's back.
+		if (!m_bIsUpstreamConnected)
+		{
+			connect_upstream();
+		}
+
+		m_reactor.wait_until(std::min(Clock::now() + SERVICE_INTERVAL, nextStats));
+
+		service_upstream();
+		service_clients();
+
+		if (Clock::now() >= nextStats)
+		{
+			send_stats();
+			nextStats += STATS_INTERVAL;
+		}
+
+		enet_host_flush(m_upstreamHost);
+		enet_host_flush(m_clientHost);
+	}
+}
+
+void Server::Gateway::connect_upstream()
+{
+	const Clock::time_point now = Clock::now();
+
+	//Still waiting on the attempt that's underway.
+	if (m_upstream != nullptr)
+	{
+		if (now < m_connectDeadline)
+			return;
+
+		DEVIOUS_WARN("Couldn't reach the server, retrying...");
+		enet_peer_reset(m_upstream);
+	}
+
+	m_upstream        = enet_host_connect(m_upstreamHost, &m_serverAddress, CHANNEL_COUNT, 0);
+	m_connectDeadline = now + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+}
+
+void Server::Gateway::service_upstream()
+{
+	ENetEvent e;
+
+	while (m_upstream != nullptr && enet_host_service(m_upstreamHost, &e, 0) > 0)
+	{
+		switch (e.type)
+		{
+			case ENET_EVENT_TYPE_CONNECT:
+			{
+				m_bIsUpstreamConnected = true;
+
+				DEVIOUS_EVENT("Gateway connected to the server.");
+			}
+			break;
+
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				handle_upstream_packet(e);
+				enet_packet_destroy(e.packet);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_DISCONNECT:
+			{
+				//The server turned the attempt down, the next one starts right away.
+				if (!m_bIsUpstreamConnected)
+				{
+					m_upstream = nullptr;
+					break;
+				}
+
+				m_bIsUpstreamConnected = false;
+				m_upstream = nullptr;
+
+				DEVIOUS_WARN("Gateway lost the connection with the server, disconnecting " << m_clients.size() << " client(s).");
+				disconnect_clients();
+			}
+			break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void Server::Gateway::handle_upstream_packet(ENetEvent& _event)
+{
+	Packets::s_GatewayPacket header;
+	PacketHandler::retrieve_packet_data<Packets::s_GatewayPacket>(header, &_event);
+
+	switch (header.type)
+	{
+		case e_GatewayPacket::GATEWAY_DATA:
+		{
+			auto client = m_clients.find(header.clientId);
+
+			if (client == m_clients.end())
+				return;
+
+			Packets::s_GatewayData packet;
+			PacketHandler::retrieve_packet_data<Packets::s_GatewayData>(packet, &_event);
+
+			ENetPacket* data = enet_packet_create(packet.data.data(), packet.data.size(), packet.flags);
+
+			if (enet_peer_send(client->second.peer, packet.channel, data) != 0)
+			{
+				enet_packet_destroy(data);
+			}
+		}
+		break;
+
+		case e_GatewayPacket::GATEWAY_BROADCAST:
+		{
+			Packets::s_GatewayBroadcast packet;
+			PacketHandler::retrieve_packet_data<Packets::s_GatewayBroadcast>(packet, &_event);
+
+			//*-----------------------------------------------------------------
+			// Every client shares the same packet, ENet counts the peers it's
+			// queued for and only frees it once it got sent to all of them.
+			//*
+			ENetPacket* broadcast = enet_packet_create(packet.data.data(), packet.data.size(), packet.flags);
+			bool bIsQueued = false;
+
+			for (const uint32_t clientId : packet.clientIds)
+			{
+				if (auto client = m_clients.find(clientId); client != m_clients.end())
+				{
+					if (enet_peer_send(client->second.peer, packet.channel, broadcast) == 0)
+					{
+						bIsQueued = true;
+					}
+				}
+			}
+
+			//Nobody holds on to it when every send failed.
+			if (!bIsQueued)
+			{
+				enet_packet_destroy(broadcast);
+			}
+		}
+		break;
+
+		//The server kicked the client, or didn't have room for it.
+		case e_GatewayPacket::GATEWAY_DISCONNECT:
+		{
+			if (auto client = m_clients.find(header.clientId); client != m_clients.end())
+			{
+				client->second.peer->data = nullptr;
+				enet_peer_disconnect_now(client->second.peer, 0);
+				m_clients.erase(client);
+			}
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+void Server::Gateway::service_clients()
+{
+	ENetEvent e;
+
+	while (enet_host_service(m_clientHost, &e, 0) > 0)
+	{
+		switch (e.type)
+		{
+			case ENET_EVENT_TYPE_CONNECT:
+			{
+				//Without the server there's nothing to play on.
+				if (!m_bIsUpstreamConnected)
+				{
+					enet_peer_disconnect_now(e.peer, 0);
+					break;
+				}
+
+				//*---------------------------------------------------------------
+				// The connect id is picked by the client, so two clients could
+				// share one. Ids are handed out by the gateway instead, and kept
+				// on the peer as ENet resets it before handing out its disconnect.
+				//*
+				if (m_nextClientId == 0)
+				{
+					m_nextClientId = 1;
+				}
+
+				const uint32_t clientId = m_nextClientId++;
+				e.peer->data = reinterpret_cast<void*>(static_cast<uintptr_t>(clientId));
+
+				enet_peer_timeout(e.peer, TelemetryHandler::TIMEOUT_LIMIT, TelemetryHandler::TIMEOUT_MINIMUM_MS, TelemetryHandler::TIMEOUT_MAXIMUM_MS);
+
+				Client client;
+				client.peer     = e.peer;
+				client.clientId = clientId;
+				m_clients[clientId] = client;
+
+				Packets::s_GatewayConnect packet;
+				packet.type        = e_GatewayPacket::GATEWAY_CONNECT;
+				packet.clientId    = clientId;
+				packet.connectData = e.data;
+
+				send_upstream<Packets::s_GatewayConnect>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_DISCONNECT:
+			{
+				const enet_uint32 clientId = static_cast<enet_uint32>(reinterpret_cast<uintptr_t>(e.peer->data));
+				e.peer->data = nullptr;
+
+				//Clients the server kicked are already gone.
+				if (m_clients.erase(clientId) == 0)
+					break;
+
+				Packets::s_GatewayPacket packet;
+				packet.type     = e_GatewayPacket::GATEWAY_DISCONNECT;
+				packet.clientId = clientId;
+
+				send_upstream<Packets::s_GatewayPacket>(&packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				const uint32_t clientId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(e.peer->data));
+
+				if (auto client = m_clients.find(clientId); client != m_clients.end())
+				{
+					handle_client_packet(e, client->second);
+				}
+
+				enet_packet_destroy(e.packet);
+			}
+			break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void Server::Gateway::handle_client_packet(ENetEvent& _event, Client& _client)
+{
+	if (!take_token(_client) || !validate(_event))
+	{
+		drop_packet(_client);
+		return;
+	}
+
+	Packets::s_GatewayData packet;
+	packet.type     = e_GatewayPacket::GATEWAY_DATA;
+	packet.clientId = _client.clientId;
+	packet.channel  = _event.channelID;
+	packet.flags    = _event.packet->flags;
+	packet.data.assign(reinterpret_cast<const char*>(_event.packet->data), _event.packet->dataLength);
+
+	//Travels over the same channel with the same flags, so it keeps its ordering & reliability up to the server.
+	send_upstream<Packets::s_GatewayData>(&packet, _event.channelID, _event.packet->flags & ENET_PACKET_FLAG_RELIABLE);
+}
+
+const bool Server::Gateway::take_token(Client& _client)
+{
+	const Clock::time_point now = Clock::now();
+	const float elapsed = std::chrono::duration<float>(now - _client.lastRefill).count();
+
+	_client.tokens     = std::min(static_cast<float>(PACKET_BURST), _client.tokens + elapsed * PACKETS_PER_SECOND);
+	_client.lastRefill = now;
+
+	if (_client.tokens < 1.0f)
+		return false;
+
+	_client.tokens -= 1.0f;
+	return true;
+}
+
+const bool Server::Gateway::validate(const ENetEvent& _event)
+{
+	if (_event.packet->dataLength > MAX_PACKET_SIZE || _event.channelID >= CHANNEL_COUNT)
+		return false;
+
+	Packets::s_PacketHeader header;
+
+	if (!PacketHandler::try_retrieve_packet_data<Packets::s_PacketHeader>(header, &_event))
+		return false;
+
+	//*-----------------------------------------------------------------------
+	// Only the packets the server accepts from clients, each has to decode as
+	// a whole so the server never reads a truncated one.
+	//*
+	switch (header.interpreter)
+	{
+		case e_PacketInterpreter::PACKET_SNAPSHOT_ACK:
+		{
+			Packets::s_SnapshotAck packet;
+			return PacketHandler::try_retrieve_packet_data<Packets::s_SnapshotAck>(packet, &_event);
+		}
+
+		case e_PacketInterpreter::PACKET_REMOVE_ENTITY:
+			return true;
+
+		case e_PacketInterpreter::PACKET_MOVE_ENTITY:
+		{
+			Packets::s_EntityMovement packet;
+			return PacketHandler::try_retrieve_packet_data<Packets::s_EntityMovement>(packet, &_event);
+		}
+
+		case e_PacketInterpreter::PACKET_FOLLOW_ENTITY:
+		{
+			Packets::s_EntityFollow packet;
+			return PacketHandler::try_retrieve_packet_data<Packets::s_EntityFollow>(packet, &_event);
+		}
+
+		case e_PacketInterpreter::PACKET_ENTITY_MESSAGE_WORLD:
+		{
+			Packets::s_Message packet;
+			return PacketHandler::try_retrieve_packet_data<Packets::s_Message>(packet, &_event);
+		}
+
+		case e_PacketInterpreter::PACKET_ENGAGE_ENTITY:
+		{
+			Packets::s_ActionPacket packet;
+			return PacketHandler::try_retrieve_packet_data<Packets::s_ActionPacket>(packet, &_event);
+		}
+
+		default:
+			return false;
+	}
+}
+
+void Server::Gateway::drop_packet(Client& _client)
+{
+	if (++_client.droppedPackets != MAX_DROPPED_PACKETS)
+		return;
+
+	DEVIOUS_WARN("Gateway disconnects client " << _client.clientId << ", it sent too many packets that got dropped.");
+
+	//The server gets notified once the disconnect went through.
+	enet_peer_disconnect(_client.peer, 0);
+}
+
+void Server::Gateway::send_stats()
+{
+	if (m_clients.empty())
+		return;
+
+	Packets::s_GatewayStats packet;
+	packet.type = e_GatewayPacket::GATEWAY_STATS;
+	packet.clients.reserve(m_clients.size());
+
+	for (const auto& [clientId, client] : m_clients)
+	{
+		Packets::s_GatewayClientStats stats;
+		stats.clientId              = clientId;
+		stats.roundTripTime         = client.peer->roundTripTime;
+		stats.roundTripTimeVariance = client.peer->roundTripTimeVariance;
+		stats.packetLoss            = client.peer->packetLoss;
+		stats.incomingDataTotal     = client.peer->incomingDataTotal;
+		stats.outgoingDataTotal     = client.peer->outgoingDataTotal;
+
+		packet.clients.push_back(stats);
+	}
+
+	//Only the latest stats matter, losing some is fine.
+	send_upstream<Packets::s_GatewayStats>(&packet, CHANNEL_RELIABLE, 0);
+}
+
+void Server::Gateway::disconnect_clients()
+{
+	for (const auto& [clientId, client] : m_clients)
+	{
+		client.peer->data = nullptr;
+		enet_peer_disconnect_now(client.peer, 0);
+	}
+
+	m_clients.clear();
+}
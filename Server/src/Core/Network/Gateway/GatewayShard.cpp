@@ -0,0 +1,378 @@
+#include "precomp.h"
+
+#include "Core/Network/Gateway/GatewayShard.h"
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+#include "Shared/Network/Packets/PacketChannels.hpp"
+
+#include <cstring>
+
+template<class T>
+void Server::GatewayShard::send_gateway(ENetPeer* _gateway, T* _packet, const uint8_t _channel, const enet_uint32 _flags)
+{
+	const std::string data = PacketHandler::serialize<T>(_packet);
+	ENetPacket* packet = enet_packet_create(data.data(), data.size(), _flags);
+
+	if (enet_peer_send(_gateway, _channel, packet) != 0)
+	{
+		enet_packet_destroy(packet);
+	}
+}
+
+ENetHost* Server::GatewayShard::create_host(const uint16_t _port)
+{
+	ENetAddress address;
+	address.m_host = ENET_HOST_ANY;
+	address.port = _port;
+
+	return enet_host_create(&address, MAX_GATEWAYS, CHANNEL_COUNT, 0, 0);
+}
+
+Server::GatewayShard::GatewayShard(ENetHost* _host) :
+	IngressShard(_host),
+	m_clients(new ENetPeer[MAX_CLIENTS]),
+	m_virtualClients(MAX_CLIENTS)
+{
+	//The virtual peers only ever carry a handle & statistics, ENet never gets to see them.
+	std::memset(m_clients.get(), 0, sizeof(ENetPeer) * MAX_CLIENTS);
+
+	m_freeClients.reserve(MAX_CLIENTS);
+
+	for (size_t i = MAX_CLIENTS; i > 0; i--)
+	{
+		m_freeClients.push_back(i - 1);
+	}
+}
+
+Server::GatewayShard::~GatewayShard()
+{
+	//The I/O thread calls into this class, it has to be gone before the members are.
+	stop();
+}
+
+const bool Server::GatewayShard::owns(const ENetPeer* _peer) const
+{
+	return _peer >= m_clients.get() && _peer < m_clients.get() + MAX_CLIENTS;
+}
+
+const ENetPeer* Server::GatewayShard::get_peers(size_t& _count) const
+{
+	_count = MAX_CLIENTS;
+	return m_clients.get();
+}
+
+void Server::GatewayShard::multicast(const std::vector<Recipient>& _recipients, const enet_uint8 _channel, const std::string& _data, const enet_uint32 _flags)
+{
+	//*-----------------------------------------------------------------------
+	// The marker is queued while holding on to the multicasts, so the I/O
+	// thread pops them in the same order the markers get dispatched in, and
+	// the multicast keeps its place among the packets sent to single clients.
+	//*
+	std::lock_guard<std::mutex> lock(m_multicastMutex);
+
+	m_multicasts.push_back({ _recipients, _channel, _data, _flags });
+	queue_outgoing({ nullptr, 0, _channel, nullptr });
+}
+
+void Server::GatewayShard::receive(ENetEvent& _event, std::vector<IngressEvent>& _received)
+{
+	switch (_event.type)
+	{
+		case ENET_EVENT_TYPE_CONNECT:
+		{
+			m_gatewayClients[_event.peer];
+			DEVIOUS_EVENT("Gateway connected, " << m_gatewayClients.size() << " gateway(s) online.");
+		}
+		break;
+
+		//Everyone behind the gateway is gone along with it.
+		case ENET_EVENT_TYPE_DISCONNECT:
+		{
+			if (auto it = m_gatewayClients.find(_event.peer); it != m_gatewayClients.end())
+			{
+				std::vector<ENetPeer*> clients;
+
+				for (const auto& [clientId, client] : it->second)
+				{
+					clients.push_back(client);
+				}
+
+				for (ENetPeer* client : clients)
+				{
+					disconnect_client(client, _received);
+				}
+
+				m_gatewayClients.erase(_event.peer);
+			}
+
+			DEVIOUS_WARN("Lost a gateway, " << m_gatewayClients.size() << " gateway(s) online.");
+		}
+		break;
+
+		case ENET_EVENT_TYPE_RECEIVE:
+		{
+			handle_packet(_event, _received);
+			enet_packet_destroy(_event.packet);
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+void Server::GatewayShard::handle_packet(ENetEvent& _event, std::vector<IngressEvent>& _received)
+{
+	Packets::s_GatewayPacket header;
+
+	if (!PacketHandler::try_retrieve_packet_data<Packets::s_GatewayPacket>(header, &_event))
+	{
+		DEVIOUS_WARN("Received a malformed packet from a gateway.");
+		return;
+	}
+
+	switch (header.type)
+	{
+		case e_GatewayPacket::GATEWAY_CONNECT:
+		{
+			Packets::s_GatewayConnect packet;
+			PacketHandler::retrieve_packet_data<Packets::s_GatewayConnect>(packet, &_event);
+
+			ENetPeer* client = connect_client(_event.peer, packet.clientId);
+
+			if (client == nullptr)
+			{
+				DEVIOUS_WARN("Refused a client of a gateway, every virtual peer is taken.");
+
+				Packets::s_GatewayPacket refusal;
+				refusal.type     = e_GatewayPacket::GATEWAY_DISCONNECT;
+				refusal.clientId = packet.clientId;
+
+				send_gateway<Packets::s_GatewayPacket>(_event.peer, &refusal, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+				return;
+			}
+
+			IngressEvent event;
+			event.event.type   = ENET_EVENT_TYPE_CONNECT;
+			event.event.peer   = client;
+			event.event.data   = packet.connectData;
+			event.clientHandle = client->connectID;
+
+			_received.push_back(event);
+		}
+		break;
+
+		case e_GatewayPacket::GATEWAY_DISCONNECT:
+		{
+			if (ENetPeer* client = find_client(_event.peer, header.clientId); client != nullptr)
+			{
+				disconnect_client(client, _received);
+			}
+		}
+		break;
+
+		//The packet of the client gets handed to the game as if the client sent it to us directly.
+		case e_GatewayPacket::GATEWAY_DATA:
+		{
+			ENetPeer* client = find_client(_event.peer, header.clientId);
+
+			if (client == nullptr)
+				return;
+
+			Packets::s_GatewayData packet;
+			PacketHandler::retrieve_packet_data<Packets::s_GatewayData>(packet, &_event);
+
+			IngressEvent event;
+			event.event.type      = ENET_EVENT_TYPE_RECEIVE;
+			event.event.peer      = client;
+			event.event.channelID = packet.channel;
+			event.event.packet    = enet_packet_create(packet.data.data(), packet.data.size(), packet.flags);
+			event.clientHandle    = client->connectID;
+
+			_received.push_back(event);
+		}
+		break;
+
+		case e_GatewayPacket::GATEWAY_STATS:
+		{
+			Packets::s_GatewayStats packet;
+			PacketHandler::retrieve_packet_data<Packets::s_GatewayStats>(packet, &_event);
+
+			for (const Packets::s_GatewayClientStats& stats : packet.clients)
+			{
+				if (ENetPeer* client = find_client(_event.peer, stats.clientId); client != nullptr)
+				{
+					client->roundTripTime         = stats.roundTripTime;
+					client->roundTripTimeVariance = stats.roundTripTimeVariance;
+					client->packetLoss            = stats.packetLoss;
+					client->incomingDataTotal     = stats.incomingDataTotal;
+					client->outgoingDataTotal     = stats.outgoingDataTotal;
+				}
+			}
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+void Server::GatewayShard::dispatch(const OutgoingCommand& _command)
+{
+	if (_command.peer == nullptr)
+	{
+		PendingMulticast multicast;
+		{
+			std::lock_guard<std::mutex> lock(m_multicastMutex);
+
+			multicast = std::move(m_multicasts.front());
+			m_multicasts.pop_front();
+		}
+
+		dispatch_multicast(multicast);
+		return;
+	}
+
+	//The client might have left, or its virtual peer even got reused by another client, since the command got queued.
+	if (_command.peer->state != ENET_PEER_STATE_CONNECTED || _command.peer->connectID != _command.clientHandle)
+	{
+		if (_command.packet != nullptr)
+		{
+			enet_packet_destroy(_command.packet);
+		}
+
+		return;
+	}
+
+	const VirtualClient& client = m_virtualClients[static_cast<size_t>(_command.peer - m_clients.get())];
+
+	//The server kicks the client, the gateway drops its connection.
+	if (_command.packet == nullptr)
+	{
+		Packets::s_GatewayPacket packet;
+		packet.type     = e_GatewayPacket::GATEWAY_DISCONNECT;
+		packet.clientId = client.clientId;
+
+		send_gateway<Packets::s_GatewayPacket>(client.gateway, &packet, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		release_client(_command.peer);
+		return;
+	}
+
+	Packets::s_GatewayData packet;
+	packet.type     = e_GatewayPacket::GATEWAY_DATA;
+	packet.clientId = client.clientId;
+	packet.channel  = _command.channel;
+	packet.flags    = _command.packet->flags;
+	packet.data.assign(reinterpret_cast<const char*>(_command.packet->data), _command.packet->dataLength);
+
+	//Travels over the same channel with the same flags, so it keeps its ordering & reliability up to the client.
+	send_gateway<Packets::s_GatewayData>(client.gateway, &packet, _command.channel, _command.packet->flags);
+	enet_packet_destroy(_command.packet);
+}
+
+void Server::GatewayShard::dispatch_multicast(const PendingMulticast& _multicast)
+{
+	//There's only a handful of gateways, a linear search beats hashing them.
+	std::vector<std::pair<ENetPeer*, std::vector<uint32_t>>> gateways;
+
+	for (const Recipient& recipient : _multicast.recipients)
+	{
+		if (recipient.peer->state != ENET_PEER_STATE_CONNECTED || recipient.peer->connectID != recipient.clientHandle)
+			continue;
+
+		const VirtualClient& client = m_virtualClients[static_cast<size_t>(recipient.peer - m_clients.get())];
+
+		auto it = std::find_if(gateways.begin(), gateways.end(), [&client](const auto& _gateway) { return _gateway.first == client.gateway; });
+
+		if (it == gateways.end())
+		{
+			gateways.push_back({ client.gateway, {} });
+			it = gateways.end() - 1;
+		}
+
+		it->second.push_back(client.clientId);
+	}
+
+	Packets::s_GatewayBroadcast packet;
+	packet.type    = e_GatewayPacket::GATEWAY_BROADCAST;
+	packet.channel = _multicast.channel;
+	packet.flags   = _multicast.flags;
+	packet.data    = _multicast.data;
+
+	for (auto& [gateway, clientIds] : gateways)
+	{
+		packet.clientIds = std::move(clientIds);
+		send_gateway<Packets::s_GatewayBroadcast>(gateway, &packet, _multicast.channel, _multicast.flags);
+	}
+}
+
+ENetPeer* Server::GatewayShard::connect_client(ENetPeer* _gateway, const uint32_t _clientId)
+{
+	if (m_freeClients.empty())
+		return nullptr;
+
+	const size_t index = m_freeClients.back();
+	m_freeClients.pop_back();
+
+	ENetPeer* client = &m_clients[index];
+	std::memset(client, 0, sizeof(ENetPeer));
+
+	//Handles are never 0, the game treats that as a peer that isn't connected.
+	if (m_nextHandle == 0)
+	{
+		m_nextHandle = 1;
+	}
+
+	client->state     = ENET_PEER_STATE_CONNECTED;
+	client->connectID = m_nextHandle++;
+	client->data      = reinterpret_cast<void*>(static_cast<uintptr_t>(client->connectID));
+
+	m_virtualClients[index] = { _gateway, _clientId };
+	m_gatewayClients[_gateway][_clientId] = client;
+
+	return client;
+}
+
+void Server::GatewayShard::disconnect_client(ENetPeer* _client, std::vector<IngressEvent>& _received)
+{
+	IngressEvent event;
+	event.event.type   = ENET_EVENT_TYPE_DISCONNECT;
+	event.event.peer   = _client;
+	event.clientHandle = _client->connectID;
+
+	_received.push_back(event);
+
+	release_client(_client);
+}
+
+void Server::GatewayShard::release_client(ENetPeer* _client)
+{
+	const size_t index = static_cast<size_t>(_client - m_clients.get());
+	VirtualClient& virtualClient = m_virtualClients[index];
+
+	if (auto it = m_gatewayClients.find(virtualClient.gateway); it != m_gatewayClients.end())
+	{
+		it->second.erase(virtualClient.clientId);
+	}
+
+	virtualClient = {};
+
+	//Commands that were queued for the client before it left see it isn't connected anymore.
+	_client->state     = ENET_PEER_STATE_DISCONNECTED;
+	_client->connectID = 0;
+	_client->data      = nullptr;
+
+	m_freeClients.push_back(index);
+}
+
+ENetPeer* Server::GatewayShard::find_client(ENetPeer* _gateway, const uint32_t _clientId) const
+{
+	auto it = m_gatewayClients.find(_gateway);
+
+	if (it == m_gatewayClients.end())
+		return nullptr;
+
+	auto client = it->second.find(_clientId);
+	return client != it->second.end() ? client->second : nullptr;
+}
@@ -0,0 +1,293 @@
+#include "precomp.h"
+
+#include "Core/Network/Ingress/IngressShard.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+ENetHost* Server::IngressShard::create_host(const ENetAddress& _address, const size_t _peerCount, const size_t _channelCount,
+	                                        const enet_uint32 _incomingBandwidth, const enet_uint32 _outgoingBandwidth, const bool _bReusePort)
+{
+	if (!_bReusePort)
+		return enet_host_create(&_address, _peerCount, _channelCount, _incomingBandwidth, _outgoingBandwidth);
+
+#ifdef __linux__
+	//*---------------------------------------------------------------------------
+	// ENet binds its socket while creating the host, which is too late to allow
+	// reusing the port. Create it unbound instead and bind the socket ourselves.
+	//*
+	ENetHost* host = enet_host_create(nullptr, _peerCount, _channelCount, _incomingBandwidth, _outgoingBandwidth);
+
+	if (host == nullptr)
+		return nullptr;
+
+	const int bEnable = 1;
+
+	if (setsockopt(host->socket, SOL_SOCKET, SO_REUSEPORT, &bEnable, sizeof(bEnable)) != 0 || enet_socket_bind(host->socket, &_address) != 0)
+	{
+		enet_host_destroy(host);
+		return nullptr;
+	}
+
+	host->address = _address;
+	return host;
+#else
+	return nullptr;
+#endif
+}
+
+Server::IngressShard::IngressShard(ENetHost* _host) :
+	m_host(_host),
+	m_reactor(_host)
+{
+}
+
+Server::IngressShard::~IngressShard()
+{
+	stop();
+
+	//Nothing is going to send these anymore.
+	for (const OutgoingCommand& command : m_outgoing)
+	{
+		if (command.packet != nullptr)
+		{
+			enet_packet_destroy(command.packet);
+		}
+	}
+
+	for (const IngressEvent& event : m_incoming)
+	{
+		if (event.event.packet != nullptr)
+		{
+			enet_packet_destroy(event.event.packet);
+		}
+	}
+
+	enet_host_destroy(m_host);
+}
+
+void Server::IngressShard::start()
+{
+	m_bIsRunning = true;
+	m_thread = std::thread(&IngressShard::run, this);
+}
+
+void Server::IngressShard::stop()
+{
+	if (!m_bIsRunning.exchange(false))
+		return;
+
+	m_reactor.wake();
+	m_thread.join();
+}
+
+void Server::IngressShard::poll_events(std::vector<IngressEvent>& _events)
+{
+	std::lock_guard<std::mutex> lock(m_incomingMutex);
+
+	_events.insert(_events.end(), m_incoming.begin(), m_incoming.end());
+	m_incoming.clear();
+}
+
+void Server::IngressShard::send(ENetPeer* _peer, const enet_uint32 _clienthandle, const enet_uint8 _channel, ENetPacket* _packet)
+{
+	queue_outgoing({ _peer, _clienthandle, _channel, _packet });
+}
+
+void Server::IngressShard::multicast(const std::vector<Recipient>& _recipients, const enet_uint8 _channel, const std::string& _data, const enet_uint32 _flags)
+{
+	//Every peer gets a packet of its own, ENet only releases a packet once it got sent to every peer it got queued for.
+	for (const Recipient& recipient : _recipients)
+	{
+		queue_outgoing({ recipient.peer, recipient.clientHandle, _channel, enet_packet_create(_data.data(), _data.size(), _flags) });
+	}
+}
+
+void Server::IngressShard::disconnect(ENetPeer* _peer, const enet_uint32 _clienthandle)
+{
+	queue_outgoing({ _peer, _clienthandle, 0, nullptr });
+}
+
+const bool Server::IngressShard::owns(const ENetPeer* _peer) const
+{
+	//The peers of a host live in a single array that never moves, so this doesn't touch anything the I/O thread writes to.
+	return _peer >= m_host->peers && _peer < m_host->peers + m_host->peerCount;
+}
+
+const bool Server::IngressShard::get_stats(const ENetPeer* _peer, const enet_uint32 _clienthandle, PeerStats& _stats)
+{
+	size_t count = 0;
+	const size_t index = static_cast<size_t>(_peer - get_peers(count));
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+
+	//A reset peer can already be reused by another client before the game drained the disconnect of the old one.
+	if (index >= m_stats.size() || m_stats[index].clientHandle != _clienthandle)
+		return false;
+
+	_stats = m_stats[index];
+	return true;
+}
+
+const ENetPeer* Server::IngressShard::get_peers(size_t& _count) const
+{
+	_count = m_host->peerCount;
+	return m_host->peers;
+}
+
+void Server::IngressShard::queue_outgoing(const OutgoingCommand& _command)
+{
+	bool bWasEmpty;
+	{
+		std::lock_guard<std::mutex> lock(m_outgoingMutex);
+
+		bWasEmpty = m_outgoing.empty();
+		m_outgoing.push_back(_command);
+	}
+
+	//The I/O thread drains everything that got queued at once, only the first command has to wake it up.
+	if (bWasEmpty)
+	{
+		m_reactor.wake();
+	}
+}
+
+void Server::IngressShard::run()
+{
+	std::vector<IngressEvent> received;
+
+	while (m_bIsRunning)
+	{
+		m_reactor.wait_until(Clock::now() + SERVICE_INTERVAL);
+
+		send_outgoing();
+
+		ENetEvent e;
+
+		//Drain every event that's ready, rather than handling a single one per wakeup.
+		while (enet_host_service(m_host, &e, 0) > 0)
+		{
+			receive(e, received);
+		}
+
+		if (!received.empty())
+		{
+			std::lock_guard<std::mutex> lock(m_incomingMutex);
+
+			m_incoming.insert(m_incoming.end(), received.begin(), received.end());
+			received.clear();
+		}
+
+		if (Clock::now() - m_lastStatsCopy >= STATS_INTERVAL)
+		{
+			copy_stats();
+		}
+	}
+}
+
+void Server::IngressShard::copy_stats()
+{
+	m_lastStatsCopy = Clock::now();
+
+	size_t count = 0;
+	const ENetPeer* peers = get_peers(count);
+
+	m_copyingStats.resize(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const ENetPeer& peer = peers[i];
+		PeerStats& stats = m_copyingStats[i];
+
+		stats.clientHandle          = peer.state == ENET_PEER_STATE_CONNECTED ? peer.connectID : 0;
+		stats.roundTripTime         = peer.roundTripTime;
+		stats.roundTripTimeVariance = peer.roundTripTimeVariance;
+		stats.packetLoss            = peer.packetLoss;
+		stats.incomingDataTotal     = peer.incomingDataTotal;
+		stats.outgoingDataTotal     = peer.outgoingDataTotal;
+	}
+
+	std::lock_guard<std::mutex> lock(m_statsMutex);
+	m_stats.swap(m_copyingStats);
+}
+
+void Server::IngressShard::receive(ENetEvent& _event, std::vector<IngressEvent>& _received)
+{
+	IngressEvent event;
+	event.event = _event;
+
+	switch (_event.type)
+	{
+		case ENET_EVENT_TYPE_CONNECT:
+		{
+			//ENet resets the peer before handing out its disconnect, keep the handle around to identify it.
+			_event.peer->data  = reinterpret_cast<void*>(static_cast<uintptr_t>(_event.peer->connectID));
+			event.clientHandle = _event.peer->connectID;
+
+			enet_peer_timeout(_event.peer, TelemetryHandler::TIMEOUT_LIMIT, TelemetryHandler::TIMEOUT_MINIMUM_MS, TelemetryHandler::TIMEOUT_MAXIMUM_MS);
+		}
+		break;
+
+		case ENET_EVENT_TYPE_DISCONNECT:
+		{
+			event.clientHandle = static_cast<enet_uint32>(reinterpret_cast<uintptr_t>(_event.peer->data));
+			_event.peer->data  = nullptr;
+		}
+		break;
+
+		case ENET_EVENT_TYPE_RECEIVE:
+		{
+			event.clientHandle = _event.peer->connectID;
+		}
+		break;
+
+		default:
+			return;
+	}
+
+	_received.push_back(event);
+}
+
+void Server::IngressShard::send_outgoing()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_outgoingMutex);
+		m_sending.swap(m_outgoing);
+	}
+
+	if (m_sending.empty())
+		return;
+
+	for (const OutgoingCommand& command : m_sending)
+	{
+		dispatch(command);
+	}
+
+	m_sending.clear();
+
+	enet_host_flush(m_host);
+}
+
+void Server::IngressShard::dispatch(const OutgoingCommand& _command)
+{
+	//The peer might have disconnected, or even got reused by another client, since the command got queued.
+	const bool bIsConnected = _command.peer->state == ENET_PEER_STATE_CONNECTED && _command.peer->connectID == _command.clientHandle;
+
+	if (_command.packet == nullptr)
+	{
+		if (bIsConnected)
+		{
+			enet_peer_disconnect_now(_command.peer, 0);
+		}
+
+		return;
+	}
+
+	if (!bIsConnected || enet_peer_send(_command.peer, _command.channel, _command.packet) != 0)
+	{
+		enet_packet_destroy(_command.packet);
+	}
+}
\ No newline at end of file
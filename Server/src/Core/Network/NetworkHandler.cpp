@@ -4,19 +4,21 @@
 
 #include "Core/Network/NetworkHandler.h"
 
-#include "Core/Config/Config.h" //TODO: This needss to be moved to a shared project at some point.
-
 #include "Core/Network/Connection/ConnectionHandler.h"
 
-#include "Core/Game/Entity/EntityHandler.h"
+#include "Core/Game/World/WorldInstance.h"
+
+#include "Core/Network/Ingress/IngressShard.h"
 
-#include "Core/Events/Handler/EventHandler.h"
+#include "Core/Network/Gateway/GatewayShard.h"
 
-#include "Core/Game/World/World.h"
+#include "Core/Network/Client/ClientInfo.h"
+
+#include <thread>
 
 #include "Core/Globals/S_Globals.h"
 
-Globals g_globals;
+thread_local Globals g_globals;
 
 NetworkHandler NetworkHandler::create_local_host(int32_t _maxconnections, int32_t _channels, int32_t _inc_bandwith, int32_t _outg_bandwidth)
 {
@@ -25,100 +27,271 @@ NetworkHandler NetworkHandler::create_local_host(int32_t _maxconnections, int32_
 	return create_host(ADRESS, PORT, _maxconnections, _channels, _inc_bandwith, _outg_bandwidth);
 }
 
-NetworkHandler NetworkHandler::create_host(const char* _address, int32_t _port, int32_t _maxconnections, int32_t _channels, int32_t _inc_bandwith, int32_t _outg_bandwidth)
+NetworkHandler NetworkHandler::create_host(const char* _address, int32_t _port, int32_t _maxconnections, int32_t _channels, int32_t _inc_bandwith, int32_t _outg_bandwidth, uint32_t _shardCount)
 {
 	//Set server host & Connection parameters
 	ENetAddress connection;
-	ENetHost*   server;
 
 	connection.port = _port;
 	enet_address_set_host(&connection, _address);
 
-	DEVIOUS_EVENT("Trying to connect to: [" << _address << ":" << _port << "]...");
-	server = enet_host_create(&connection,
-							   _maxconnections,
-							   _channels,
-							   _inc_bandwith,
-							   _outg_bandwidth);
+	if (_shardCount == 0)
+	{
+		_shardCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+	}
+
+#ifndef __linux__
+	//Without SO_REUSEPORT only one socket can listen on the port.
+	_shardCount = 1;
+#endif
+
+	DEVIOUS_EVENT("Trying to connect to: [" << _address << ":" << _port << "] with " << _shardCount << " ingress shard(s)...");
+
+	std::vector<std::unique_ptr<Server::IngressShard>> shards;
+
+	for (uint32_t i = 0; i < _shardCount; i++)
+	{
+		ENetHost* server = Server::IngressShard::create_host(connection, _maxconnections, _channels, _inc_bandwith, _outg_bandwidth, _shardCount > 1);
+
+		if (server == NULL)
+		{
+			DEVIOUS_ERR("An error occurred while trying to create a ENet Server Host. \n");
+			exit(EXIT_FAILURE);
+		}
+
+		//Compress all outgoing packets, the client has to enable the same compressor.
+		if (enet_host_compress_with_range_coder(server) != 0)
+		{
+			DEVIOUS_WARN("Couldn't enable packet compression, packets will be sent uncompressed.");
+		}
+
+		shards.push_back(std::make_unique<Server::IngressShard>(server));
+	}
+
+	DEVIOUS_EVENT("Server listening on: [" << _address << ":" << _port << "].");
+	return NetworkHandler(std::move(shards));
+}
+
+NetworkHandler NetworkHandler::create_gateway_host(const uint16_t _port)
+{
+	ENetHost* server = Server::GatewayShard::create_host(_port);
 
 	if (server == NULL)
 	{
-		DEVIOUS_ERR("An error occurred while trying to create a ENet Server Host. \n");
+		DEVIOUS_ERR("An error occurred while trying to create the ENet host for the gateways. \n");
 		exit(EXIT_FAILURE);
 	}
 
-	DEVIOUS_EVENT("Server listening on: [" << _address << ":" << _port << "].");
-	return NetworkHandler(server);
+	//The gateways compress the packets for the clients, the link to them is local & stays uncompressed.
+	std::vector<std::unique_ptr<Server::IngressShard>> shards;
+	shards.push_back(std::make_unique<Server::GatewayShard>(server));
+
+	DEVIOUS_EVENT("Server waiting for gateways on port " << _port << ".");
+	return NetworkHandler(std::move(shards));
 }
 
-ENetHost* NetworkHandler::get_server_host()
+void NetworkHandler::send_data(ENetPeer* _peer, const enet_uint32 _clienthandle, const std::string& _data, uint8_t _channel, enet_uint32 _flags)
 {
-	return m_server;
+	Server::IngressShard* shard = get_shard(_peer);
+
+	//The shard compares the handle against the peer on its I/O thread, a client that left in the meantime only drops the packet.
+	if (shard == nullptr || _clienthandle == 0)
+		return;
+
+	shard->send(_peer, _clienthandle, _channel, enet_packet_create(_data.data(), _data.size(), _flags));
 }
 
-void NetworkHandler::start_ticking()
+void NetworkHandler::send_data_multicast(const std::string& _data, uint8_t _channel, enet_uint32 _flags)
 {
-	auto connectionHandler = std::make_shared<Server::ConnectionHandler>();
-	auto entityHandler     = std::make_shared<Server::EntityHandler>();
-	auto world			   = std::make_shared<Server::World>();
+	std::shared_ptr<Server::ConnectionHandler> cHandler = g_globals.connectionHandler;
 
-	bool is_running = true;
+	//Reused between calls, every instance ticks on a thread of its own.
+	static thread_local std::vector<std::vector<Server::IngressShard::Recipient>> recipients;
+	recipients.resize(m_shards.size());
 
-	//Setting global references.
-	g_globals.connectionHandler = connectionHandler;
-	g_globals.entityHandler		= entityHandler;
-	g_globals.networkHandler    = std::shared_ptr<NetworkHandler>(this);
-	g_globals.world             = world;
+	for (const enet_uint32 clientHandle : cHandler->get_client_handles())
+	{
+		if (RefClientInfo clientInfo = cHandler->get_client_info(clientHandle); clientInfo != nullptr)
+		{
+			for (size_t i = 0; i < m_shards.size(); i++)
+			{
+				if (m_shards[i]->owns(clientInfo->peer))
+				{
+					recipients[i].push_back({ clientInfo->peer, clientHandle });
+					break;
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < m_shards.size(); i++)
+	{
+		if (!recipients[i].empty())
+		{
+			m_shards[i]->multicast(recipients[i], _channel, _data, _flags);
+			recipients[i].clear();
+		}
+	}
+}
 
-	world->init();
+void NetworkHandler::disconnect(ENetPeer* _peer, const enet_uint32 _clienthandle)
+{
+	//*-------------------------------------------------------------------------
+	// The shard disconnects the peer without an event, so the route never gets
+	// erased by routing its disconnect. A failed transfer ends up here as well.
+	//*
+	{
+		std::lock_guard<std::mutex> lock(m_routeMutex);
+		m_routes.erase(_clienthandle);
+	}
 
-	float ticktimer = 0.0f;
+	if (Server::IngressShard* shard = get_shard(_peer); shard != nullptr)
+	{
+		shard->disconnect(_peer, _clienthandle);
+	}
+}
 
-	while(is_running)
+const bool NetworkHandler::get_peer_stats(const ENetPeer* _peer, const enet_uint32 _clienthandle, Server::PeerStats& _stats) const
+{
+	Server::IngressShard* shard = get_shard(_peer);
+	return shard != nullptr && shard->get_stats(_peer, _clienthandle, _stats);
+}
+
+Server::IngressShard* NetworkHandler::get_shard(const ENetPeer* _peer) const
+{
+	for (const std::unique_ptr<Server::IngressShard>& shard : m_shards)
 	{
-		DM::SERVER::Config::update_deltaTime();
-		ticktimer += DM::SERVER::Config::get_deltaTime();
+		if (shard->owns(_peer))
+			return shard.get();
+	}
+
+	return nullptr;
+}
 
-		ENetEvent e;
+void NetworkHandler::collect_events(const uint32_t _instanceId, std::vector<Server::IngressEvent>& _events)
+{
+	std::lock_guard<std::mutex> lock(m_routeMutex);
 
-		if(enet_host_service(m_server, &e, 10) > 0) //Try and catch packets before handling them
+	//Whichever instance ticks first routes everything the shards received, the others pick up their share on their own tick.
+	for (const std::unique_ptr<Server::IngressShard>& shard : m_shards)
+	{
+		shard->poll_events(m_polled);
+	}
+
+	for (Server::IngressEvent& event : m_polled)
+	{
+		switch (event.event.type)
 		{
-			switch (e.type)
+			//New clients always join the default instance.
+			case ENET_EVENT_TYPE_CONNECT:
+			{
+				m_routes[event.clientHandle] = DEFAULT_INSTANCE;
+				m_routed[DEFAULT_INSTANCE].push_back(event);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_DISCONNECT:
 			{
-				case ENET_EVENT_TYPE_CONNECT:
+				if (auto it = m_routes.find(event.clientHandle); it != m_routes.end())
 				{
-					connectionHandler->register_client(e.peer);
+					m_routed[it->second].push_back(event);
+					m_routes.erase(it);
 				}
-				break;
+			}
+			break;
 
-				case ENET_EVENT_TYPE_DISCONNECT:
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				if (auto it = m_routes.find(event.clientHandle); it != m_routes.end())
 				{
-					connectionHandler->disconnect_client(e.peer->connectID);
+					m_routed[it->second].push_back(event);
 				}
-				break;
-
-				case ENET_EVENT_TYPE_RECEIVE:
+				else
 				{
-					RefClientInfo clientInfo = connectionHandler->get_client_info(e.peer->connectID);
-					Server::EventHandler::queue_incoming_event(&e, clientInfo);
-					enet_packet_destroy(e.packet);
+					enet_packet_destroy(event.event.packet);
 				}
-				break;
 			}
+			break;
 		}
+	}
 
-		//*----
-		// Tick
-		//*
-		if (ticktimer > m_tickDuration)
-		{
-			ticktimer = 0.0f;
-			{
-				Server::EventHandler::handle_queud_events();
-				connectionHandler->update_idle_timers();
-				entityHandler->tick();
-			}
-		}
+	m_polled.clear();
+
+	std::vector<Server::IngressEvent>& routed = m_routed[_instanceId];
+
+	_events.insert(_events.end(), routed.begin(), routed.end());
+	routed.clear();
+}
+
+const bool NetworkHandler::transfer_client(ENetPeer* _peer, const enet_uint32 _clienthandle, const uint32_t _instanceId)
+{
+	std::lock_guard<std::mutex> lock(m_routeMutex);
+
+	//Once the route is gone the disconnect of the client already got routed to the instance it's leaving.
+	auto it = m_routes.find(_clienthandle);
+
+	if (it == m_routes.end() || _instanceId >= m_instances.size())
+		return false;
+
+	it->second = _instanceId;
+
+	//The instance the client joins registers it just like a client that connected.
+	Server::IngressEvent event;
+	event.event.type   = ENET_EVENT_TYPE_CONNECT;
+	event.event.peer   = _peer;
+	event.event.data   = 0; //Transferred clients never carry a handoff token.
+	event.clientHandle = _clienthandle;
+
+	m_routed[_instanceId].push_back(event);
+	return true;
+}
+
+std::shared_ptr<Server::WorldInstance> NetworkHandler::create_instance()
+{
+	std::lock_guard<std::mutex> lock(m_routeMutex);
+
+	auto instance = std::make_shared<Server::WorldInstance>(static_cast<uint32_t>(m_instances.size()), m_self);
+
+	m_instances.push_back(instance);
+	m_routed.emplace_back();
+
+	return instance;
+}
+
+const uint32_t NetworkHandler::get_instance_count()
+{
+	std::lock_guard<std::mutex> lock(m_routeMutex);
+	return static_cast<uint32_t>(m_instances.size());
+}
+
+void NetworkHandler::start_ticking(std::shared_ptr<Server::ZoneLink> _zoneLink)
+{
+	//The network handler outlives every instance, they only borrow it.
+	m_self = std::shared_ptr<NetworkHandler>(this, [](NetworkHandler*) {});
+
+	for (const std::unique_ptr<Server::IngressShard>& shard : m_shards)
+	{
+		shard->start();
+	}
+
+	std::shared_ptr<Server::WorldInstance> defaultInstance = create_instance();
+	defaultInstance->set_zone_link(_zoneLink);
+	defaultInstance->run();
+
+	std::vector<std::shared_ptr<Server::WorldInstance>> instances;
+	{
+		std::lock_guard<std::mutex> lock(m_routeMutex);
+		instances = m_instances;
+	}
+
+	for (const std::shared_ptr<Server::WorldInstance>& instance : instances)
+	{
+		instance->stop();
+	}
+
+	for (const std::unique_ptr<Server::IngressShard>& shard : m_shards)
+	{
+		shard->stop();
 	}
 }
 
@@ -127,12 +300,9 @@ void NetworkHandler::destroy()
 	delete this;
 }
 
-NetworkHandler::~NetworkHandler()
-{
-	enet_host_destroy(m_server);
-}
+NetworkHandler::~NetworkHandler() = default;
 
-NetworkHandler::NetworkHandler(ENetHost* _server)
+NetworkHandler::NetworkHandler(std::vector<std::unique_ptr<Server::IngressShard>> _shards) :
+	m_shards(std::move(_shards))
 {
-	m_server = _server;
 }
@@ -0,0 +1,171 @@
+#include "precomp.h"
+
+#include "Core/Network/Reactor/Reactor.h"
+
+#include <enet/enet.h>
+
+#include <thread>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+
+#include <sys/timerfd.h>
+
+#include <sys/eventfd.h>
+
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+Server::Reactor::Reactor(ENetHost* _host) :
+	m_host(_host)
+{
+#ifdef __linux__
+	m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+	m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	m_wakeFd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (m_epollFd < 0 || m_timerFd < 0 || m_wakeFd < 0)
+	{
+		DEVIOUS_WARN("Couldn't create the epoll reactor, falling back to waiting on the socket. errno: " << errno);
+		return;
+	}
+
+	epoll_event timerEvent = {};
+	timerEvent.events   = EPOLLIN;
+	timerEvent.data.u32 = SOURCE_TIMER;
+
+	epoll_event wakeEvent = {};
+	wakeEvent.events   = EPOLLIN;
+	wakeEvent.data.u32 = SOURCE_WAKE;
+
+	bool bIsRegistered = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_timerFd, &timerEvent) == 0
+		              && epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wakeEvent) == 0;
+
+	if (m_host != nullptr)
+	{
+		epoll_event socketEvent = {};
+		socketEvent.events   = EPOLLIN;
+		socketEvent.data.u32 = SOURCE_SOCKET;
+
+		bIsRegistered = bIsRegistered && epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_host->socket, &socketEvent) == 0;
+	}
+
+	if (!bIsRegistered)
+	{
+		DEVIOUS_WARN("Couldn't register the descriptors to the epoll reactor, falling back to waiting on the socket. errno: " << errno);
+
+		close(m_epollFd);
+		m_epollFd = -1;
+	}
+#endif
+}
+
+Server::Reactor::~Reactor()
+{
+#ifdef __linux__
+	for (const int fd : { m_epollFd, m_timerFd, m_wakeFd })
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+	}
+#endif
+}
+
+const bool Server::Reactor::wait_until(const Clock::time_point _deadline)
+{
+	const Clock::time_point now = Clock::now();
+
+	if (now >= _deadline)
+		return false;
+
+#ifdef __linux__
+	if (m_epollFd >= 0)
+	{
+		//*----------------------------------------------------------------------
+		// The steady clock is CLOCK_MONOTONIC, so the deadline can be armed as
+		// an absolute time and doesn't shift by however long arming it takes.
+		//*
+		const auto deadline = std::chrono::duration_cast<std::chrono::nanoseconds>(_deadline.time_since_epoch()).count();
+
+		itimerspec timer = {};
+		timer.it_value.tv_sec  = static_cast<time_t>(deadline / 1000000000);
+		timer.it_value.tv_nsec = static_cast<long>(deadline % 1000000000);
+
+		timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &timer, nullptr);
+
+		epoll_event events[MAX_EVENTS];
+		int count;
+
+		do
+		{
+			count = epoll_wait(m_epollFd, events, MAX_EVENTS, -1);
+		}
+		while (count < 0 && errno == EINTR);
+
+		bool bIsReadable = false;
+
+		for (int i = 0; i < count; i++)
+		{
+			if (events[i].data.u32 == SOURCE_SOCKET)
+			{
+				bIsReadable = true;
+				continue;
+			}
+
+			//Consume the expiration or wakeup, otherwise the descriptor stays readable.
+			uint64_t value;
+			[[maybe_unused]] const ssize_t bytesRead = read(events[i].data.u32 == SOURCE_TIMER ? m_timerFd : m_wakeFd, &value, sizeof(value));
+		}
+
+		return bIsReadable;
+	}
+#endif
+
+	if (m_host == nullptr)
+	{
+		std::this_thread::sleep_until(_deadline);
+		return false;
+	}
+
+	//Round up, waking up early would only make us wait again.
+	const auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(_deadline - now + std::chrono::microseconds(999));
+
+	enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE | ENET_SOCKET_WAIT_INTERRUPT;
+
+	if (enet_socket_wait(m_host->socket, &condition, static_cast<enet_uint32>(timeout.count())) != 0)
+		return false;
+
+	return (condition & ENET_SOCKET_WAIT_RECEIVE) != 0;
+}
+
+void Server::Reactor::watch(ENetHost* _host)
+{
+#ifdef __linux__
+	if (m_epollFd < 0)
+		return;
+
+	epoll_event socketEvent = {};
+	socketEvent.events   = EPOLLIN;
+	socketEvent.data.u32 = SOURCE_SOCKET;
+
+	if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, _host->socket, &socketEvent) != 0)
+	{
+		DEVIOUS_WARN("Couldn't register the socket of the host to the epoll reactor. errno: " << errno);
+	}
+#endif
+}
+
+void Server::Reactor::wake()
+{
+#ifdef __linux__
+	if (m_wakeFd >= 0)
+	{
+		const uint64_t value = 1;
+		[[maybe_unused]] const ssize_t bytesWritten = write(m_wakeFd, &value, sizeof(value));
+	}
+#endif
+}
@@ -0,0 +1,329 @@
+#include "precomp.h"
+
+#include "Core/Network/Replication/ReplicationHandler.h"
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+#include "Core/Network/NetworkHandler.h"
+
+#include "Core/Network/Client/ClientInfo.h"
+
+#include "Core/Network/Connection/ConnectionHandler.h"
+
+#include "Core/Game/Entity/EntityHandler.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Core/Events/Scheduler/ActionScheduler.h"
+
+#include "Core/Globals/S_Globals.h"
+
+#include <algorithm>
+
+using namespace DM::Replication;
+
+void Server::ReplicationHandler::tick()
+{
+	if (!m_bIsEnabled)
+		return;
+
+	capture();
+
+	for (const enet_uint32 clientHandle : g_globals.connectionHandler->get_client_handles())
+	{
+		RefClientInfo clientInfo = g_globals.connectionHandler->get_client_info(clientHandle);
+
+		if (clientInfo == nullptr)
+			continue;
+
+		ClientReplication& client = m_clients[clientHandle];
+
+		if (std::optional<ConnectionStats> optStats = g_globals.telemetryHandler->get_stats(clientHandle); optStats.has_value())
+		{
+			update_byte_budget(client, optStats.value());
+		}
+
+		//The client no longer holds the snapshot it acknowledged last, start over from the full state.
+		if (client.ackedSequence != 0 && m_sequence - client.ackedSequence >= SNAPSHOT_HISTORY)
+		{
+			client.ackedSequence = 0;
+			client.ackedView.clear();
+		}
+
+		collect_delta(client.ackedView, m_current, m_diffs);
+
+		//*--------------------------------------------------------------------------
+		// Nothing changed since the baseline, only send a snapshot every so often to
+		// let the client acknowledge a newer one before its baseline gets too old.
+		//*
+		if (m_diffs.empty() && client.ackedSequence != 0 && m_sequence - client.ackedSequence < SNAPSHOT_HISTORY / 2)
+		{
+			client.priorities.clear();
+			continue;
+		}
+
+		prioritise(client, clientHandle);
+		send_snapshot(client, clientInfo->peer, clientHandle);
+	}
+}
+
+void Server::ReplicationHandler::acknowledge(const enet_uint32 _clienthandle, const uint32_t _sequence)
+{
+	ClientReplication& client = m_clients[_clienthandle];
+
+	const SentSnapshot& sent = client.sent[_sequence % SNAPSHOT_HISTORY];
+
+	if (sent.sequence != _sequence || _sequence <= client.ackedSequence)
+		return;
+
+	//*-----------------------------------------------------------------------------
+	// The client rebuilt this snapshot on top of the baseline it got written against.
+	// When our view already moved past that baseline, we can't reproduce what the
+	// client holds, so we stick to our current view until the next acknowledgement.
+	//*
+	if (sent.baseline != client.ackedSequence)
+		return;
+
+	apply_diffs(client.ackedView, sent.diffs, m_view);
+	client.ackedView.swap(m_view);
+	client.ackedSequence = _sequence;
+}
+
+void Server::ReplicationHandler::remove_client(const enet_uint32 _clienthandle)
+{
+	m_clients.erase(_clienthandle);
+}
+
+void Server::ReplicationHandler::set_enabled(const bool _bIsEnabled)
+{
+	m_bIsEnabled = _bIsEnabled;
+}
+
+const bool Server::ReplicationHandler::is_enabled() const
+{
+	return m_bIsEnabled;
+}
+
+const uint32_t Server::ReplicationHandler::get_sequence() const
+{
+	return m_sequence;
+}
+
+const uint32_t Server::ReplicationHandler::get_byte_budget(const enet_uint32 _clienthandle) const
+{
+	const auto it = m_clients.find(_clienthandle);
+	return it != m_clients.end() ? it->second.byteBudget : INITIAL_BYTE_BUDGET;
+}
+
+void Server::ReplicationHandler::capture()
+{
+	m_sequence++;
+	m_previous.swap(m_current);
+	m_current.clear();
+
+	//*-----------------------------------------------------------------
+	// Read the replicated state of every entity, entities whose fields
+	// aren't dirty keep pointing to the state of the previous snapshot.
+	//*
+	for (const std::shared_ptr<Entity>& entity : g_globals.entityHandler->get_all_entities())
+	{
+		s_ReplicatedState state = s_ReplicatedState::get_default();
+		state.posX      = entity->position.x;
+		state.posY      = entity->position.y;
+		state.bIsHidden = entity->is_hidden();
+		state.bIsDead   = entity->is_dead();
+
+		if (auto player = std::dynamic_pointer_cast<Player>(entity); player != nullptr)
+		{
+			state.name = player->get_shown_name();
+		}
+		else if (auto npc = std::dynamic_pointer_cast<NPC>(entity); npc != nullptr)
+		{
+			state.npcId = npc->npcId;
+		}
+
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			const DM::SKILLS::e_skills skillType = static_cast<DM::SKILLS::e_skills>(i);
+
+			state.levels[i]        = entity->skills[skillType].level;
+			state.boostedLevels[i] = entity->skills[skillType].levelboosted;
+		}
+
+		const uint64_t entityId = entity->uuid;
+
+		const auto it = std::lower_bound(m_previous.begin(), m_previous.end(), entityId, [](const s_ReplicatedEntity& _entity, const uint64_t _id)
+		{
+			return _entity.entityId < _id;
+		});
+
+		if (it != m_previous.end() && it->entityId == entityId && it->state->npcId == state.npcId && get_dirty_fields(*it->state, state) == 0)
+		{
+			m_current.push_back(*it);
+			continue;
+		}
+
+		m_current.push_back({ entityId, std::make_shared<const s_ReplicatedState>(std::move(state)) });
+	}
+
+	std::sort(m_current.begin(), m_current.end(), [](const s_ReplicatedEntity& _a, const s_ReplicatedEntity& _b)
+	{
+		return _a.entityId < _b.entityId;
+	});
+}
+
+void Server::ReplicationHandler::update_byte_budget(ClientReplication& _client, const ConnectionStats& _stats)
+{
+	const bool bIsCongested = _stats.packetLoss > MAX_PACKET_LOSS
+		                   || _stats.roundTripTime > static_cast<float>(_stats.lowestRoundTripTime * 2 + ROUND_TRIP_MARGIN_MS);
+
+	if (bIsCongested)
+	{
+		_client.byteBudget = std::max<uint32_t>(MIN_BYTE_BUDGET, _client.byteBudget / 4 * 3);
+	}
+	else
+	{
+		_client.byteBudget = std::min<uint32_t>(MAX_BYTE_BUDGET, _client.byteBudget + BYTE_BUDGET_STEP);
+	}
+}
+
+void Server::ReplicationHandler::prioritise(ClientReplication& _client, const enet_uint32 _clienthandle)
+{
+	std::shared_ptr<Server::EntityHandler> eHandler = g_globals.entityHandler;
+
+	RefClientInfo clientInfo = g_globals.connectionHandler->get_client_info(_clienthandle);
+
+	//Players are stored by their client handle, those that are still joining might not have an entity yet.
+	std::shared_ptr<Entity> player;
+
+	if (auto optPlayer = eHandler->get_entity(static_cast<uint64_t>(_clienthandle)); optPlayer.has_value())
+	{
+		player = optPlayer.value();
+	}
+
+	//*---------------------------------------------------------------------------
+	// Entities that no longer differ from what the client acknowledged stop waiting,
+	// that includes the ones that despawned once the client acknowledged the removal.
+	//*
+	for (auto it = _client.priorities.begin(); it != _client.priorities.end();)
+	{
+		const auto diff = std::lower_bound(m_diffs.begin(), m_diffs.end(), it->first, [](const s_ReplicatedDiff& _diff, const uint64_t _id)
+		{
+			return _diff.entityId < _id;
+		});
+
+		if (diff == m_diffs.end() || diff->entityId != it->first)
+		{
+			it = _client.priorities.erase(it);
+			continue;
+		}
+
+		++it;
+	}
+
+	m_candidates.clear();
+
+	for (size_t i = 0; i < m_diffs.size(); i++)
+	{
+		const s_ReplicatedDiff&  diff  = m_diffs[i];
+		const s_ReplicatedState& state = diff.state != nullptr ? *diff.state : *diff.baseline;
+
+		float priority = 1.0f;
+
+		if (player != nullptr)
+		{
+			bool bIsInCombat = diff.entityId == clientInfo->combatTarget;
+
+			//Npc's that are attacking the player matter just as much as whatever the player is attacking.
+			if (!bIsInCombat && diff.op != e_ReplicatedOp::REMOVE && state.npcId != 0)
+			{
+				if (auto optEntity = eHandler->get_entity(diff.entityId); optEntity.has_value())
+				{
+					auto npc = std::dynamic_pointer_cast<NPC>(optEntity.value());
+					bIsInCombat = npc != nullptr && npc->get_target() == player;
+				}
+			}
+
+			if (diff.entityId == player->uuid)
+			{
+				priority = OWN_PLAYER_PRIORITY;
+			}
+			else if (bIsInCombat)
+			{
+				priority = COMBAT_PRIORITY;
+			}
+			else
+			{
+				const int32_t distance = std::max(std::abs(state.posX - player->position.x), std::abs(state.posY - player->position.y));
+				priority = 1.0f + DISTANCE_PRIORITY / static_cast<float>(1 + distance);
+			}
+		}
+
+		float& accumulated = _client.priorities[diff.entityId];
+		accumulated += priority;
+
+		m_candidates.push_back({ i, accumulated });
+	}
+
+	std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& _a, const Candidate& _b)
+	{
+		return _a.priority > _b.priority;
+	});
+}
+
+void Server::ReplicationHandler::send_snapshot(ClientReplication& _client, ENetPeer* _peer, const enet_uint32 _clienthandle)
+{
+	//*---------------------------------------------------------------------------
+	// Take the most important entities until the budget runs out, the rest keeps
+	// its accumulated priority so it eventually makes it through as well.
+	//*
+	const size_t budgetBits = static_cast<size_t>(_client.byteBudget) * 8;
+	size_t usedBits = 0;
+
+	m_selected.clear();
+
+	for (const Candidate& candidate : m_candidates)
+	{
+		const s_ReplicatedDiff& diff = m_diffs[candidate.diffIndex];
+
+		m_scratch.reset();
+		write_diff(diff, m_scratch);
+
+		//Always send at least a single entity, otherwise a large entity could block a small budget forever.
+		if (usedBits + m_scratch.get_bit_count() > budgetBits && !m_selected.empty())
+			break;
+
+		usedBits += m_scratch.get_bit_count();
+		m_selected.push_back(diff);
+		_client.priorities.erase(diff.entityId);
+	}
+
+	//The reader expects the entities in the same order as they're stored in the snapshot.
+	std::sort(m_selected.begin(), m_selected.end(), [](const s_ReplicatedDiff& _a, const s_ReplicatedDiff& _b)
+	{
+		return _a.entityId < _b.entityId;
+	});
+
+	m_writer.reset();
+
+	for (const s_ReplicatedDiff& diff : m_selected)
+	{
+		write_diff(diff, m_writer);
+	}
+
+	write_end(m_writer);
+
+	SentSnapshot& sent = _client.sent[m_sequence % SNAPSHOT_HISTORY];
+	sent.sequence = m_sequence;
+	sent.baseline = _client.ackedSequence;
+	sent.diffs.swap(m_selected);
+
+	Packets::s_StateSnapshot packet;
+	packet.interpreter = e_PacketInterpreter::PACKET_STATE_SNAPSHOT;
+	packet.sequence    = m_sequence;
+	packet.baseline    = _client.ackedSequence;
+	packet.tick        = static_cast<uint32_t>(g_globals.scheduler->get_current_tick());
+	packet.data        = m_writer.get_data();
+
+	g_globals.networkHandler->send_packet<Packets::s_StateSnapshot>(&packet, _peer, _clienthandle, CHANNEL_SNAPSHOT, 0);
+}
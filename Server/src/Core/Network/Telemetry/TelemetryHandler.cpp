@@ -0,0 +1,119 @@
+#include "precomp.h"
+
+#include "Core/Network/Telemetry/TelemetryHandler.h"
+
+#include "Core/Network/NetworkHandler.h"
+
+#include "Core/Network/Ingress/IngressShard.h"
+
+#include "Core/Globals/S_Globals.h"
+
+#include <enet/enet.h>
+
+#include <algorithm>
+
+void Server::TelemetryHandler::register_client(const enet_uint32 _clienthandle, ENetPeer* _peer)
+{
+	//The data totals of the peer are only known after its first sample.
+	m_clients[_clienthandle].peer = _peer;
+}
+
+void Server::TelemetryHandler::remove_client(const enet_uint32 _clienthandle)
+{
+	m_clients.erase(_clienthandle);
+}
+
+void Server::TelemetryHandler::tick()
+{
+	const enet_uint32 time = enet_time_get();
+
+	for (auto& [clientHandle, client] : m_clients)
+	{
+		sample(client, clientHandle, time);
+	}
+}
+
+std::optional<Server::ConnectionStats> Server::TelemetryHandler::get_stats(const enet_uint32 _clienthandle) const
+{
+	const auto it = m_clients.find(_clienthandle);
+
+	if (it == m_clients.end())
+		return std::nullopt;
+
+	return it->second.stats;
+}
+
+void Server::TelemetryHandler::sample(ClientTelemetry& _client, const enet_uint32 _clienthandle, const enet_uint32 _time)
+{
+	PeerStats peer;
+
+	if (!g_globals.networkHandler->get_peer_stats(_client.peer, _clienthandle, peer))
+		return;
+
+	if (!_client.bHasDataTotals)
+	{
+		_client.lastOutgoingDataTotal = peer.outgoingDataTotal;
+		_client.lastIncomingDataTotal = peer.incomingDataTotal;
+		_client.bHasDataTotals        = true;
+	}
+
+	//*-------------------------------------------------------------------------------
+	// ENet zeroes the data totals of its peers while throttling bandwidth, a total
+	// lower than last time means it got reset and everything in it is new data.
+	//*
+	const enet_uint32 outgoing = peer.outgoingDataTotal >= _client.lastOutgoingDataTotal ? peer.outgoingDataTotal - _client.lastOutgoingDataTotal : peer.outgoingDataTotal;
+	const enet_uint32 incoming = peer.incomingDataTotal >= _client.lastIncomingDataTotal ? peer.incomingDataTotal - _client.lastIncomingDataTotal : peer.incomingDataTotal;
+
+	_client.lastOutgoingDataTotal = peer.outgoingDataTotal;
+	_client.lastIncomingDataTotal = peer.incomingDataTotal;
+
+	Sample& newest = _client.samples[_client.sampleCount % SAMPLE_WINDOW];
+	newest.time          = _time;
+	newest.roundTripTime = peer.roundTripTime;
+	newest.jitter        = peer.roundTripTimeVariance;
+	newest.packetLoss    = peer.packetLoss;
+	newest.bytesSent     = outgoing;
+	newest.bytesReceived = incoming;
+
+	_client.sampleCount++;
+
+	//*----------------------------------------------------------------------
+	// Average everything within the window, the data of the oldest sample
+	// got sent before the window started so it only marks its start time.
+	//*
+	const uint32_t count  = std::min(_client.sampleCount, SAMPLE_WINDOW);
+	const Sample&  oldest = _client.samples[(_client.sampleCount - count) % SAMPLE_WINDOW];
+
+	uint64_t roundTripTime = 0, jitter = 0, packetLoss = 0, bytesSent = 0, bytesReceived = 0;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const Sample& sample = _client.samples[i];
+
+		roundTripTime += sample.roundTripTime;
+		jitter        += sample.jitter;
+		packetLoss    += sample.packetLoss;
+
+		if (&sample != &oldest)
+		{
+			bytesSent     += sample.bytesSent;
+			bytesReceived += sample.bytesReceived;
+		}
+	}
+
+	ConnectionStats& stats = _client.stats;
+	stats.roundTripTime = static_cast<float>(roundTripTime) / count;
+	stats.jitter        = static_cast<float>(jitter) / count;
+	stats.packetLoss    = static_cast<float>(packetLoss) / count / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
+
+	//ENet starts out with a made up round trip time, but it only ever gets lower once it's actually measured.
+	stats.lowestRoundTripTime = std::min<uint32_t>(stats.lowestRoundTripTime, peer.roundTripTime);
+
+	const enet_uint32 elapsed = _time - oldest.time;
+
+	if (elapsed > 0)
+	{
+		stats.bytesSentPerSecond     = static_cast<float>(bytesSent) * 1000.0f / elapsed;
+		stats.bytesReceivedPerSecond = static_cast<float>(bytesReceived) * 1000.0f / elapsed;
+	}
+}
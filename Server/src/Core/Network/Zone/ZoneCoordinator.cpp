@@ -0,0 +1,103 @@
+#include "precomp.h"
+
+#include "Core/Network/Zone/ZoneCoordinator.h"
+
+#include "Core/Network/Zone/ZonePackets.h"
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+#include <enet/enet.h>
+
+Server::ZoneCoordinator::ZoneCoordinator(const ZoneLayout& _layout, const uint16_t _port) :
+	m_layout(_layout)
+{
+	ENetAddress address;
+	address.m_host = ENET_HOST_ANY;
+	address.port = _port;
+
+	m_host = enet_host_create(&address, m_layout.get_zones().size() + 1, ZONE_CHANNEL_COUNT, 0, 0);
+
+	if (m_host == nullptr)
+	{
+		DEVIOUS_ERR("An error occurred while trying to create the zone coordinator host.");
+		exit(EXIT_FAILURE);
+	}
+
+	DEVIOUS_EVENT("Zone coordinator listening on port " << _port << " for " << m_layout.get_zones().size() << " zone(s).");
+}
+
+Server::ZoneCoordinator::~ZoneCoordinator()
+{
+	enet_host_destroy(m_host);
+}
+
+void Server::ZoneCoordinator::run()
+{
+	ENetEvent e;
+
+	while (true)
+	{
+		if (enet_host_service(m_host, &e, 1000) <= 0)
+			continue;
+
+		switch (e.type)
+		{
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				Packets::s_ZonePacket packet;
+				PacketHandler::retrieve_packet_data<Packets::s_ZonePacket>(packet, &e);
+
+				if (packet.type == e_ZonePacket::ZONE_REGISTER)
+				{
+					ZoneDefinition* zone = m_layout.get_zone(packet.zoneId);
+
+					if (zone == nullptr || zone->bIsOnline)
+					{
+						DEVIOUS_WARN("Refused zone " << packet.zoneId << ", it isn't part of the layout or is already online.");
+						enet_peer_disconnect(e.peer, 0);
+					}
+					else
+					{
+						zone->bIsOnline = true;
+						m_zones[e.peer] = packet.zoneId;
+
+						DEVIOUS_EVENT("Zone " << packet.zoneId << " came online.");
+						broadcast_layout();
+					}
+				}
+
+				enet_packet_destroy(e.packet);
+			}
+			break;
+
+			case ENET_EVENT_TYPE_DISCONNECT:
+			{
+				if (auto it = m_zones.find(e.peer); it != m_zones.end())
+				{
+					m_layout.get_zone(it->second)->bIsOnline = false;
+
+					DEVIOUS_WARN("Zone " << it->second << " went offline.");
+
+					m_zones.erase(it);
+					broadcast_layout();
+				}
+			}
+			break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void Server::ZoneCoordinator::broadcast_layout()
+{
+	Packets::s_ZoneLayout packet;
+	packet.type   = e_ZonePacket::ZONE_LAYOUT;
+	packet.layout = m_layout;
+
+	for (const auto& [peer, zoneId] : m_zones)
+	{
+		PacketHandler::send_packet<Packets::s_ZoneLayout>(&packet, peer, m_host, ZONE_CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+	}
+}
@@ -0,0 +1,123 @@
+#include "precomp.h"
+
+#include "Core/Network/Zone/ZoneLayout.h"
+
+#include <sstream>
+
+const bool Server::ZoneDefinition::contains(const Utilities::ivec2 _position) const
+{
+	return _position.x >= minX && _position.x < maxX && _position.y >= minY && _position.y < maxY;
+}
+
+const bool Server::ZoneDefinition::is_near(const Utilities::ivec2 _position, const int32_t _margin) const
+{
+	return _position.x >= minX - _margin && _position.x < maxX + _margin && _position.y >= minY - _margin && _position.y < maxY + _margin;
+}
+
+std::optional<Server::ZoneLayout> Server::ZoneLayout::load(const std::string& _path)
+{
+	std::ifstream file(_path);
+
+	if (!file.is_open())
+	{
+		DEVIOUS_ERR("Couldn't open the zone layout: " << _path);
+		return std::nullopt;
+	}
+
+	ZoneLayout layout;
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+		//Skip empty lines & comments.
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream is(line);
+
+		ZoneDefinition zone;
+
+		if (!(is >> zone.zoneId >> zone.minX >> zone.minY >> zone.maxX >> zone.maxY >> zone.address >> zone.clientPort >> zone.linkPort))
+		{
+			DEVIOUS_ERR("Invalid zone within the layout: " << line);
+			return std::nullopt;
+		}
+
+		if (layout.get_zone(zone.zoneId) != nullptr)
+		{
+			DEVIOUS_ERR("Zone " << zone.zoneId << " is defined twice within the layout.");
+			return std::nullopt;
+		}
+
+		layout.m_zones.push_back(zone);
+	}
+
+	return layout;
+}
+
+Server::ZoneLayout Server::ZoneLayout::create_loopback(const int32_t _columns, const int32_t _rows, const int32_t _zoneSize)
+{
+	ZoneLayout layout;
+
+	for (int32_t y = 0; y < _rows; y++)
+	{
+		for (int32_t x = 0; x < _columns; x++)
+		{
+			ZoneDefinition zone;
+			zone.zoneId     = static_cast<uint32_t>(y * _columns + x);
+			zone.minX       = x * _zoneSize;
+			zone.minY       = y * _zoneSize;
+			zone.maxX       = zone.minX + _zoneSize;
+			zone.maxY       = zone.minY + _zoneSize;
+			zone.clientPort = static_cast<uint16_t>(LOOPBACK_CLIENT_PORT + zone.zoneId);
+			zone.linkPort   = static_cast<uint16_t>(LOOPBACK_LINK_PORT + zone.zoneId);
+
+			layout.m_zones.push_back(zone);
+		}
+	}
+
+	return layout;
+}
+
+const Server::ZoneDefinition* Server::ZoneLayout::find_zone(const Utilities::ivec2 _position) const
+{
+	for (const ZoneDefinition& zone : m_zones)
+	{
+		if (zone.contains(_position))
+			return &zone;
+	}
+
+	return nullptr;
+}
+
+const Server::ZoneDefinition* Server::ZoneLayout::get_zone(const uint32_t _zoneId) const
+{
+	for (const ZoneDefinition& zone : m_zones)
+	{
+		if (zone.zoneId == _zoneId)
+			return &zone;
+	}
+
+	return nullptr;
+}
+
+Server::ZoneDefinition* Server::ZoneLayout::get_zone(const uint32_t _zoneId)
+{
+	return const_cast<ZoneDefinition*>(static_cast<const ZoneLayout*>(this)->get_zone(_zoneId));
+}
+
+const bool Server::ZoneLayout::are_neighbours(const ZoneDefinition& _a, const ZoneDefinition& _b, const int32_t _margin)
+{
+	return _a.minX - _margin < _b.maxX && _b.minX < _a.maxX + _margin
+		&& _a.minY - _margin < _b.maxY && _b.minY < _a.maxY + _margin;
+}
+
+std::vector<Server::ZoneDefinition>& Server::ZoneLayout::get_zones()
+{
+	return m_zones;
+}
+
+const std::vector<Server::ZoneDefinition>& Server::ZoneLayout::get_zones() const
+{
+	return m_zones;
+}
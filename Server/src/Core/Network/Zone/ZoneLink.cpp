@@ -0,0 +1,802 @@
+#include "precomp.h"
+
+#include "Core/Network/Zone/ZoneLink.h"
+
+#include "Core/Network/NetworkHandler.h"
+
+#include "Core/Network/Connection/ConnectionHandler.h"
+
+#include "Core/Network/Client/ClientInfo.h"
+
+#include "Core/Game/Entity/EntityHandler.h"
+
+#include "Core/Events/Query/EventQuery.h"
+
+#include "Core/Globals/S_Globals.h"
+
+#include "Shared/Network/Packets/PacketHandler.hpp"
+
+#include <enet/enet.h>
+
+#include <enet/time.h>
+
+template<class T>
+void Server::ZoneLink::send(ENetPeer* _peer, T* _packet, const uint8_t _channel, const enet_uint32 _flags)
+{
+	_packet->zoneId = m_zoneId;
+	PacketHandler::send_packet<T>(_packet, _peer, m_host, _channel, _flags);
+}
+
+std::shared_ptr<Server::ZoneLink> Server::ZoneLink::join(const uint32_t _zoneId, const char* _coordinatorAddress, const uint16_t _coordinatorPort)
+{
+	ENetHost* coordinatorHost = enet_host_create(nullptr, 1, ZONE_CHANNEL_COUNT, 0, 0);
+
+	if (coordinatorHost == nullptr)
+	{
+		DEVIOUS_ERR("An error occurred while trying to create the host to reach the zone coordinator.");
+		return nullptr;
+	}
+
+	ENetAddress address;
+	enet_address_set_host(&address, _coordinatorAddress);
+	address.port = _coordinatorPort;
+
+	ENetPeer* coordinator = enet_host_connect(coordinatorHost, &address, ZONE_CHANNEL_COUNT, 0);
+
+	DEVIOUS_EVENT("Zone " << _zoneId << " is joining the coordinator at: [" << _coordinatorAddress << ":" << _coordinatorPort << "]...");
+
+	//*-------------------------------------------------------------------
+	// Register once connected, the coordinator answers with the layout or
+	// drops us when the zone is unknown or already online.
+	//*
+	std::optional<ZoneLayout> layout;
+	{
+		const enet_uint32 deadline = enet_time_get() + JOIN_TIMEOUT_MS;
+		bool bIsRefused = false;
+
+		ENetEvent e;
+
+		while (!layout.has_value() && !bIsRefused && ENET_TIME_LESS(enet_time_get(), deadline))
+		{
+			if (enet_host_service(coordinatorHost, &e, 100) <= 0)
+				continue;
+
+			switch (e.type)
+			{
+				case ENET_EVENT_TYPE_CONNECT:
+				{
+					Packets::s_ZonePacket packet;
+					packet.type   = e_ZonePacket::ZONE_REGISTER;
+					packet.zoneId = _zoneId;
+
+					PacketHandler::send_packet<Packets::s_ZonePacket>(&packet, coordinator, coordinatorHost, ZONE_CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+				}
+				break;
+
+				case ENET_EVENT_TYPE_RECEIVE:
+				{
+					Packets::s_ZonePacket header;
+					PacketHandler::retrieve_packet_data<Packets::s_ZonePacket>(header, &e);
+
+					if (header.type == e_ZonePacket::ZONE_LAYOUT)
+					{
+						Packets::s_ZoneLayout packet;
+						PacketHandler::retrieve_packet_data<Packets::s_ZoneLayout>(packet, &e);
+						layout = packet.layout;
+					}
+
+					enet_packet_destroy(e.packet);
+				}
+				break;
+
+				case ENET_EVENT_TYPE_DISCONNECT:
+				{
+					bIsRefused = true;
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+	if (!layout.has_value() || layout->get_zone(_zoneId) == nullptr)
+	{
+		DEVIOUS_ERR("Zone " << _zoneId << " couldn't join, the coordinator is unreachable or refused the zone.");
+		enet_host_destroy(coordinatorHost);
+		return nullptr;
+	}
+
+	//*---------------------------------------------------------
+	// Open the port the neighbouring zones connect to, every
+	// neighbour takes up a single peer.
+	//*
+	const ZoneDefinition* zone = layout->get_zone(_zoneId);
+
+	ENetAddress linkAddress;
+	linkAddress.m_host = ENET_HOST_ANY;
+	linkAddress.port = zone->linkPort;
+
+	ENetHost* host = enet_host_create(&linkAddress, layout->get_zones().size(), ZONE_CHANNEL_COUNT, 0, 0);
+
+	if (host == nullptr)
+	{
+		DEVIOUS_ERR("An error occurred while trying to open the link port " << zone->linkPort << " of zone " << _zoneId << ".");
+		enet_host_destroy(coordinatorHost);
+		return nullptr;
+	}
+
+	DEVIOUS_EVENT("Zone " << _zoneId << " joined, simulating [" << zone->minX << ", " << zone->minY << "] till [" << zone->maxX << ", " << zone->maxY << "].");
+
+	std::shared_ptr<ZoneLink> link(new ZoneLink(_zoneId, coordinatorHost, coordinator, host, layout.value()));
+	link->link_neighbours();
+
+	return link;
+}
+
+Server::ZoneLink::ZoneLink(const uint32_t _zoneId, ENetHost* _coordinatorHost, ENetPeer* _coordinator, ENetHost* _host, const ZoneLayout& _layout) :
+	m_zoneId(_zoneId),
+	m_coordinatorHost(_coordinatorHost),
+	m_coordinator(_coordinator),
+	m_host(_host),
+	m_layout(_layout)
+{
+}
+
+Server::ZoneLink::~ZoneLink()
+{
+	enet_host_destroy(m_host);
+	enet_host_destroy(m_coordinatorHost);
+}
+
+const Server::ZoneDefinition& Server::ZoneLink::get_zone() const
+{
+	return *m_layout.get_zone(m_zoneId);
+}
+
+void Server::ZoneLink::tick()
+{
+	m_tick++;
+
+	service();
+
+	for (const auto& [zoneId, mirror] : m_receivedMirrors)
+	{
+		apply_mirror(mirror);
+	}
+
+	m_receivedMirrors.clear();
+
+	if (m_tick % RECONNECT_TICK_INTERVAL == 0)
+	{
+		link_neighbours();
+	}
+
+	hand_off_entities();
+	send_mirrors();
+
+	//Players that never showed up, e.g because they closed the client while getting redirected.
+	for (auto it = m_pendingHandoffs.begin(); it != m_pendingHandoffs.end();)
+	{
+		if (it->second.expiryTick <= m_tick)
+		{
+			DEVIOUS_WARN("Dropped the handed off player " << it->second.entity.entityId << ", it never reconnected.");
+			it = m_pendingHandoffs.erase(it);
+		}
+		else ++it;
+	}
+
+	enet_host_flush(m_host);
+	enet_host_flush(m_coordinatorHost);
+}
+
+void Server::ZoneLink::service()
+{
+	ENetEvent e;
+
+	while (enet_host_service(m_coordinatorHost, &e, 0) > 0)
+	{
+		if (e.type == ENET_EVENT_TYPE_RECEIVE)
+		{
+			handle_packet(e);
+			enet_packet_destroy(e.packet);
+		}
+		else if (e.type == ENET_EVENT_TYPE_DISCONNECT)
+		{
+			DEVIOUS_WARN("Lost the connection with the zone coordinator, the links with the neighbours stay up.");
+		}
+	}
+
+	while (enet_host_service(m_host, &e, 0) > 0)
+	{
+		switch (e.type)
+		{
+			//Neighbours that dial us tell which zone they are through the connect data.
+			case ENET_EVENT_TYPE_CONNECT:
+			{
+				if (m_linkZones.find(e.peer) == m_linkZones.end())
+				{
+					m_links[e.data]     = e.peer;
+					m_linkZones[e.peer] = e.data;
+				}
+
+				DEVIOUS_EVENT("Zone " << m_zoneId << " linked with zone " << m_linkZones[e.peer] << ".");
+			}
+			break;
+
+			case ENET_EVENT_TYPE_RECEIVE:
+			{
+				handle_packet(e);
+				enet_packet_destroy(e.packet);
+			}
+			break;
+
+			//Also received when dialing a neighbour failed, it gets retried later on.
+			case ENET_EVENT_TYPE_DISCONNECT:
+			{
+				if (auto it = m_linkZones.find(e.peer); it != m_linkZones.end())
+				{
+					const uint32_t zoneId = it->second;
+
+					m_linkZones.erase(it);
+					m_links.erase(zoneId);
+
+					drop_mirrors(zoneId);
+
+					DEVIOUS_WARN("Zone " << m_zoneId << " lost its link with zone " << zoneId << ".");
+				}
+			}
+			break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void Server::ZoneLink::handle_packet(ENetEvent& _event)
+{
+	Packets::s_ZonePacket header;
+	PacketHandler::retrieve_packet_data<Packets::s_ZonePacket>(header, &_event);
+
+	switch (header.type)
+	{
+		case e_ZonePacket::ZONE_LAYOUT:
+		{
+			Packets::s_ZoneLayout packet;
+			PacketHandler::retrieve_packet_data<Packets::s_ZoneLayout>(packet, &_event);
+
+			m_layout = packet.layout;
+			link_neighbours();
+		}
+		break;
+
+		case e_ZonePacket::ZONE_HANDOFF:
+		{
+			Packets::s_ZoneHandoff packet;
+			PacketHandler::retrieve_packet_data<Packets::s_ZoneHandoff>(packet, &_event);
+			receive_handoff(packet);
+		}
+		break;
+
+		//Mirrors replace each other, only the latest one of the tick matters.
+		case e_ZonePacket::ZONE_MIRROR:
+		{
+			Packets::s_ZoneMirror packet;
+			PacketHandler::retrieve_packet_data<Packets::s_ZoneMirror>(packet, &_event);
+			m_receivedMirrors[packet.zoneId] = std::move(packet);
+		}
+		break;
+
+		case e_ZonePacket::ZONE_REMOTE_HIT:
+		{
+			Packets::s_ZoneRemoteHit packet;
+			PacketHandler::retrieve_packet_data<Packets::s_ZoneRemoteHit>(packet, &_event);
+			receive_hit(packet);
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+void Server::ZoneLink::link_neighbours()
+{
+	const ZoneDefinition& self = get_zone();
+
+	for (const ZoneDefinition& zone : m_layout.get_zones())
+	{
+		if (zone.zoneId >= m_zoneId || !zone.bIsOnline || m_links.find(zone.zoneId) != m_links.end())
+			continue;
+
+		if (!ZoneLayout::are_neighbours(self, zone, MIRROR_MARGIN))
+			continue;
+
+		ENetAddress address;
+		enet_address_set_host(&address, zone.address.c_str());
+		address.port = zone.linkPort;
+
+		if (ENetPeer* peer = enet_host_connect(m_host, &address, ZONE_CHANNEL_COUNT, m_zoneId); peer != nullptr)
+		{
+			m_links[zone.zoneId] = peer;
+			m_linkZones[peer]    = zone.zoneId;
+		}
+	}
+}
+
+ENetPeer* Server::ZoneLink::get_link(const uint32_t _zoneId) const
+{
+	if (auto it = m_links.find(_zoneId); it != m_links.end() && it->second->state == ENET_PEER_STATE_CONNECTED)
+	{
+		return it->second;
+	}
+
+	return nullptr;
+}
+
+void Server::ZoneLink::hand_off_entities()
+{
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	const ZoneDefinition& self = get_zone();
+
+	for (const std::shared_ptr<Entity>& entity : eHandler->get_all_entities())
+	{
+		//Dead entities respawn where they belong, their respawn is scheduled within this zone.
+		if (entity->is_mirror() || entity->is_dead() || self.contains(entity->position))
+			continue;
+
+		//Outside of every zone, or the zone it walked into can't be reached, keep simulating it ourselves.
+		const ZoneDefinition* zone = m_layout.find_zone(entity->position);
+
+		if (zone == nullptr || get_link(zone->zoneId) == nullptr)
+			continue;
+
+		if (auto player = std::dynamic_pointer_cast<Player>(entity); player != nullptr)
+		{
+			if (auto optHandle = eHandler->transpose_player_to_client_handle(player->uuid); optHandle.has_value())
+			{
+				hand_off_player(player, static_cast<enet_uint32>(optHandle.value()), *zone);
+			}
+		}
+		else
+		{
+			hand_off_npc(entity, *zone);
+		}
+	}
+}
+
+void Server::ZoneLink::hand_off_player(const std::shared_ptr<Player>& _player, const enet_uint32 _clienthandle, const ZoneDefinition& _zone)
+{
+	RefClientInfo client = g_globals.connectionHandler->get_client_info(_clienthandle);
+
+	if (client == nullptr)
+		return;
+
+	Packets::s_ZoneHandoff handoff;
+	handoff.type   = e_ZonePacket::ZONE_HANDOFF;
+	handoff.entity = capture(_player);
+
+	//0 is what clients connect with when they weren't redirected.
+	do
+	{
+		handoff.token = static_cast<uint32_t>(DM::Utils::UUID::generate());
+	}
+	while (handoff.token == 0);
+
+	//*----------------------------------------------------------------------
+	// The walking & fighting the player queued up carries on within the zone
+	// it joins, everything else it queued gets dropped.
+	//*
+	{
+		EventQuery actions;
+		client->packetquery->move(&actions);
+
+		while (actions.contains_packets())
+		{
+			std::unique_ptr<Packets::s_PacketHeader> packet = actions.retrieve_next();
+
+			switch (packet->interpreter)
+			{
+				case e_PacketInterpreter::PACKET_MOVE_ENTITY:
+				{
+					const auto* movement = static_cast<Packets::s_EntityMovement*>(packet.get());
+
+					handoff.entity.bIsMoving    = true;
+					handoff.entity.destinationX = movement->x;
+					handoff.entity.destinationY = movement->y;
+					handoff.entity.bIsRunning   = movement->isRunning;
+				}
+				break;
+
+				case e_PacketInterpreter::PACKET_ENGAGE_ENTITY:
+				{
+					handoff.entity.combatTarget = static_cast<Packets::s_ActionPacket*>(packet.get())->entityId;
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+	send(get_link(_zone.zoneId), &handoff, ZONE_CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+
+	//*--------------------------------------------------------------
+	// Send the client over, it drops the connection by itself and
+	// hands the token to the zone it reconnects to.
+	//*
+	{
+		Packets::s_ZoneRedirect redirect;
+		redirect.interpreter = e_PacketInterpreter::PACKET_ZONE_REDIRECT;
+		redirect.address     = _zone.address;
+		redirect.port        = _zone.clientPort;
+		redirect.token       = handoff.token;
+
+		g_globals.networkHandler->send_packet<Packets::s_ZoneRedirect>(&redirect, client->peer, _clienthandle, CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+	}
+
+	g_globals.connectionHandler->remove_client(_clienthandle);
+
+	DEVIOUS_EVENT("Handed off player " << _player->uuid << " to zone " << _zone.zoneId << ".");
+}
+
+void Server::ZoneLink::hand_off_npc(const std::shared_ptr<Entity>& _npc, const ZoneDefinition& _zone)
+{
+	Packets::s_ZoneHandoff handoff;
+	handoff.type   = e_ZonePacket::ZONE_HANDOFF;
+	handoff.entity = capture(_npc);
+
+	send(get_link(_zone.zoneId), &handoff, ZONE_CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+
+	g_globals.entityHandler->destroy_entity(_npc->uuid);
+}
+
+void Server::ZoneLink::send_mirrors()
+{
+	const std::vector<std::shared_ptr<Entity>> entities = g_globals.entityHandler->get_all_entities();
+
+	for (const auto& [zoneId, peer] : m_links)
+	{
+		if (peer->state != ENET_PEER_STATE_CONNECTED)
+			continue;
+
+		const ZoneDefinition* zone = m_layout.get_zone(zoneId);
+
+		if (zone == nullptr)
+			continue;
+
+		Packets::s_ZoneMirror mirror;
+		mirror.type = e_ZonePacket::ZONE_MIRROR;
+
+		for (const std::shared_ptr<Entity>& entity : entities)
+		{
+			if (!entity->is_mirror() && zone->is_near(entity->position, MIRROR_MARGIN))
+			{
+				mirror.entities.push_back(capture(entity));
+			}
+		}
+
+		//Unreliable, the next mirror replaces a lost one.
+		send(peer, &mirror, ZONE_CHANNEL_MIRROR, 0);
+	}
+}
+
+void Server::ZoneLink::apply_mirror(const Packets::s_ZoneMirror& _mirror)
+{
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	std::unordered_set<uint64_t> mirrored;
+	mirrored.reserve(_mirror.entities.size());
+
+	for (const Packets::s_ZoneEntity& state : _mirror.entities)
+	{
+		mirrored.insert(state.entityId);
+
+		if (auto optEntity = eHandler->get_entity(state.entityId); optEntity.has_value())
+		{
+			//The entity got handed to us in the meantime, the neighbour just doesn't know yet.
+			if (!optEntity.value()->is_mirror())
+				continue;
+
+			apply_state(*optEntity.value(), state);
+			continue;
+		}
+
+		std::shared_ptr<Entity> entity;
+
+		if (state.bIsPlayer)
+		{
+			auto player = std::make_shared<Player>();
+			player->m_name         = state.name;
+			player->m_playerRights = static_cast<Player::e_PlayerRights>(state.rights);
+
+			entity = player;
+		}
+		else
+		{
+			entity = std::make_shared<NPC>(get_entity_data(state.npcId));
+		}
+
+		entity->uuid = state.entityId;
+		apply_state(*entity, state);
+
+		eHandler->add_mirror(entity);
+	}
+
+	//*--------------------------------------------------------------------
+	// Whatever the neighbour stopped mirroring walked away from the border,
+	// died or got handed to another zone.
+	//*
+	std::unordered_set<uint64_t>& previous = m_mirrors[_mirror.zoneId];
+
+	for (const uint64_t entityId : previous)
+	{
+		if (mirrored.find(entityId) != mirrored.end())
+			continue;
+
+		if (auto optEntity = eHandler->get_entity(entityId); optEntity.has_value() && optEntity.value()->is_mirror())
+		{
+			eHandler->destroy_entity(entityId);
+		}
+	}
+
+	previous.swap(mirrored);
+}
+
+void Server::ZoneLink::receive_handoff(const Packets::s_ZoneHandoff& _handoff)
+{
+	const Packets::s_ZoneEntity& state = _handoff.entity;
+
+	//Players only get created once their client reconnects with the token.
+	if (state.bIsPlayer)
+	{
+		m_pendingHandoffs[_handoff.token] = { state, m_tick + HANDOFF_EXPIRY_TICKS };
+		return;
+	}
+
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	//*-----------------------------------------------------------
+	// The npc most likely got mirrored into this zone already, the
+	// owned npc takes its place under the same uuid.
+	//*
+	if (auto optEntity = eHandler->get_entity(state.entityId); optEntity.has_value())
+	{
+		if (!optEntity.value()->is_mirror())
+		{
+			DEVIOUS_WARN("Zone " << _handoff.zoneId << " handed off npc " << state.entityId << ", which this zone already owns.");
+			return;
+		}
+
+		eHandler->remove_mirror(state.entityId);
+	}
+
+	for (auto& [zoneId, mirrored] : m_mirrors)
+	{
+		mirrored.erase(state.entityId);
+	}
+
+	auto npc = std::make_shared<NPC>(get_entity_data(state.npcId));
+	npc->uuid = state.entityId;
+	apply_state(*npc, state);
+
+	npc->wanderingDistance    = state.wanderingDistance;
+	npc->maxWanderingDistance = state.maxWanderingDistance;
+	npc->attackRange          = state.attackRange;
+	npc->bIsAgressive         = state.bIsAgressive;
+	npc->m_respawnTimer       = state.respawnTimer;
+	npc->m_bIsMoving          = state.bIsMoving;
+	npc->m_targetPos          = Utilities::ivec2(state.destinationX, state.destinationY);
+
+	if (state.combatTarget != 0)
+	{
+		if (auto optTarget = eHandler->get_entity(state.combatTarget); optTarget.has_value())
+		{
+			npc->m_target = optTarget.value();
+		}
+	}
+
+	eHandler->adopt_npc(npc);
+}
+
+void Server::ZoneLink::receive_hit(const Packets::s_ZoneRemoteHit& _hit)
+{
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	auto optTarget   = eHandler->get_entity(_hit.targetId);
+	auto optAttacker = eHandler->get_entity(_hit.attackerId);
+
+	if (!optTarget.has_value() || !optAttacker.has_value())
+		return;
+
+	std::shared_ptr<Entity> target = optTarget.value();
+
+	//The entity left this zone or died before the hit arrived.
+	if (target->is_mirror() || target->is_dead())
+		return;
+
+	target->hit(optAttacker.value(), _hit.damage);
+	target->set_target(optAttacker.value(), true);
+}
+
+void Server::ZoneLink::forward_hit(const uint64_t _attackerId, const uint64_t _targetId, const int32_t _damage)
+{
+	for (const auto& [zoneId, mirrored] : m_mirrors)
+	{
+		if (mirrored.find(_targetId) == mirrored.end())
+			continue;
+
+		if (ENetPeer* peer = get_link(zoneId); peer != nullptr)
+		{
+			Packets::s_ZoneRemoteHit packet;
+			packet.type       = e_ZonePacket::ZONE_REMOTE_HIT;
+			packet.attackerId = _attackerId;
+			packet.targetId   = _targetId;
+			packet.damage     = _damage;
+
+			send(peer, &packet, ZONE_CHANNEL_RELIABLE, ENET_PACKET_FLAG_RELIABLE);
+		}
+
+		return;
+	}
+}
+
+void Server::ZoneLink::drop_mirrors(const uint32_t _zoneId)
+{
+	auto it = m_mirrors.find(_zoneId);
+
+	if (it == m_mirrors.end())
+		return;
+
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	for (const uint64_t entityId : it->second)
+	{
+		if (auto optEntity = eHandler->get_entity(entityId); optEntity.has_value() && optEntity.value()->is_mirror())
+		{
+			eHandler->destroy_entity(entityId);
+		}
+	}
+
+	m_mirrors.erase(it);
+	m_receivedMirrors.erase(_zoneId);
+}
+
+std::optional<Packets::s_ZoneEntity> Server::ZoneLink::claim_handoff(const enet_uint32 _token)
+{
+	auto it = m_pendingHandoffs.find(_token);
+
+	if (it == m_pendingHandoffs.end())
+	{
+		DEVIOUS_WARN("A client connected with the unknown handoff token " << _token << ", it joins as a new player.");
+		return std::nullopt;
+	}
+
+	Packets::s_ZoneEntity state = std::move(it->second.entity);
+	m_pendingHandoffs.erase(it);
+
+	//The player takes the place of its mirror.
+	std::shared_ptr<EntityHandler> eHandler = g_globals.entityHandler;
+
+	if (auto optEntity = eHandler->get_entity(state.entityId); optEntity.has_value() && optEntity.value()->is_mirror())
+	{
+		eHandler->remove_mirror(state.entityId);
+	}
+
+	for (auto& [zoneId, mirrored] : m_mirrors)
+	{
+		mirrored.erase(state.entityId);
+	}
+
+	return state;
+}
+
+void Server::ZoneLink::restore_player(ClientInfo& _client, std::shared_ptr<Player> _player, const Packets::s_ZoneEntity& _state)
+{
+	apply_state(*_player, _state);
+
+	_player->m_playerRights = static_cast<Player::e_PlayerRights>(_state.rights);
+
+	if (!_player->set_name(_state.name))
+	{
+		DEVIOUS_WARN("Couldn't restore the name " << _state.name << " of the handed off player " << _player->uuid << ".");
+	}
+
+	//*-----------------------------------------------------------------
+	// Requeue what the player was doing, the event handler picks it up
+	// as if the client sent it to this zone in the first place.
+	//*
+	if (_state.bIsMoving)
+	{
+		Packets::s_EntityMovement movement;
+		movement.interpreter = e_PacketInterpreter::PACKET_MOVE_ENTITY;
+		movement.action      = e_Action::SOFT_ACTION;
+		movement.entityId    = _player->uuid;
+		movement.x           = _state.destinationX;
+		movement.y           = _state.destinationY;
+		movement.isRunning   = _state.bIsRunning;
+
+		_client.packetquery->queue_packet(std::make_unique<Packets::s_EntityMovement>(movement));
+	}
+
+	if (_state.combatTarget != 0)
+	{
+		Packets::s_ActionPacket engage;
+		engage.interpreter = e_PacketInterpreter::PACKET_ENGAGE_ENTITY;
+		engage.action      = e_Action::SOFT_ACTION;
+		engage.entityId    = _state.combatTarget;
+
+		_client.combatTarget = _state.combatTarget;
+		_client.packetquery->queue_packet(std::make_unique<Packets::s_ActionPacket>(engage));
+	}
+
+	DEVIOUS_EVENT("Restored the handed off player " << _player->uuid << " at: " << _state.posX << ", " << _state.posY << ".");
+}
+
+Packets::s_ZoneEntity Server::ZoneLink::capture(const std::shared_ptr<Entity>& _entity)
+{
+	Packets::s_ZoneEntity state;
+	state.entityId  = _entity->uuid;
+	state.posX      = _entity->position.x;
+	state.posY      = _entity->position.y;
+	state.respawnX  = _entity->respawnLocation.x;
+	state.respawnY  = _entity->respawnLocation.y;
+	state.bIsDead   = _entity->m_bIsDead;
+	state.bIsHidden = _entity->m_bHideEntity;
+
+	state.skills.reserve(DM::SKILLS::SKILL_COUNT);
+
+	for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+	{
+		const DM::SKILLS::Skill& skill = _entity->skills[static_cast<DM::SKILLS::e_skills>(i)];
+		state.skills.push_back({ skill.level, skill.levelboosted, skill.experience });
+	}
+
+	if (auto player = std::dynamic_pointer_cast<Player>(_entity); player != nullptr)
+	{
+		state.bIsPlayer = true;
+		state.name      = player->m_name;
+		state.rights    = static_cast<uint8_t>(player->m_playerRights);
+	}
+	else if (auto npc = std::dynamic_pointer_cast<NPC>(_entity); npc != nullptr)
+	{
+		state.npcId                = npc->npcId;
+		state.bIsMoving            = npc->m_bIsMoving;
+		state.destinationX         = npc->m_targetPos.x;
+		state.destinationY         = npc->m_targetPos.y;
+		state.wanderingDistance    = npc->wanderingDistance;
+		state.maxWanderingDistance = npc->maxWanderingDistance;
+		state.attackRange          = npc->attackRange;
+		state.bIsAgressive         = npc->bIsAgressive;
+		state.respawnTimer         = npc->m_respawnTimer;
+
+		if (std::shared_ptr<Entity> target = npc->get_target(); target != nullptr)
+		{
+			state.combatTarget = target->uuid;
+		}
+	}
+
+	return state;
+}
+
+void Server::ZoneLink::apply_state(Entity& _entity, const Packets::s_ZoneEntity& _state)
+{
+	_entity.position        = Utilities::ivec2(_state.posX, _state.posY);
+	_entity.respawnLocation = Utilities::ivec2(_state.respawnX, _state.respawnY);
+	_entity.m_bIsDead       = _state.bIsDead;
+	_entity.m_bHideEntity   = _state.bIsHidden;
+
+	const size_t skillCount = std::min<size_t>(_state.skills.size(), DM::SKILLS::SKILL_COUNT);
+
+	for (size_t i = 0; i < skillCount; i++)
+	{
+		DM::SKILLS::Skill& skill = _entity.skills[static_cast<DM::SKILLS::e_skills>(i)];
+		skill.level        = _state.skills[i].level;
+		skill.levelboosted = _state.skills[i].levelBoosted;
+		skill.experience   = _state.skills[i].experience;
+	}
+}
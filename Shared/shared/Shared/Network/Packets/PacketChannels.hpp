@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// The ENet channels packets get sent over, every channel gets sequenced on its own.
+/// A packet that got lost only stalls the channel it was sent on, so traffic that can't wait shouldn't share a channel with traffic that can.
+/// </summary>
+enum e_PacketChannel : uint8_t
+{
+	/// <summary>
+	/// Reliable lifecycle & combat events, (creation, removal, hits, deaths, skills, pings...).
+	/// </summary>
+	CHANNEL_RELIABLE = 0x00,
+
+	/// <summary>
+	/// Positions get sent unreliable-sequenced, older positions are worthless once a newer one arrives.
+	/// The periodic keyframes are unreliable as well, only the rare teleports are reliable so they stay ordered with the positions.
+	/// </summary>
+	CHANNEL_MOVEMENT = 0x01,
+
+	/// <summary>
+	/// Reliable chat messages, a slow chat message shouldn't hold up the game.
+	/// </summary>
+	CHANNEL_CHAT     = 0x02,
+
+	/// <summary>
+	/// Delta compressed entity state, unreliable-sequenced since every snapshot supersedes the previous one.
+	/// </summary>
+	CHANNEL_SNAPSHOT = 0x03,
+
+	CHANNEL_COUNT
+};
@@ -23,6 +23,19 @@ public:
 
 	template<class T>
 	constexpr static void retrieve_packet_data(T& _packet, ENetEvent* _e);
+
+	/// <summary>
+	/// Reads the packet like retrieve_packet_data, but returns whether it could get read instead of logging the error.
+	/// Meant for data that can't be trusted, e.g packets straight from clients.
+	/// </summary>
+	template<class T>
+	static bool try_retrieve_packet_data(T& _packet, const ENetEvent* _e);
+
+	/// <summary>
+	/// Serializes the packet into the bytes that get sent over the wire.
+	/// </summary>
+	template<class T>
+	static std::string serialize(const T* _data);
 };
 
 /// <summary>
@@ -40,15 +53,7 @@ constexpr inline int PacketHandler::send_packet(T* _data, ENetPeer* _peer, ENetH
 	//Check if the peer id is registered.
 	if (_peer->connectID > 0)
 	{
-		static_assert(std::is_base_of<Packets::s_PacketHeader, T>::value || std::is_same<Packets::s_PacketHeader, T>::value, "T must inherit from the packetheader.");
-
-		std::ostringstream os;
-		{
-			cereal::PortableBinaryOutputArchive ar(os);
-			ar(*_data);
-		}
-
-		std::string stringdata = os.str();
+		const std::string stringdata = serialize<T>(_data);
 		ENetPacket* packet = enet_packet_create(stringdata.data(), stringdata.size(), _flags);
 
 		if (enet_peer_send(_peer, _channel, packet) == 0)
@@ -98,3 +103,40 @@ constexpr inline void PacketHandler::retrieve_packet_data(T& _packet, ENetEvent*
 		DEVIOUS_ERR("Serialization error: " << e.what() << std::endl);
 	}
 }
+
+template<class T>
+inline bool PacketHandler::try_retrieve_packet_data(T& _packet, const ENetEvent* _e)
+{
+	static_assert(std::is_base_of<Packets::s_PacketHeader, T>::value || std::is_same<Packets::s_PacketHeader, T>::value, "T must inherit from the packetheader.");
+
+	try
+	{
+		std::string st((const char*)_e->packet->data, _e->packet->dataLength);
+
+		std::istringstream is(st);
+		{
+			cereal::PortableBinaryInputArchive ar(is);
+			ar(_packet);
+		}
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+template<class T>
+inline std::string PacketHandler::serialize(const T* _data)
+{
+	static_assert(std::is_base_of<Packets::s_PacketHeader, T>::value || std::is_same<Packets::s_PacketHeader, T>::value, "T must inherit from the packetheader.");
+
+	std::ostringstream os;
+	{
+		cereal::PortableBinaryOutputArchive ar(os);
+		ar(*_data);
+	}
+
+	return os.str();
+}
@@ -3,8 +3,12 @@
 #include <vector>
 #include <utility>
 #include "cereal/types/memory.hpp"
+#include "cereal/types/string.hpp"
+#include "cereal/types/vector.hpp"
 #include "cereal/archives/binary.hpp"
 
+#include "PacketChannels.hpp"
+
 enum class e_Action : uint8_t
 {
 	SOFT_ACTION   = 0x00,
@@ -18,8 +22,6 @@ enum class e_PacketInterpreter : uint8_t
 {
 	PACKET_NONE = 0x00,
 
-	PACKET_PING = 0x01,
-
 	PACKET_CREATE_ENTITY = 0x02,
 
 	PACKET_ASSIGN_LOCAL_PLAYER_ENTITY = 0x03,
@@ -50,7 +52,19 @@ enum class e_PacketInterpreter : uint8_t
 
 	PACKET_ENTITY_MESSAGE_WORLD = 0x10,
 
-	PACKET_CHANGE_NAME          = 0x11
+	PACKET_CHANGE_NAME          = 0x11,
+
+	PACKET_WORLD_SNAPSHOT       = 0x12,
+
+	PACKET_STATE_SNAPSHOT       = 0x13,
+
+	PACKET_SNAPSHOT_ACK         = 0x14,
+
+	PACKET_CHANGE_INSTANCE      = 0x15,
+
+	PACKET_ZONE_REDIRECT        = 0x16,
+
+	PACKET_TICK_PERIOD          = 0x17
 };
 
 namespace Packets
@@ -246,12 +260,24 @@ namespace Packets
 		int  x = 0, y = 0;
 		bool isRunning = false;
 
+		/// <summary>
+		/// From Client->Server it numbers the walk inputs of the client, From Server->Client it's the latest input the server
+		/// processed for the player so the client can reconcile its prediction. Always 0 for NPCs.
+		/// </summary>
+		uint32_t sequence = 0;
+
+		/// <summary>
+		/// From Server->Client the tick the entity moved on, the client interpolates between the positions of consecutive ticks.
+		/// </summary>
+		uint32_t tick = 0;
+
 		template <class Archive>
 		void serialize(Archive& ar)
 		{
 			ar(cereal::base_class<s_PacketHeader>(this));
 			ar(entityId);
 			ar(x, y, isRunning);
+			ar(sequence, tick);
 		}
 	};
 
@@ -273,5 +299,137 @@ namespace Packets
 			ar(x, y);
 		}
 	};
-}
 
+	struct s_SnapshotSkill
+	{
+		uint8_t skillType    = 0;
+		int32_t level        = 0;
+		int32_t levelBoosted = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(skillType, level, levelBoosted);
+		}
+	};
+
+	/// <summary>
+	/// Everything a client needs to know about an entity when joining the world.
+	/// </summary>
+	struct s_SnapshotEntity
+	{
+		uint64_t entityId  = 0;
+		uint8_t  npcId     = 0;
+		bool     bIsHidden = false;
+		int32_t  posX = 0, posY = 0;
+
+		/// <summary>
+		/// Empty for npc's, they use the name of their definition.
+		/// </summary>
+		std::string name = "";
+
+		/// <summary>
+		/// Only skills that differ from the default skill values.
+		/// </summary>
+		std::vector<s_SnapshotSkill> skills;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(entityId, npcId, bIsHidden, posX, posY);
+			ar(name);
+			ar(skills);
+		}
+	};
+
+	/// <summary>
+	/// Part of the world state that gets sent to a client when it joins, replaces sending a packet per entity.
+	/// </summary>
+	struct s_WorldSnapshot : public s_PacketHeader
+	{
+		uint32_t chunkIndex = 0;
+		uint32_t chunkCount = 0;
+
+		std::vector<s_SnapshotEntity> entities;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(chunkIndex, chunkCount);
+			ar(entities);
+		}
+	};
+
+	/// <summary>
+	/// Bit-packed delta of the replicated entity state against the snapshot the client acknowledged last.
+	/// </summary>
+	struct s_StateSnapshot : public s_PacketHeader
+	{
+		uint32_t sequence = 0;
+
+		/// <summary>
+		/// The sequence the delta was written against, 0 when it contains the full state.
+		/// </summary>
+		uint32_t baseline = 0;
+
+		/// <summary>
+		/// The tick the state got captured on.
+		/// </summary>
+		uint32_t tick = 0;
+
+		std::vector<uint8_t> data;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(sequence, baseline, tick);
+			ar(data);
+		}
+	};
+
+	struct s_SnapshotAck : public s_PacketHeader
+	{
+		uint32_t sequence = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(sequence);
+		}
+	};
+
+	/// <summary>
+	/// The duration of a tick in milliseconds, sent when a client joins and whenever the instance it's on changes its tick rate.
+	/// </summary>
+	struct s_TickPeriod : public s_PacketHeader
+	{
+		uint32_t period = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(period);
+		}
+	};
+
+	/// <summary>
+	/// Sends the client to the server of the zone its player walked into, the token lets that zone pick up the player where it left off.
+	/// </summary>
+	struct s_ZoneRedirect : public s_PacketHeader
+	{
+		std::string address;
+		uint16_t    port  = 0;
+		uint32_t    token = 0;
+
+		template<class Archive>
+		void serialize(Archive& ar)
+		{
+			ar(cereal::base_class<s_PacketHeader>(this));
+			ar(address, port, token);
+		}
+	};
+}
\ No newline at end of file
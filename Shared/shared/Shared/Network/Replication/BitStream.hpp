@@ -0,0 +1,266 @@
+#pragma once
+#include <cstdint>
+
+#include <vector>
+
+#include <string>
+
+#include <algorithm>
+
+namespace DM
+{
+	namespace Replication
+	{
+		/// <summary>
+		/// Packs values using only the amount of bits they need, least significant bit first.
+		/// </summary>
+		class BitWriter
+		{
+		public:
+			/// <summary>
+			/// Writes the lowest bits of the value, a bitcount of up to 64 is supported.
+			/// </summary>
+			/// <param name="_value"></param>
+			/// <param name="_bitCount"></param>
+			void write(uint64_t _value, uint32_t _bitCount);
+
+			void write_bool(const bool _value);
+
+			/// <summary>
+			/// Writes the value in groups of 7 bits, small values take up less space.
+			/// </summary>
+			/// <param name="_value"></param>
+			void write_varuint(uint64_t _value);
+
+			/// <summary>
+			/// Zigzag encodes the value first so small negative values stay small as well.
+			/// </summary>
+			/// <param name="_value"></param>
+			void write_varint(const int64_t _value);
+
+			void write_string(const std::string& _value);
+
+			/// <summary>
+			/// Returns the written bytes, the last byte is padded with zeroes.
+			/// </summary>
+			/// <returns></returns>
+			const std::vector<uint8_t>& get_data() const;
+
+			/// <summary>
+			/// Returns the amount of bits that have been written.
+			/// </summary>
+			/// <returns></returns>
+			const size_t get_bit_count() const;
+
+			/// <summary>
+			/// Clears the written data while keeping the allocated memory.
+			/// </summary>
+			void reset();
+
+		private:
+			std::vector<uint8_t> m_data;
+			size_t               m_bitCount = 0;
+		};
+
+		/// <summary>
+		/// Reads values written by the BitWriter.
+		/// Reading past the end returns zeroes and flags the reader as overflowed instead of throwing.
+		/// </summary>
+		class BitReader
+		{
+		public:
+			uint64_t read(uint32_t _bitCount);
+
+			const bool read_bool();
+
+			uint64_t read_varuint();
+
+			int64_t read_varint();
+
+			std::string read_string();
+
+			/// <summary>
+			/// Whether something tried to read beyond the end of the data, the read values can't be trusted once this happens.
+			/// </summary>
+			/// <returns></returns>
+			const bool has_overflowed() const;
+
+		public:
+			BitReader(const std::vector<uint8_t>& _data);
+
+		private:
+			const std::vector<uint8_t>& m_data;
+			size_t                      m_bitIndex    = 0;
+			bool                        m_bOverflowed = false;
+		};
+	}
+}
+
+#pragma region IMPLEMENTATION_DETAILS
+
+inline void DM::Replication::BitWriter::write(uint64_t _value, uint32_t _bitCount)
+{
+	//*-------------------------------------------------------------------
+	// Fill up the remaining bits of the current byte, a byte at a time.
+	//*
+	while (_bitCount > 0)
+	{
+		const size_t   byteIndex = m_bitCount >> 3;
+		const uint32_t bitOffset = static_cast<uint32_t>(m_bitCount & 7);
+
+		if (byteIndex == m_data.size())
+		{
+			m_data.push_back(0);
+		}
+
+		const uint32_t bits = std::min<uint32_t>(8 - bitOffset, _bitCount);
+		const uint64_t mask = (static_cast<uint64_t>(1) << bits) - 1;
+
+		m_data[byteIndex] |= static_cast<uint8_t>((_value & mask) << bitOffset);
+
+		_value     >>= bits;
+		_bitCount   -= bits;
+		m_bitCount  += bits;
+	}
+}
+
+inline void DM::Replication::BitWriter::write_bool(const bool _value)
+{
+	write(_value ? 1 : 0, 1);
+}
+
+inline void DM::Replication::BitWriter::write_varuint(uint64_t _value)
+{
+	do
+	{
+		const uint64_t group = _value & 0x7F;
+		_value >>= 7;
+
+		write(group, 7);
+		write_bool(_value != 0);
+	}
+	while (_value != 0);
+}
+
+inline void DM::Replication::BitWriter::write_varint(const int64_t _value)
+{
+	write_varuint((static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63));
+}
+
+inline void DM::Replication::BitWriter::write_string(const std::string& _value)
+{
+	write_varuint(_value.size());
+
+	for (const char character : _value)
+	{
+		write(static_cast<uint8_t>(character), 8);
+	}
+}
+
+inline const std::vector<uint8_t>& DM::Replication::BitWriter::get_data() const
+{
+	return m_data;
+}
+
+inline const size_t DM::Replication::BitWriter::get_bit_count() const
+{
+	return m_bitCount;
+}
+
+inline void DM::Replication::BitWriter::reset()
+{
+	m_data.clear();
+	m_bitCount = 0;
+}
+
+inline DM::Replication::BitReader::BitReader(const std::vector<uint8_t>& _data) :
+	m_data(_data)
+{
+}
+
+inline uint64_t DM::Replication::BitReader::read(uint32_t _bitCount)
+{
+	if (m_bitIndex + _bitCount > m_data.size() * 8)
+	{
+		m_bOverflowed = true;
+		m_bitIndex    = m_data.size() * 8;
+		return 0;
+	}
+
+	uint64_t value = 0;
+	uint32_t shift = 0;
+
+	while (_bitCount > 0)
+	{
+		const size_t   byteIndex = m_bitIndex >> 3;
+		const uint32_t bitOffset = static_cast<uint32_t>(m_bitIndex & 7);
+
+		const uint32_t bits = std::min<uint32_t>(8 - bitOffset, _bitCount);
+		const uint64_t mask = (static_cast<uint64_t>(1) << bits) - 1;
+
+		value |= ((static_cast<uint64_t>(m_data[byteIndex]) >> bitOffset) & mask) << shift;
+
+		shift      += bits;
+		_bitCount  -= bits;
+		m_bitIndex += bits;
+	}
+
+	return value;
+}
+
+inline const bool DM::Replication::BitReader::read_bool()
+{
+	return read(1) != 0;
+}
+
+inline uint64_t DM::Replication::BitReader::read_varuint()
+{
+	uint64_t value = 0;
+	uint32_t shift = 0;
+
+	bool bHasMore = true;
+
+	while (bHasMore && !m_bOverflowed && shift < 64)
+	{
+		value   |= read(7) << shift;
+		shift   += 7;
+		bHasMore = read_bool();
+	}
+
+	return value;
+}
+
+inline int64_t DM::Replication::BitReader::read_varint()
+{
+	const uint64_t value = read_varuint();
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline std::string DM::Replication::BitReader::read_string()
+{
+	const uint64_t length = read_varuint();
+
+	//A length that can't possibly fit within the remaining data means the data is corrupt.
+	if (length > (m_data.size() * 8 - m_bitIndex) / 8)
+	{
+		m_bOverflowed = true;
+		return "";
+	}
+
+	std::string value;
+	value.reserve(static_cast<size_t>(length));
+
+	for (uint64_t i = 0; i < length; i++)
+	{
+		value.push_back(static_cast<char>(read(8)));
+	}
+
+	return value;
+}
+
+inline const bool DM::Replication::BitReader::has_overflowed() const
+{
+	return m_bOverflowed;
+}
+
+#pragma endregion
@@ -0,0 +1,527 @@
+#pragma once
+#include <memory>
+
+#include <array>
+
+#include "Shared/Game/Skill.hpp"
+
+#include "Shared/Network/Replication/BitStream.hpp"
+
+namespace DM
+{
+	namespace Replication
+	{
+		/// <summary>
+		/// Every part of an entity that gets replicated through snapshots.
+		/// </summary>
+		struct s_ReplicatedState
+		{
+			uint8_t npcId     = 0;
+			int32_t posX      = 0;
+			int32_t posY      = 0;
+			bool    bIsHidden = false;
+			bool    bIsDead   = false;
+
+			/// <summary>
+			/// Empty for npc's, they use the name of their definition.
+			/// </summary>
+			std::string name = "";
+
+			std::array<int32_t, DM::SKILLS::SKILL_COUNT> levels        = {};
+			std::array<int32_t, DM::SKILLS::SKILL_COUNT> boostedLevels = {};
+
+			/// <summary>
+			/// Returns the state a client assumes an entity has before it received anything, creations get sent as a delta against this.
+			/// </summary>
+			/// <returns></returns>
+			static const s_ReplicatedState& get_default();
+		};
+
+		/// <summary>
+		/// Dirty bits of the fields of a replicated state, only the fields that have their bit set get written.
+		/// </summary>
+		enum e_ReplicatedField : uint8_t
+		{
+			FIELD_POSITION = 1 << 0,
+			FIELD_FLAGS    = 1 << 1,
+			FIELD_NAME     = 1 << 2,
+			FIELD_SKILLS   = 1 << 3,
+
+			FIELD_BIT_COUNT = 4
+		};
+
+		/// <summary>
+		/// What happened to an entity between the baseline and the current snapshot.
+		/// </summary>
+		enum class e_ReplicatedOp : uint8_t
+		{
+			UPDATE = 0x00,
+			CREATE = 0x01,
+			REMOVE = 0x02
+		};
+
+		/// <summary>
+		/// States are immutable once they're part of a snapshot, entities that didn't change share their state with the previous snapshot.
+		/// </summary>
+		using RefReplicatedState = std::shared_ptr<const s_ReplicatedState>;
+
+		struct s_ReplicatedEntity
+		{
+			uint64_t           entityId = 0;
+			RefReplicatedState state;
+		};
+
+		/// <summary>
+		/// The state of every replicated entity at a specific tick, sorted by entity id.
+		/// </summary>
+		using ReplicatedSnapshot = std::vector<s_ReplicatedEntity>;
+
+		/// <summary>
+		/// A single entity that differs between a baseline & the current snapshot.
+		/// </summary>
+		struct s_ReplicatedDiff
+		{
+			uint64_t           entityId = 0;
+			e_ReplicatedOp     op       = e_ReplicatedOp::UPDATE;
+			uint8_t            fields   = 0;
+			RefReplicatedState baseline;
+			RefReplicatedState state;
+		};
+
+		/// <summary>
+		/// A single entity that changed while reading a delta.
+		/// </summary>
+		struct s_ReplicatedChange
+		{
+			uint64_t       entityId = 0;
+			e_ReplicatedOp op       = e_ReplicatedOp::UPDATE;
+			uint8_t        fields   = 0;
+		};
+
+		/// <summary>
+		/// Returns the dirty bits of every field that differs between both states.
+		/// </summary>
+		/// <param name="_from"></param>
+		/// <param name="_to"></param>
+		/// <returns></returns>
+		uint8_t get_dirty_fields(const s_ReplicatedState& _from, const s_ReplicatedState& _to);
+
+		/// <summary>
+		/// Collects every entity that differs between the baseline & the current snapshot, sorted by entity id.
+		/// </summary>
+		/// <param name="_baseline"></param>
+		/// <param name="_current"></param>
+		/// <param name="_diffs"></param>
+		void collect_delta(const ReplicatedSnapshot& _baseline, const ReplicatedSnapshot& _current, std::vector<s_ReplicatedDiff>& _diffs);
+
+		/// <summary>
+		/// Writes a single entity of a delta, entities have to get written in ascending order of their id.
+		/// </summary>
+		/// <param name="_diff"></param>
+		/// <param name="_writer"></param>
+		void write_diff(const s_ReplicatedDiff& _diff, BitWriter& _writer);
+
+		/// <summary>
+		/// Marks the end of a delta.
+		/// </summary>
+		/// <param name="_writer"></param>
+		void write_end(BitWriter& _writer);
+
+		/// <summary>
+		/// Applies the diffs on top of the baseline, the same way a reader of those diffs rebuilds its snapshot.
+		/// </summary>
+		/// <param name="_baseline"></param>
+		/// <param name="_diffs"></param>
+		/// <param name="_result"></param>
+		void apply_diffs(const ReplicatedSnapshot& _baseline, const std::vector<s_ReplicatedDiff>& _diffs, ReplicatedSnapshot& _result);
+
+		/// <summary>
+		/// Writes everything that changed between the baseline & the current snapshot, both snapshots have to be sorted.
+		/// Returns the amount of entities that got written.
+		/// </summary>
+		/// <param name="_baseline"></param>
+		/// <param name="_current"></param>
+		/// <param name="_writer"></param>
+		/// <returns></returns>
+		size_t write_delta(const ReplicatedSnapshot& _baseline, const ReplicatedSnapshot& _current, BitWriter& _writer);
+
+		/// <summary>
+		/// Rebuilds the current snapshot from the baseline and a delta written by write_delta.
+		/// Returns false when the delta is corrupt or doesn't belong to the baseline.
+		/// </summary>
+		/// <param name="_baseline"></param>
+		/// <param name="_reader"></param>
+		/// <param name="_current"></param>
+		/// <param name="_changes"></param>
+		/// <returns></returns>
+		bool read_delta(const ReplicatedSnapshot& _baseline, BitReader& _reader, ReplicatedSnapshot& _current, std::vector<s_ReplicatedChange>& _changes);
+
+		/// <summary>
+		/// Writes the fields flagged within the mask, as a delta against the baseline state.
+		/// </summary>
+		void write_fields(const s_ReplicatedState& _baseline, const s_ReplicatedState& _state, const uint8_t _fields, BitWriter& _writer);
+
+		/// <summary>
+		/// Reads the fields flagged within the mask on top of the state.
+		/// </summary>
+		void read_fields(s_ReplicatedState& _state, const uint8_t _fields, BitReader& _reader);
+
+		/// <summary>
+		/// Positions mostly move a tile or 2 per tick, those fit within a few bits.
+		/// </summary>
+		void write_coordinate(const int32_t _from, const int32_t _to, BitWriter& _writer);
+		int32_t read_coordinate(const int32_t _from, BitReader& _reader);
+	}
+}
+
+#pragma region IMPLEMENTATION_DETAILS
+
+inline const DM::Replication::s_ReplicatedState& DM::Replication::s_ReplicatedState::get_default()
+{
+	static const s_ReplicatedState defaultState = []()
+	{
+		s_ReplicatedState state;
+		DM::SKILLS::SkillMap skills;
+
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			const DM::SKILLS::e_skills skillType = static_cast<DM::SKILLS::e_skills>(i);
+
+			state.levels[i]        = skills[skillType].level;
+			state.boostedLevels[i] = skills[skillType].levelboosted;
+		}
+
+		return state;
+	}();
+
+	return defaultState;
+}
+
+inline uint8_t DM::Replication::get_dirty_fields(const s_ReplicatedState& _from, const s_ReplicatedState& _to)
+{
+	uint8_t fields = 0;
+
+	if (_from.posX != _to.posX || _from.posY != _to.posY)
+		fields |= FIELD_POSITION;
+
+	if (_from.bIsHidden != _to.bIsHidden || _from.bIsDead != _to.bIsDead)
+		fields |= FIELD_FLAGS;
+
+	if (_from.name != _to.name)
+		fields |= FIELD_NAME;
+
+	if (_from.levels != _to.levels || _from.boostedLevels != _to.boostedLevels)
+		fields |= FIELD_SKILLS;
+
+	return fields;
+}
+
+inline void DM::Replication::collect_delta(const ReplicatedSnapshot& _baseline, const ReplicatedSnapshot& _current, std::vector<s_ReplicatedDiff>& _diffs)
+{
+	_diffs.clear();
+
+	//*-----------------------------------------------------------------------------
+	// Walk both sorted snapshots at once, entities that only exist in the baseline
+	// got removed and entities that only exist in the current snapshot got created.
+	//*
+	size_t b = 0, c = 0;
+
+	while (b < _baseline.size() || c < _current.size())
+	{
+		const bool bInBaseline = b < _baseline.size();
+		const bool bInCurrent  = c < _current.size();
+
+		if (bInBaseline && (!bInCurrent || _baseline[b].entityId < _current[c].entityId))
+		{
+			_diffs.push_back({ _baseline[b].entityId, e_ReplicatedOp::REMOVE, 0, _baseline[b].state, nullptr });
+			b++;
+		}
+		else if (bInCurrent && (!bInBaseline || _current[c].entityId < _baseline[b].entityId))
+		{
+			const uint8_t fields = get_dirty_fields(s_ReplicatedState::get_default(), *_current[c].state);
+
+			_diffs.push_back({ _current[c].entityId, e_ReplicatedOp::CREATE, fields, nullptr, _current[c].state });
+			c++;
+		}
+		else
+		{
+			//Unchanged entities share the same state, so most of them get skipped without comparing.
+			if (_baseline[b].state != _current[c].state)
+			{
+				const uint8_t fields = get_dirty_fields(*_baseline[b].state, *_current[c].state);
+
+				if (fields != 0)
+				{
+					_diffs.push_back({ _current[c].entityId, e_ReplicatedOp::UPDATE, fields, _baseline[b].state, _current[c].state });
+				}
+			}
+
+			b++;
+			c++;
+		}
+	}
+}
+
+inline void DM::Replication::write_diff(const s_ReplicatedDiff& _diff, BitWriter& _writer)
+{
+	_writer.write_bool(true);
+	_writer.write(_diff.entityId, 64);
+	_writer.write(static_cast<uint64_t>(_diff.op), 2);
+
+	switch (_diff.op)
+	{
+		case e_ReplicatedOp::CREATE:
+		{
+			_writer.write(_diff.state->npcId, 8);
+			_writer.write(_diff.fields, FIELD_BIT_COUNT);
+			write_fields(s_ReplicatedState::get_default(), *_diff.state, _diff.fields, _writer);
+		}
+		break;
+
+		case e_ReplicatedOp::UPDATE:
+		{
+			_writer.write(_diff.fields, FIELD_BIT_COUNT);
+			write_fields(*_diff.baseline, *_diff.state, _diff.fields, _writer);
+		}
+		break;
+
+		default:
+			break;
+	}
+}
+
+inline void DM::Replication::write_end(BitWriter& _writer)
+{
+	_writer.write_bool(false);
+}
+
+inline void DM::Replication::apply_diffs(const ReplicatedSnapshot& _baseline, const std::vector<s_ReplicatedDiff>& _diffs, ReplicatedSnapshot& _result)
+{
+	_result.clear();
+
+	size_t b = 0;
+
+	for (const s_ReplicatedDiff& diff : _diffs)
+	{
+		while (b < _baseline.size() && _baseline[b].entityId < diff.entityId)
+		{
+			_result.push_back(_baseline[b++]);
+		}
+
+		if (b < _baseline.size() && _baseline[b].entityId == diff.entityId)
+		{
+			b++;
+		}
+
+		if (diff.op != e_ReplicatedOp::REMOVE)
+		{
+			_result.push_back({ diff.entityId, diff.state });
+		}
+	}
+
+	while (b < _baseline.size())
+	{
+		_result.push_back(_baseline[b++]);
+	}
+}
+
+inline size_t DM::Replication::write_delta(const ReplicatedSnapshot& _baseline, const ReplicatedSnapshot& _current, BitWriter& _writer)
+{
+	std::vector<s_ReplicatedDiff> diffs;
+	collect_delta(_baseline, _current, diffs);
+
+	for (const s_ReplicatedDiff& diff : diffs)
+	{
+		write_diff(diff, _writer);
+	}
+
+	write_end(_writer);
+	return diffs.size();
+}
+
+inline bool DM::Replication::read_delta(const ReplicatedSnapshot& _baseline, BitReader& _reader, ReplicatedSnapshot& _current, std::vector<s_ReplicatedChange>& _changes)
+{
+	_current.clear();
+	_changes.clear();
+
+	size_t b = 0;
+
+	while (_reader.read_bool() && !_reader.has_overflowed())
+	{
+		s_ReplicatedChange change;
+		change.entityId = _reader.read(64);
+		change.op       = static_cast<e_ReplicatedOp>(_reader.read(2));
+
+		//Every entity in between didn't change.
+		while (b < _baseline.size() && _baseline[b].entityId < change.entityId)
+		{
+			_current.push_back(_baseline[b++]);
+		}
+
+		const bool bInBaseline = b < _baseline.size() && _baseline[b].entityId == change.entityId;
+
+		switch (change.op)
+		{
+			case e_ReplicatedOp::REMOVE:
+			{
+				if (!bInBaseline)
+					return false;
+
+				b++;
+			}
+			break;
+
+			case e_ReplicatedOp::CREATE:
+			{
+				auto state = std::make_shared<s_ReplicatedState>(s_ReplicatedState::get_default());
+				state->npcId  = static_cast<uint8_t>(_reader.read(8));
+				change.fields = static_cast<uint8_t>(_reader.read(FIELD_BIT_COUNT));
+				read_fields(*state, change.fields, _reader);
+
+				//Only happens when the entity got recreated under the same id.
+				if (bInBaseline)
+				{
+					b++;
+				}
+
+				_current.push_back({ change.entityId, state });
+			}
+			break;
+
+			case e_ReplicatedOp::UPDATE:
+			{
+				if (!bInBaseline)
+					return false;
+
+				auto state = std::make_shared<s_ReplicatedState>(*_baseline[b++].state);
+				change.fields = static_cast<uint8_t>(_reader.read(FIELD_BIT_COUNT));
+				read_fields(*state, change.fields, _reader);
+
+				_current.push_back({ change.entityId, state });
+			}
+			break;
+
+			default:
+				return false;
+		}
+
+		_changes.push_back(change);
+	}
+
+	while (b < _baseline.size())
+	{
+		_current.push_back(_baseline[b++]);
+	}
+
+	return !_reader.has_overflowed();
+}
+
+inline void DM::Replication::write_fields(const s_ReplicatedState& _baseline, const s_ReplicatedState& _state, const uint8_t _fields, BitWriter& _writer)
+{
+	if (_fields & FIELD_POSITION)
+	{
+		write_coordinate(_baseline.posX, _state.posX, _writer);
+		write_coordinate(_baseline.posY, _state.posY, _writer);
+	}
+
+	if (_fields & FIELD_FLAGS)
+	{
+		_writer.write_bool(_state.bIsHidden);
+		_writer.write_bool(_state.bIsDead);
+	}
+
+	if (_fields & FIELD_NAME)
+	{
+		_writer.write_string(_state.name);
+	}
+
+	//*--------------------------------------------------------------
+	// Mask of the skills that changed, followed by only those skills.
+	//*
+	if (_fields & FIELD_SKILLS)
+	{
+		uint64_t skillMask = 0;
+
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			if (_baseline.levels[i] != _state.levels[i] || _baseline.boostedLevels[i] != _state.boostedLevels[i])
+			{
+				skillMask |= static_cast<uint64_t>(1) << i;
+			}
+		}
+
+		_writer.write(skillMask, DM::SKILLS::SKILL_COUNT);
+
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			if (skillMask & (static_cast<uint64_t>(1) << i))
+			{
+				_writer.write_varint(_state.levels[i]);
+				_writer.write_varint(_state.boostedLevels[i]);
+			}
+		}
+	}
+}
+
+inline void DM::Replication::read_fields(s_ReplicatedState& _state, const uint8_t _fields, BitReader& _reader)
+{
+	if (_fields & FIELD_POSITION)
+	{
+		_state.posX = read_coordinate(_state.posX, _reader);
+		_state.posY = read_coordinate(_state.posY, _reader);
+	}
+
+	if (_fields & FIELD_FLAGS)
+	{
+		_state.bIsHidden = _reader.read_bool();
+		_state.bIsDead   = _reader.read_bool();
+	}
+
+	if (_fields & FIELD_NAME)
+	{
+		_state.name = _reader.read_string();
+	}
+
+	if (_fields & FIELD_SKILLS)
+	{
+		const uint64_t skillMask = _reader.read(DM::SKILLS::SKILL_COUNT);
+
+		for (uint8_t i = 0; i < DM::SKILLS::SKILL_COUNT; i++)
+		{
+			if (skillMask & (static_cast<uint64_t>(1) << i))
+			{
+				_state.levels[i]        = static_cast<int32_t>(_reader.read_varint());
+				_state.boostedLevels[i] = static_cast<int32_t>(_reader.read_varint());
+			}
+		}
+	}
+}
+
+inline void DM::Replication::write_coordinate(const int32_t _from, const int32_t _to, BitWriter& _writer)
+{
+	const int64_t delta = static_cast<int64_t>(_to) - static_cast<int64_t>(_from);
+
+	//Walking & running fit within 3 bits, anything else (teleports, creations) gets written in full.
+	if (delta >= -4 && delta <= 3)
+	{
+		_writer.write_bool(true);
+		_writer.write(static_cast<uint64_t>(delta + 4), 3);
+	}
+	else
+	{
+		_writer.write_bool(false);
+		_writer.write_varint(delta);
+	}
+}
+
+inline int32_t DM::Replication::read_coordinate(const int32_t _from, BitReader& _reader)
+{
+	if (_reader.read_bool())
+	{
+		return _from + static_cast<int32_t>(_reader.read(3)) - 4;
+	}
+
+	return static_cast<int32_t>(static_cast<int64_t>(_from) + _reader.read_varint());
+}
+
+#pragma endregion